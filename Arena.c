@@ -0,0 +1,128 @@
+#include "Arena.h"
+#include <stdalign.h>
+#include <stddef.h>
+#include <stdlib.h>
+
+#define DEFAULT_BLOCK_SIZE (64 * 1024)
+#define ARENA_ALIGN alignof(max_align_t)
+
+// 大块内存，头部之后紧跟数据区
+typedef struct Block
+{
+    struct Block *next;
+    size_t size; // 数据区大小
+    size_t used;
+    alignas(max_align_t) unsigned char data[];
+} Block;
+
+struct Arena
+{
+    size_t blockSize;
+    Block *head; // 当前正在切分的块，next指向更早的块
+    ArenaStats stats;
+};
+
+static Block *newBlock(Arena *arena, size_t size)
+{
+    Block *block = (Block *)malloc(sizeof(Block) + size);
+    if (!block)
+        return NULL;
+    block->size = size;
+    block->used = 0;
+    arena->stats.mallocs++;
+    arena->stats.bytesReserved += size;
+    return block;
+}
+
+Arena *createArena(size_t blockSize)
+{
+    Arena *arena = (Arena *)calloc(1, sizeof(Arena));
+    if (!arena)
+        return NULL;
+    arena->blockSize = blockSize > 0 ? blockSize : DEFAULT_BLOCK_SIZE;
+    return arena;
+}
+
+void freeArena(Arena *arena)
+{
+    if (arena)
+    {
+        Block *block = arena->head;
+        while (block)
+        {
+            Block *next = block->next;
+            free(block);
+            block = next;
+        }
+        free(arena);
+    }
+}
+
+void *arenaAlloc(Arena *arena, size_t size)
+{
+    size = (size + ARENA_ALIGN - 1) & ~(size_t)(ARENA_ALIGN - 1);
+    Block *block = arena->head;
+
+    if (!block || block->size - block->used < size)
+    {
+        // 超大的分配单独成块并挂在当前块之后，当前块剩余的空间继续使用
+        if (block && size > arena->blockSize)
+        {
+            Block *big = newBlock(arena, size);
+            if (!big)
+                return NULL;
+            big->used = size;
+            big->next = block->next;
+            block->next = big;
+            arena->stats.allocations++;
+            arena->stats.bytesUsed += size;
+            return big->data;
+        }
+
+        block = newBlock(arena, size > arena->blockSize ? size : arena->blockSize);
+        if (!block)
+            return NULL;
+        block->next = arena->head;
+        arena->head = block;
+    }
+
+    void *ptr = block->data + block->used;
+    block->used += size;
+    arena->stats.allocations++;
+    arena->stats.bytesUsed += size;
+    return ptr;
+}
+
+void arenaReset(Arena *arena)
+{
+    // 保留一个普通大小的块，单独成块的超大分配全部归还
+    Block *block = arena->head;
+    Block *keep = NULL;
+    while (block)
+    {
+        Block *next = block->next;
+        if (!keep && block->size == arena->blockSize)
+        {
+            keep = block;
+        }
+        else
+        {
+            arena->stats.bytesReserved -= block->size;
+            free(block);
+        }
+        block = next;
+    }
+
+    if (keep)
+    {
+        keep->used = 0;
+        keep->next = NULL;
+    }
+    arena->head = keep;
+    arena->stats.bytesUsed = 0;
+}
+
+ArenaStats arenaStats(Arena *arena)
+{
+    return arena->stats;
+}
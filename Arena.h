@@ -0,0 +1,37 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stddef.h>
+
+// 区域(arena)分配器
+// 从大块内存中顺序切出空间，分配只是移动指针；不能单独释放某一次分配，
+// 只能用arenaReset或freeArena一次性释放全部。用于生命周期相同的一批对象，
+// 例如一张图的全部数组，或者一次(一批)查询的全部结果。
+typedef struct Arena Arena;
+
+// 累计统计
+typedef struct ArenaStats
+{
+    long long allocations; // arenaAlloc调用次数
+    long long mallocs;     // 向系统申请大块内存的次数
+    size_t bytesUsed;      // 当前已分配出去的字节数(含对齐填充)
+    size_t bytesReserved;  // 当前持有的大块内存的总字节数
+} ArenaStats;
+
+// 创建区域，blockSize为每个大块的大小(0表示默认的64KB)。
+// 如果事先知道总大小，传入总大小即可让全部分配落在同一块内存中。内存不足时返回NULL。
+Arena *createArena(size_t blockSize);
+
+// 释放区域与其中的全部分配(NULL安全)
+void freeArena(Arena *arena);
+
+// 分配size字节，按max_align_t对齐；内存不足时返回NULL。
+// 超过块大小的分配单独占用一块。
+void *arenaAlloc(Arena *arena, size_t size);
+
+// 一次性释放全部分配。保留一个普通大小的块供之后复用，其余的归还给系统。
+void arenaReset(Arena *arena);
+
+ArenaStats arenaStats(Arena *arena);
+
+#endif // ARENA_H
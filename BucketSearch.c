@@ -0,0 +1,168 @@
+#include "BucketSearch.h"
+#include <limits.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+int bucketCount(const Graph *attack)
+{
+    if (attack->numEdges == 0)
+        return 1;
+    if (attack->minWeight <= 0)
+        return -1;
+    return attack->maxWeight / attack->weightGcd + 1;
+}
+
+bool bucketSearchSuits(const Graph *attack)
+{
+    int count = bucketCount(attack);
+    return count > 0 && count <= BUCKET_AUTO_MAX_BUCKETS;
+}
+
+// 从桶from开始(循环)找到第一个非空的桶，occupied[]中至少有一位为1
+static int nextBucket(const uint64_t occupied[], int numWords, int from)
+{
+    int w = from / 64;
+    uint64_t word = occupied[w] & (~0ULL << (from % 64));
+    for (int k = 0; k <= numWords; k++)
+    {
+        if (word != 0)
+            return w * 64 + __builtin_ctzll(word);
+        w = w + 1 < numWords ? w + 1 : 0;
+        word = occupied[w];
+    }
+    return -1;
+}
+
+#define SET_BIT(bits, i) ((bits)[(i) / 64] |= 1ULL << ((i) % 64))
+#define CLEAR_BIT(bits, i) ((bits)[(i) / 64] &= ~(1ULL << ((i) % 64)))
+
+int bucketSearch(Graph *attack, int startingComputer, int time[], int parent[], int order[])
+{
+    int n = attack->numComputers;
+    const int *poodleTime = attack->poodleTime;
+    int numBuckets = bucketCount(attack);
+    if (numBuckets <= 0 || numBuckets > BUCKET_MAX_BUCKETS)
+        return -1;
+    int step = attack->weightGcd > 0 ? attack->weightGcd : 1;
+
+    // 每个桶是一条双向链表，计算机在同一时刻最多在一个桶中，所以next/prev按计算机编号索引。
+    // occupied[]标记非空的桶，当前桶清空后按64位字跳过空桶，而不是逐个检查
+    int numWords = (numBuckets + 63) / 64;
+    int *head = (int *)malloc(numBuckets * sizeof(int));
+    uint64_t *occupied = (uint64_t *)calloc(numWords, sizeof(uint64_t));
+    int *next = (int *)malloc(n * sizeof(int));
+    int *prev = (int *)malloc(n * sizeof(int));
+    if (!head || !occupied || !next || !prev)
+    {
+        free(head);
+        free(occupied);
+        free(next);
+        free(prev);
+        return -1;
+    }
+
+    for (int b = 0; b < numBuckets; b++)
+    {
+        head[b] = -1;
+    }
+    for (int v = 0; v < n; v++)
+    {
+        time[v] = INT_MAX;
+        if (parent)
+            parent[v] = -1;
+    }
+
+    int current = poodleTime[startingComputer];
+    time[startingComputer] = current;
+    head[0] = startingComputer;
+    next[startingComputer] = -1;
+    prev[startingComputer] = -1;
+    SET_BIT(occupied, 0);
+    int pending = 1; // 所有桶中的计算机数量
+    int count = 0;
+
+    for (int b = 0; pending > 0;)
+    {
+        // 当前桶中的计算机时间都是current，已经确定；新时间至少为current + step，不会落回当前桶
+        while (head[b] != -1)
+        {
+            int u = head[b];
+            head[b] = next[u];
+            pending--;
+            order[count++] = u;
+
+            for (int e = attack->offsets[u]; e < attack->offsets[u + 1]; e++)
+            {
+                int v = attack->dest[e];
+                int newTime = current + attack->transmissionTime[e] + poodleTime[v];
+                if (newTime < time[v])
+                {
+                    // decrease-key：从原来的桶中摘下
+                    if (time[v] == INT_MAX)
+                    {
+                        pending++;
+                    }
+                    else
+                    {
+                        int ob = (b + (time[v] - current) / step) % numBuckets;
+                        if (prev[v] != -1)
+                            next[prev[v]] = next[v];
+                        else if ((head[ob] = next[v]) == -1)
+                            CLEAR_BIT(occupied, ob);
+                        if (next[v] != -1)
+                            prev[next[v]] = prev[v];
+                    }
+
+                    int nb = (b + (newTime - current) / step) % numBuckets;
+                    time[v] = newTime;
+                    next[v] = head[nb];
+                    prev[v] = -1;
+                    if (head[nb] != -1)
+                        prev[head[nb]] = v;
+                    head[nb] = v;
+                    SET_BIT(occupied, nb);
+                    if (parent)
+                        parent[v] = u;
+                }
+                else if (parent && newTime == time[v] && time[parent[v]] == current &&
+                         GRAPH_LABEL(attack, u) < GRAPH_LABEL(attack, parent[v]))
+                {
+                    // 时间相同的入侵者中取(原)编号最小的一个
+                    parent[v] = u;
+                }
+            }
+        }
+
+        CLEAR_BIT(occupied, b);
+        if (pending == 0)
+            break;
+        int nb = nextBucket(occupied, numWords, b + 1 < numBuckets ? b + 1 : 0);
+        current += ((nb - b + numBuckets) % numBuckets) * step;
+        b = nb;
+    }
+
+    // order[]中每一段时间相同的计算机按编号排列：段的起点记在next[]中、每台计算机所在的段记在prev[]中，
+    // 再按(原)编号递增把计算机分发到各自段的下一个位置
+    int numGroups = 0;
+    for (int i = 0; i < count; i++)
+    {
+        if (i == 0 || time[order[i]] != time[order[i - 1]])
+            next[numGroups++] = i;
+        prev[order[i]] = numGroups - 1;
+    }
+    if (numGroups < count)
+    {
+        for (int c = 0; c < n; c++)
+        {
+            int v = GRAPH_POSITION(attack, c);
+            if (time[v] != INT_MAX)
+                order[next[prev[v]]++] = v;
+        }
+    }
+
+    free(head);
+    free(occupied);
+    free(next);
+    free(prev);
+    return count;
+}
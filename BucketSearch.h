@@ -0,0 +1,38 @@
+#ifndef BUCKET_SEARCH_H
+#define BUCKET_SEARCH_H
+
+#include <stdbool.h>
+
+#include "Graph.h"
+
+// 桶队列(Dial算法)：边权种类少时poodle(Task 3)的顺序最短路后端
+//
+// 攻击图中所有边权都是weightGcd的倍数，所以从源出发的入侵时间只可能是
+// time(源) + k · weightGcd。每个这样的时间对应一个桶，新时间与当前时间相差
+// weightGcd到maxWeight之间，只需要maxWeight / weightGcd + 1个桶循环使用。
+// 按时间顺序逐个清空桶就是Dijkstra的出队顺序，入队、decrease-key与出队都是O(1)，不需要堆。
+// 非空的桶记在一个位图中，清空一个桶之后按64位字找下一个非空的桶，
+// 总代价为O(V + E + 不同入侵时间的数量 · 桶数量 / 64)。全部边权相同时只有两个桶交替使用，就是按层的BFS。
+//
+// 同一个桶中计算机的处理顺序是任意的，结果按poodleSearch的规则确定，与Dijkstra完全相同：
+// parent[v]为给出time[v]的入侵者中(时间, 编号)最小的一个(时间相同的入侵者比较编号)，
+// order[]在搜索结束后按编号分发一遍，得到(时间, 编号)的顺序。
+
+// ENGINE_AUTO只在桶数量不超过这个值时使用桶引擎：每次找下一个非空的桶最多检查32个字。
+// 最坏的情况是每台计算机的入侵时间都不同的长链，在这个上限附近与基数堆持平
+#define BUCKET_AUTO_MAX_BUCKETS 2048
+
+// 桶数量的硬上限，超过时bucketSearch拒绝搜索
+#define BUCKET_MAX_BUCKETS (1 << 20)
+
+// 攻击图(见buildAttackGraph)的桶数量，边权不全为正时返回-1
+int bucketCount(const Graph *attack);
+
+// ENGINE_AUTO是否应该使用桶引擎
+bool bucketSearchSuits(const Graph *attack);
+
+// 从startingComputer出发沿攻击图计算time[]与order[](以及parent[]，可以为NULL)，
+// 返回能入侵的计算机数量。边权不全为正、桶太多或内存不足时返回-1，此时结果无效。
+int bucketSearch(Graph *attack, int startingComputer, int time[], int parent[], int order[]);
+
+#endif // BUCKET_SEARCH_H
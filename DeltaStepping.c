@@ -0,0 +1,333 @@
+#include "DeltaStepping.h"
+#include "PQueue.h"
+#include <limits.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+// 可增长的整数数组
+typedef struct IntVec
+{
+    int *items;
+    int len;
+    int cap;
+} IntVec;
+
+static bool vecPush(IntVec *vec, int item)
+{
+    if (vec->len == vec->cap)
+    {
+        int cap = vec->cap > 0 ? vec->cap * 2 : 64;
+        int *items = (int *)realloc(vec->items, cap * sizeof(int));
+        if (!items)
+            return false;
+        vec->items = items;
+        vec->cap = cap;
+    }
+    vec->items[vec->len++] = item;
+    return true;
+}
+
+// 一个工作者私有的桶：bins[b]为本轮中时间被降到桶b的计算机，
+// settled为在当前桶中第一次被处理的计算机(其最终时间就在当前桶里)
+typedef struct WorkerBins
+{
+    IntVec *bins;
+    int numBins;
+    IntVec settled;
+} WorkerBins;
+
+typedef struct DeltaSearch
+{
+    Graph *graph;  // 原图，用于查找入侵者
+    Graph *attack; // 攻击图，用于松弛
+    int delta;
+    atomic_int *dist;
+    atomic_char *claimed; // 已加入某个桶的settled列表
+    WorkerBins *workers;
+    int numWorkers;
+    atomic_bool failed;
+
+    // 当前轮
+    int bucket;
+    IntVec frontier;
+
+    // 结束后填写结果
+    int *time;
+    int *parent;
+    const int *order;
+} DeltaSearch;
+
+int chooseDelta(Graph *attack)
+{
+    long long sum = 0;
+    for (int e = 0; e < attack->numEdges; e++)
+    {
+        sum += attack->transmissionTime[e] + attack->poodleTime[attack->dest[e]];
+    }
+    long long delta = attack->numEdges > 0 ? sum / attack->numEdges : 1;
+    return delta < 1 ? 1 : delta > INT_MAX ? INT_MAX : (int)delta;
+}
+
+static bool binPush(DeltaSearch *search, WorkerBins *w, int bucket, int v)
+{
+    if (bucket >= w->numBins)
+    {
+        int numBins = w->numBins > 0 ? w->numBins : 16;
+        while (numBins <= bucket)
+            numBins *= 2;
+        IntVec *bins = (IntVec *)realloc(w->bins, numBins * sizeof(IntVec));
+        if (!bins)
+            return false;
+        memset(bins + w->numBins, 0, (numBins - w->numBins) * sizeof(IntVec));
+        w->bins = bins;
+        w->numBins = numBins;
+    }
+    return vecPush(&w->bins[bucket], v);
+}
+
+// 一轮：并行处理frontier中仍属于当前桶的计算机
+static void relaxTask(void *context, int worker, int begin, int end)
+{
+    DeltaSearch *search = (DeltaSearch *)context;
+    Graph *attack = search->attack;
+    const int *poodleTime = attack->poodleTime;
+    WorkerBins *w = &search->workers[worker];
+    int delta = search->delta;
+
+    for (int i = begin; i < end; i++)
+    {
+        int u = search->frontier.items[i];
+        int du = atomic_load_explicit(&search->dist[u], memory_order_relaxed);
+        if (du / delta != search->bucket)
+            continue; // 时间已被降到更早的桶并在那里处理过
+
+        if (!atomic_exchange_explicit(&search->claimed[u], 1, memory_order_relaxed) &&
+            !vecPush(&w->settled, u))
+            atomic_store(&search->failed, true);
+
+        for (int e = attack->offsets[u]; e < attack->offsets[u + 1]; e++)
+        {
+            int v = attack->dest[e];
+            int newTime = du + attack->transmissionTime[e] + poodleTime[v];
+            int old = atomic_load_explicit(&search->dist[v], memory_order_relaxed);
+            while (newTime < old)
+            {
+                if (atomic_compare_exchange_weak_explicit(&search->dist[v], &old, newTime,
+                                                          memory_order_relaxed, memory_order_relaxed))
+                {
+                    if (!binPush(search, w, newTime / delta, v))
+                        atomic_store(&search->failed, true);
+                    break;
+                }
+            }
+        }
+    }
+}
+
+static void initTask(void *context, int worker, int begin, int end)
+{
+    DeltaSearch *search = (DeltaSearch *)context;
+    for (int v = begin; v < end; v++)
+    {
+        atomic_init(&search->dist[v], INT_MAX);
+        atomic_init(&search->claimed[v], 0);
+    }
+}
+
+static void copyTimeTask(void *context, int worker, int begin, int end)
+{
+    DeltaSearch *search = (DeltaSearch *)context;
+    for (int v = begin; v < end; v++)
+    {
+        search->time[v] = atomic_load_explicit(&search->dist[v], memory_order_relaxed);
+        if (search->parent)
+            search->parent[v] = -1;
+    }
+}
+
+// parent[v]：给出time[v]的入侵者中(时间, 编号)最小的一个
+static void parentTask(void *context, int worker, int begin, int end)
+{
+    DeltaSearch *search = (DeltaSearch *)context;
+    Graph *graph = search->graph;
+    int *time = search->time;
+
+    for (int i = begin; i < end; i++)
+    {
+        int v = search->order[i];
+        int best = -1;
+        int level = GRAPH_LEVEL(graph, v);
+        if (i > 0)
+        {
+            for (int e = graph->offsets[v]; e < graph->offsets[v + 1]; e++)
+            {
+                int u = graph->dest[e];
+                if (time[u] == INT_MAX || GRAPH_LEVEL(graph, u) + 1 < level ||
+                    time[u] + graph->transmissionTime[e] + graph->poodleTime[v] != time[v])
+                    continue;
+                if (best == -1 || time[u] < time[best] ||
+                    (time[u] == time[best] && GRAPH_LABEL(graph, u) < GRAPH_LABEL(graph, best)))
+                    best = u;
+            }
+        }
+        search->parent[v] = best;
+    }
+}
+
+static int compareKeys(const void *a, const void *b)
+{
+    uint64_t x = *(const uint64_t *)a;
+    uint64_t y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+// 当前桶处理完毕：把各工作者在此桶中settled的计算机按(时间, 编号)排序后追加到order[]
+static bool finishBucket(DeltaSearch *search, int order[], int *count, uint64_t **keys, int *keyCap)
+{
+    int total = 0;
+    for (int w = 0; w < search->numWorkers; w++)
+    {
+        total += search->workers[w].settled.len;
+    }
+    if (total > *keyCap)
+    {
+        uint64_t *grown = (uint64_t *)realloc(*keys, total * sizeof(uint64_t));
+        if (!grown)
+            return false;
+        *keys = grown;
+        *keyCap = total;
+    }
+
+    int k = 0;
+    for (int w = 0; w < search->numWorkers; w++)
+    {
+        IntVec *settled = &search->workers[w].settled;
+        for (int i = 0; i < settled->len; i++)
+        {
+            int v = settled->items[i];
+            (*keys)[k++] = PQ_KEY(atomic_load_explicit(&search->dist[v], memory_order_relaxed),
+                                  GRAPH_LABEL(search->graph, v));
+        }
+        settled->len = 0;
+    }
+    qsort(*keys, total, sizeof(uint64_t), compareKeys);
+    for (int i = 0; i < total; i++)
+    {
+        order[(*count)++] = GRAPH_POSITION(search->graph, (int)(uint32_t)(*keys)[i]);
+    }
+    return true;
+}
+
+// 每个工作者每次领取的计算机数量
+#define DELTA_CHUNK 64
+
+int deltaSteppingSearch(Graph *graph, Graph *attack, ThreadPool *pool, int delta, int startingComputer,
+                        int time[], int parent[], int order[])
+{
+    int n = graph->numComputers;
+    int numWorkers = threadPoolSize(pool);
+
+    DeltaSearch search = {graph, attack, delta};
+    search.dist = (atomic_int *)malloc(n * sizeof(atomic_int));
+    search.claimed = (atomic_char *)malloc(n * sizeof(atomic_char));
+    search.workers = (WorkerBins *)calloc(numWorkers, sizeof(WorkerBins));
+    search.numWorkers = numWorkers;
+    atomic_init(&search.failed, false);
+    search.time = time;
+    search.parent = parent;
+    search.order = order;
+
+    uint64_t *keys = NULL;
+    int keyCap = 0;
+    int count = 0;
+    bool ok = search.dist && search.claimed && search.workers;
+
+    if (ok)
+    {
+        threadPoolRun(pool, n, 4096, initTask, &search);
+
+        int startTime = graph->poodleTime[startingComputer];
+        atomic_store(&search.dist[startingComputer], startTime);
+        search.bucket = startTime / delta;
+        ok = vecPush(&search.frontier, startingComputer);
+    }
+
+    while (ok)
+    {
+        threadPoolRun(pool, search.frontier.len, DELTA_CHUNK, relaxTask, &search);
+        if (atomic_load(&search.failed))
+        {
+            ok = false;
+            break;
+        }
+
+        // 找到下一个非空的桶；若不再是当前桶，当前桶中的时间都已确定
+        int next = -1;
+        for (int w = 0; w < numWorkers; w++)
+        {
+            WorkerBins *wb = &search.workers[w];
+            int limit = next == -1 ? wb->numBins : (next < wb->numBins ? next : wb->numBins);
+            for (int b = search.bucket; b < limit; b++)
+            {
+                if (wb->bins[b].len > 0)
+                {
+                    next = b;
+                    break;
+                }
+            }
+        }
+        if (next != search.bucket && !finishBucket(&search, order, &count, &keys, &keyCap))
+        {
+            ok = false;
+            break;
+        }
+        if (next == -1)
+            break;
+
+        // 合并各工作者的桶next作为下一轮的frontier，并释放这些桶
+        search.bucket = next;
+        search.frontier.len = 0;
+        for (int w = 0; w < numWorkers && ok; w++)
+        {
+            WorkerBins *wb = &search.workers[w];
+            if (next >= wb->numBins)
+                continue;
+            IntVec *bin = &wb->bins[next];
+            for (int i = 0; i < bin->len && ok; i++)
+            {
+                ok = vecPush(&search.frontier, bin->items[i]);
+            }
+            free(bin->items);
+            *bin = (IntVec){NULL, 0, 0};
+        }
+    }
+
+    if (ok)
+    {
+        threadPoolRun(pool, n, 4096, copyTimeTask, &search);
+        if (parent)
+            threadPoolRun(pool, count, DELTA_CHUNK, parentTask, &search);
+    }
+
+    if (search.workers)
+    {
+        for (int w = 0; w < numWorkers; w++)
+        {
+            for (int b = 0; b < search.workers[w].numBins; b++)
+            {
+                free(search.workers[w].bins[b].items);
+            }
+            free(search.workers[w].bins);
+            free(search.workers[w].settled.items);
+        }
+    }
+    free(search.workers);
+    free(search.frontier.items);
+    free(search.dist);
+    free(search.claimed);
+    free(keys);
+    return ok ? count : -1;
+}
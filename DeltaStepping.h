@@ -0,0 +1,29 @@
+#ifndef DELTA_STEPPING_H
+#define DELTA_STEPPING_H
+
+#include "Graph.h"
+#include "ThreadPool.h"
+
+// 并行delta-stepping：poodle(Task 3)的多线程最短路后端
+//
+// 按入侵时间把计算机分进宽度为delta的桶，从编号最小的非空桶开始，
+// 桶内的计算机由线程池中的全部工作者并行松弛：
+// 新时间 = time[u] + transmissionTime + poodleTime(v)，且只沿安全等级允许的方向(level(u) + 1 >= level(v)，即攻击图的边)，
+// 与poodle的Dijkstra完全相同。时间用原子的比较交换取最小值，更新成功的计算机放入工作者自己的桶，
+// 落回当前桶的(轻边)在下一轮继续处理，直到当前桶不再有新的计算机，再前进到下一个非空桶。
+// 每一轮结束时线程池的返回就是全局同步点，所以不需要额外的锁。
+//
+// 得到的time[]与Dijkstra完全相同。order[]与parent[]按poodleSearch的规则确定：
+// order[]按(时间, 编号)排列(每个桶完成时对其中的计算机排序)，
+// parent[v]为给出time[v]的入侵者中(时间, 编号)最小的一个，与Dijkstra按此顺序出队时的选择相同。
+
+// 根据攻击图(见buildAttackGraph)的边权(传输时间 + 目标的poodleTime)的平均值选择桶宽，至少为1
+int chooseDelta(Graph *attack);
+
+// 从startingComputer出发计算time[]与order[](以及parent[]，可以为NULL)，
+// 返回能入侵的计算机数量；内存不足时返回-1，此时结果无效。
+// 松弛沿攻击图attack的边进行，查找入侵者时需要反向的边，使用原图graph。
+int deltaSteppingSearch(Graph *graph, Graph *attack, ThreadPool *pool, int delta, int startingComputer,
+                        int time[], int parent[], int order[]);
+
+#endif // DELTA_STEPPING_H
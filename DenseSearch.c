@@ -0,0 +1,292 @@
+#include "DenseSearch.h"
+#include <limits.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define DENSE_X86 1
+#else
+#define DENSE_X86 0
+#endif
+
+// 矩阵的行与时间数组都补齐到16个int(一条缓存行、一个AVX-512寄存器)的倍数
+#define DENSE_LANES 16
+
+// 没有边
+#define DENSE_INF INT_MAX
+
+// 已确定的标记位
+#define SETTLED_BIT 0x80000000u
+
+// 补齐位置的键：按有符号数为-1(不会被松弛)，按无符号数最大(不会被选中)
+#define PADDING_KEY (-1)
+
+struct DenseMatrix
+{
+    int numComputers;
+    int width;   // 每一行的长度，numComputers向上取到DENSE_LANES的倍数
+    int *weight; // numComputers行，按64字节对齐
+};
+
+DenseKernel denseBestKernel(void)
+{
+#if DENSE_X86
+    if (__builtin_cpu_supports("avx512f"))
+        return DENSE_KERNEL_AVX512;
+    if (__builtin_cpu_supports("avx2"))
+        return DENSE_KERNEL_AVX2;
+#endif
+    return DENSE_KERNEL_SCALAR;
+}
+
+const char *denseKernelName(DenseKernel kernel)
+{
+    switch (kernel)
+    {
+    case DENSE_KERNEL_AVX2:
+        return "avx2";
+    case DENSE_KERNEL_AVX512:
+        return "avx512";
+    default:
+        return "scalar";
+    }
+}
+
+bool denseSearchSuits(const Graph *attack)
+{
+    long long n = attack->numComputers;
+    return denseBestKernel() != DENSE_KERNEL_SCALAR && n <= DENSE_MAX_COMPUTERS &&
+           (long long)attack->numEdges * DENSE_AUTO_DENSITY >= n * n;
+}
+
+// 按64字节对齐分配count个int
+static int *alignedInts(size_t count)
+{
+    size_t size = (count * sizeof(int) + 63) / 64 * 64;
+    return (int *)aligned_alloc(64, size > 0 ? size : 64);
+}
+
+DenseMatrix *buildDenseMatrix(const Graph *attack)
+{
+    int n = attack->numComputers;
+    if (n > DENSE_MAX_COMPUTERS)
+        return NULL;
+
+    DenseMatrix *matrix = (DenseMatrix *)malloc(sizeof(DenseMatrix));
+    int width = (n + DENSE_LANES - 1) / DENSE_LANES * DENSE_LANES;
+    int *weight = alignedInts((size_t)width * n);
+    if (!matrix || !weight)
+    {
+        free(matrix);
+        free(weight);
+        return NULL;
+    }
+    matrix->numComputers = n;
+    matrix->width = width;
+    matrix->weight = weight;
+
+    for (size_t k = 0; k < (size_t)width * n; k++)
+    {
+        weight[k] = DENSE_INF;
+    }
+    for (int u = 0; u < n; u++)
+    {
+        int *row = weight + (size_t)GRAPH_LABEL(attack, u) * width;
+        for (int e = attack->offsets[u]; e < attack->offsets[u + 1]; e++)
+        {
+            int v = attack->dest[e];
+            int j = GRAPH_LABEL(attack, v);
+            int w = attack->transmissionTime[e] + attack->poodleTime[v];
+            if (w < row[j])
+                row[j] = w;
+        }
+    }
+    return matrix;
+}
+
+void freeDenseMatrix(DenseMatrix *matrix)
+{
+    if (matrix)
+    {
+        free(matrix->weight);
+        free(matrix);
+    }
+}
+
+// 核：刚确定的计算机u(时间为t)用它的一行row[]松弛key[]，入侵者记在from[]中，
+// 同时返回键最小(按无符号数比较，相同时下标最小)的未确定计算机，全部确定或无法入侵时返回-1
+
+static int relaxScalar(const int *row, int *key, int *from, int t, int u, int width)
+{
+    unsigned best = UINT_MAX;
+    int bestIndex = -1;
+    for (int j = 0; j < width; j++)
+    {
+        int w = row[j];
+        if (w != DENSE_INF && t + w < key[j])
+        {
+            key[j] = t + w;
+            from[j] = u;
+        }
+        if ((unsigned)key[j] < best)
+        {
+            best = (unsigned)key[j];
+            bestIndex = j;
+        }
+    }
+    return best < (unsigned)INT_MAX ? bestIndex : -1;
+}
+
+#if DENSE_X86
+
+// 各个通道的最小值与下标合并成一个：值最小，相同时下标最小
+static int reduceLanes(const unsigned value[], const int index[], int lanes)
+{
+    unsigned best = UINT_MAX;
+    int bestIndex = -1;
+    for (int l = 0; l < lanes; l++)
+    {
+        if (value[l] < best || (value[l] == best && index[l] < bestIndex))
+        {
+            best = value[l];
+            bestIndex = index[l];
+        }
+    }
+    return best < (unsigned)INT_MAX ? bestIndex : -1;
+}
+
+__attribute__((target("avx2"))) static int relaxAvx2(const int *row, int *key, int *from, int t, int u,
+                                                     int width)
+{
+    const __m256i vt = _mm256_set1_epi32(t);
+    const __m256i vu = _mm256_set1_epi32(u);
+    const __m256i inf = _mm256_set1_epi32(DENSE_INF);
+    const __m256i step = _mm256_set1_epi32(8);
+    __m256i lane = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    __m256i bestValue = _mm256_set1_epi32(-1);
+    __m256i bestIndex = _mm256_set1_epi32(-1);
+
+    for (int j = 0; j < width; j += 8)
+    {
+        __m256i w = _mm256_load_si256((const __m256i *)(row + j));
+        __m256i k = _mm256_load_si256((const __m256i *)(key + j));
+        __m256i candidate = _mm256_add_epi32(vt, w);
+        __m256i better = _mm256_andnot_si256(_mm256_cmpeq_epi32(w, inf), _mm256_cmpgt_epi32(k, candidate));
+        k = _mm256_blendv_epi8(k, candidate, better);
+        _mm256_store_si256((__m256i *)(key + j), k);
+        _mm256_maskstore_epi32(from + j, better, vu);
+
+        // 每个通道只在严格变小时换下标，所以保留的是该通道中第一次出现的最小值
+        __m256i smaller = _mm256_min_epu32(k, bestValue);
+        __m256i same = _mm256_cmpeq_epi32(smaller, bestValue);
+        bestIndex = _mm256_blendv_epi8(lane, bestIndex, same);
+        bestValue = smaller;
+        lane = _mm256_add_epi32(lane, step);
+    }
+
+    unsigned value[8];
+    int index[8];
+    _mm256_storeu_si256((__m256i *)value, bestValue);
+    _mm256_storeu_si256((__m256i *)index, bestIndex);
+    return reduceLanes(value, index, 8);
+}
+
+__attribute__((target("avx512f"))) static int relaxAvx512(const int *row, int *key, int *from, int t, int u,
+                                                          int width)
+{
+    const __m512i vt = _mm512_set1_epi32(t);
+    const __m512i vu = _mm512_set1_epi32(u);
+    const __m512i inf = _mm512_set1_epi32(DENSE_INF);
+    const __m512i step = _mm512_set1_epi32(16);
+    __m512i lane = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    __m512i bestValue = _mm512_set1_epi32(-1);
+    __m512i bestIndex = _mm512_set1_epi32(-1);
+
+    for (int j = 0; j < width; j += 16)
+    {
+        __m512i w = _mm512_load_si512((const void *)(row + j));
+        __m512i k = _mm512_load_si512((const void *)(key + j));
+        __m512i candidate = _mm512_add_epi32(vt, w);
+        __mmask16 better = _mm512_mask_cmpgt_epi32_mask(_mm512_cmpneq_epi32_mask(w, inf), k, candidate);
+        k = _mm512_mask_mov_epi32(k, better, candidate);
+        _mm512_store_si512((void *)(key + j), k);
+        _mm512_mask_storeu_epi32(from + j, better, vu);
+
+        __mmask16 smaller = _mm512_cmplt_epu32_mask(k, bestValue);
+        bestValue = _mm512_mask_mov_epi32(bestValue, smaller, k);
+        bestIndex = _mm512_mask_mov_epi32(bestIndex, smaller, lane);
+        lane = _mm512_add_epi32(lane, step);
+    }
+
+    unsigned value[16];
+    int index[16];
+    _mm512_storeu_si512((void *)value, bestValue);
+    _mm512_storeu_si512((void *)index, bestIndex);
+    return reduceLanes(value, index, 16);
+}
+
+#endif // DENSE_X86
+
+int denseSearch(const DenseMatrix *matrix, const Graph *attack, DenseKernel kernel, int startingComputer,
+                int time[], int parent[], int order[])
+{
+    int n = matrix->numComputers;
+    int width = matrix->width;
+    int *key = alignedInts(width);
+    int *from = alignedInts(width); // 入侵者(调用者的编号)
+    if (!key || !from)
+    {
+        free(key);
+        free(from);
+        return -1;
+    }
+
+    // CPU不支持的核退回标量实现
+    DenseKernel best = denseBestKernel();
+    if (kernel > best)
+        kernel = best;
+
+    for (int j = 0; j < width; j++)
+    {
+        key[j] = j < n ? INT_MAX : PADDING_KEY;
+        from[j] = -1;
+    }
+
+    int u = GRAPH_LABEL(attack, startingComputer);
+    key[u] = attack->poodleTime[startingComputer];
+    int count = 0;
+    while (u != -1)
+    {
+        int t = key[u];
+        key[u] = (int)((unsigned)t | SETTLED_BIT);
+        order[count++] = u;
+
+        const int *row = matrix->weight + (size_t)u * width;
+#if DENSE_X86
+        if (kernel == DENSE_KERNEL_AVX512)
+            u = relaxAvx512(row, key, from, t, u, width);
+        else if (kernel == DENSE_KERNEL_AVX2)
+            u = relaxAvx2(row, key, from, t, u, width);
+        else
+#endif
+            u = relaxScalar(row, key, from, t, u, width);
+    }
+
+    // 换回图中的编号；能入侵的计算机都已确定，键为负数
+    for (int v = 0; v < n; v++)
+    {
+        int i = GRAPH_LABEL(attack, v);
+        time[v] = key[i] < 0 ? (int)((unsigned)key[i] & ~SETTLED_BIT) : INT_MAX;
+        if (parent)
+            parent[v] = from[i] == -1 ? -1 : GRAPH_POSITION(attack, from[i]);
+    }
+    for (int i = 0; i < count; i++)
+    {
+        order[i] = GRAPH_POSITION(attack, order[i]);
+    }
+
+    free(key);
+    free(from);
+    return count;
+}
@@ -0,0 +1,60 @@
+#ifndef DENSE_SEARCH_H
+#define DENSE_SEARCH_H
+
+#include <stdbool.h>
+
+#include "Graph.h"
+
+// 稠密网络(攻击图的边数接近V²)上poodle(Task 3)的数组扫描Dijkstra
+//
+// 边数接近V²时，优先队列的每一次入队几乎都对应一次松弛，而O(V²)的数组扫描在渐近意义上已经最优。
+// 这里把攻击图展开成一个V × V的边权矩阵(行按16个int对齐，补INF)，每确定一台计算机，
+// 就用一个SIMD核在同一遍中完成两件事：用它的一行松弛所有计算机的时间，并找出下一台要确定的计算机。
+// 矩阵按行顺序读取，不再通过dest[]随机访问time[]。
+//
+// 已确定的标记合并在时间数组中：已确定的计算机的键为时间 | 0x80000000。按有符号数比较时它是负数，
+// 松弛永远不会把它改大；按无符号数比较时它大于任何未确定的时间，找最小值时自然被跳过。
+// 矩阵与时间数组都按调用者的编号(GRAPH_LABEL)排列，时间相同时下标小的先被找到，
+// 所以出队顺序是(时间, 编号)；只在时间严格变小时更新入侵者，结果与Dijkstra完全相同。
+
+// 稠密引擎处理的计算机数量上限，矩阵最多占用 DENSE_MAX_COMPUTERS² · 4 字节(256MB)
+#define DENSE_MAX_COMPUTERS 8192
+
+// ENGINE_AUTO在攻击图的边数不少于 V² / DENSE_AUTO_DENSITY、计算机不超过上限且CPU支持SIMD核时
+// 使用稠密引擎。V为1000到8000时，AVX-512核与基数堆/桶队列在E / V²约为1/4处持平，
+// 标量核在任何密度下都慢于基数堆
+#define DENSE_AUTO_DENSITY 4
+
+// 松弛与找最小值的核，按CPU支持的指令集选择
+typedef enum DenseKernel
+{
+    DENSE_KERNEL_SCALAR, // 标量实现，任何平台都可用
+    DENSE_KERNEL_AVX2,   // 每次8台计算机
+    DENSE_KERNEL_AVX512, // 每次16台计算机
+} DenseKernel;
+
+// 当前CPU上最快的可用核
+DenseKernel denseBestKernel(void);
+
+// 核的名称，用于报告
+const char *denseKernelName(DenseKernel kernel);
+
+// ENGINE_AUTO是否应该使用稠密引擎
+bool denseSearchSuits(const Graph *attack);
+
+typedef struct DenseMatrix DenseMatrix;
+
+// 由攻击图(见buildAttackGraph)构建边权矩阵：第i行第j列为调用者编号i到j的边权
+// (传输时间 + j的poodleTime，多条连接时取最小值)，没有边时为INF。
+// 计算机超过DENSE_MAX_COMPUTERS或内存不足时返回NULL
+DenseMatrix *buildDenseMatrix(const Graph *attack);
+
+void freeDenseMatrix(DenseMatrix *matrix);
+
+// 从startingComputer(图中的编号)出发计算time[]与order[](以及parent[]，可以为NULL)，
+// 结果与poodleSearch的其余引擎相同(图中的编号)，返回能入侵的计算机数量。
+// kernel不被CPU支持时使用标量核。内存不足时返回-1，此时结果无效。
+int denseSearch(const DenseMatrix *matrix, const Graph *attack, DenseKernel kernel, int startingComputer,
+                int time[], int parent[], int order[]);
+
+#endif // DENSE_SEARCH_H
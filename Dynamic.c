@@ -0,0 +1,607 @@
+#include "Dynamic.h"
+#include "InfectionTree.h"
+#include "Network.h"
+#include "PQueue.h"
+#include <limits.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+// 邻接表中的一项：邻居与所用连接的编号(传输时间保存在连接表中，修改时只需改一处)
+typedef struct AdjEntry
+{
+    int neighbor;
+    int connection;
+} AdjEntry;
+
+// 可增删的邻接表，删除时用最后一项填补空位，所以表内顺序不固定
+// (parent的选择规则不依赖邻接顺序，结果不受影响)
+typedef struct AdjList
+{
+    AdjEntry *entries;
+    int len;
+    int cap;
+} AdjList;
+
+// a为-1表示连接已被删除，编号不会被复用
+typedef struct DynConnection
+{
+    int a;
+    int b;
+    int transmissionTime;
+} DynConnection;
+
+struct DynamicPoodle
+{
+    int numComputers;
+    int start;
+    struct computer *computers; // 拷贝，安全等级会被修改
+    AdjList *adj;
+
+    DynConnection *conns;
+    int numConns;
+    int capConns;
+
+    int *time;
+    int *parent;
+    int numInfected;
+
+    PQueue *pq;
+
+    // 每次更新使用的标记，stamp[v] == epoch 表示本次更新中v在对应的集合里
+    int epoch;
+    int *invalidStamp; // 所在子树失去支撑、时间需要重新计算
+    int *dirtyStamp;   // 需要重新选择parent
+    int *supportStamp; // 检查子节点时：仍被父节点支撑
+    int *invalid;      // 失效的计算机列表
+    int numInvalid;
+    int *dirty;        // 需要重新选择parent的计算机列表
+    int numDirty;
+    int lastAffected;
+};
+
+// 安全等级是否允许u入侵v
+static inline bool canAttack(DynamicPoodle *dp, int u, int v)
+{
+    return dp->computers[u].securityLevel + 1 >= dp->computers[v].securityLevel;
+}
+
+static inline int entryTime(DynamicPoodle *dp, AdjEntry *entry)
+{
+    return dp->conns[entry->connection].transmissionTime;
+}
+
+static bool adjAppend(AdjList *list, int neighbor, int connection)
+{
+    if (list->len == list->cap)
+    {
+        int cap = list->cap > 0 ? list->cap * 2 : 4;
+        AdjEntry *entries = (AdjEntry *)realloc(list->entries, cap * sizeof(AdjEntry));
+        if (!entries)
+            return false;
+        list->entries = entries;
+        list->cap = cap;
+    }
+    list->entries[list->len++] = (AdjEntry){neighbor, connection};
+    return true;
+}
+
+static void adjRemove(AdjList *list, int connection)
+{
+    for (int i = 0; i < list->len; i++)
+    {
+        if (list->entries[i].connection == connection)
+        {
+            list->entries[i] = list->entries[--list->len];
+            return;
+        }
+    }
+}
+
+// 修改time[v]并维护能被入侵的计算机数量
+static inline void setTime(DynamicPoodle *dp, int v, int t)
+{
+    dp->numInfected += (t != INT_MAX) - (dp->time[v] != INT_MAX);
+    dp->time[v] = t;
+}
+
+static inline void markDirty(DynamicPoodle *dp, int v)
+{
+    if (dp->dirtyStamp[v] != dp->epoch)
+    {
+        dp->dirtyStamp[v] = dp->epoch;
+        dp->dirty[dp->numDirty++] = v;
+    }
+}
+
+static inline void addInvalidRoot(DynamicPoodle *dp, int v)
+{
+    if (dp->invalidStamp[v] != dp->epoch)
+    {
+        dp->invalidStamp[v] = dp->epoch;
+        dp->invalid[dp->numInvalid++] = v;
+    }
+}
+
+// 经过u -> v(传输时间w)是否能得到更早的时间，能则更新并入队
+static void relax(DynamicPoodle *dp, int u, int v, int w)
+{
+    if (dp->time[u] == INT_MAX || !canAttack(dp, u, v))
+        return;
+
+    int newTime = dp->time[u] + w + dp->computers[v].poodleTime;
+    if (newTime < dp->time[v])
+    {
+        setTime(dp, v, newTime);
+        markDirty(dp, v);
+        pqPush(dp->pq, v, PQ_KEY(newTime, v));
+    }
+}
+
+// v与parent[v]之间是否仍有一条可入侵、且恰好给出time[v]的连接
+static bool isSupported(DynamicPoodle *dp, int v)
+{
+    int u = dp->parent[v];
+    if (u == -1 || dp->time[u] == INT_MAX || !canAttack(dp, u, v))
+        return false;
+
+    AdjList *list = &dp->adj[v];
+    for (int i = 0; i < list->len; i++)
+    {
+        AdjEntry *entry = &list->entries[i];
+        if (entry->neighbor == u &&
+            dp->time[u] + entryTime(dp, entry) + dp->computers[v].poodleTime == dp->time[v])
+            return true;
+    }
+    return false;
+}
+
+// 把u的子节点中不再被u支撑的作为失效子树的根，只扫描u的邻接表两遍
+static void collectUnsupportedChildren(DynamicPoodle *dp, int u)
+{
+    AdjList *list = &dp->adj[u];
+    for (int i = 0; i < list->len; i++)
+    {
+        int y = list->entries[i].neighbor;
+        if (dp->parent[y] == u && canAttack(dp, u, y) &&
+            dp->time[u] + entryTime(dp, &list->entries[i]) + dp->computers[y].poodleTime == dp->time[y])
+            dp->supportStamp[y] = dp->epoch;
+    }
+    for (int i = 0; i < list->len; i++)
+    {
+        int y = list->entries[i].neighbor;
+        if (dp->parent[y] == u && dp->supportStamp[y] != dp->epoch)
+            addInvalidRoot(dp, y);
+    }
+}
+
+// 开始一次更新：新的标记轮次，清空列表与队列
+static void beginUpdate(DynamicPoodle *dp)
+{
+    if (dp->epoch == INT_MAX)
+    {
+        memset(dp->invalidStamp, 0, dp->numComputers * sizeof(int));
+        memset(dp->dirtyStamp, 0, dp->numComputers * sizeof(int));
+        memset(dp->supportStamp, 0, dp->numComputers * sizeof(int));
+        dp->epoch = 0;
+    }
+    dp->epoch++;
+    dp->numInvalid = 0;
+    dp->numDirty = 0;
+    pqClear(dp->pq);
+}
+
+// 使以已收集的根为首的子树全部失效，再让每台失效的计算机从子树外的邻居取得候选时间。
+// 子树外的计算机的时间仍然正确(它们在入侵树上的路径没有受到影响)，所以候选时间都是真实路径的长度。
+static void invalidateSubtrees(DynamicPoodle *dp)
+{
+    // 先沿parent[]收集整棵子树，再修改parent[]
+    for (int i = 0; i < dp->numInvalid; i++)
+    {
+        int v = dp->invalid[i];
+        AdjList *list = &dp->adj[v];
+        for (int k = 0; k < list->len; k++)
+        {
+            int y = list->entries[k].neighbor;
+            if (dp->parent[y] == v)
+                addInvalidRoot(dp, y);
+        }
+    }
+    for (int i = 0; i < dp->numInvalid; i++)
+    {
+        int v = dp->invalid[i];
+        setTime(dp, v, INT_MAX);
+        dp->parent[v] = -1;
+        markDirty(dp, v);
+    }
+
+    for (int i = 0; i < dp->numInvalid; i++)
+    {
+        int v = dp->invalid[i];
+        int best = INT_MAX;
+        AdjList *list = &dp->adj[v];
+        for (int k = 0; k < list->len; k++)
+        {
+            int u = list->entries[k].neighbor;
+            if (dp->invalidStamp[u] == dp->epoch || dp->time[u] == INT_MAX || !canAttack(dp, u, v))
+                continue;
+            int candidate = dp->time[u] + entryTime(dp, &list->entries[k]) + dp->computers[v].poodleTime;
+            if (candidate < best)
+                best = candidate;
+        }
+        if (best != INT_MAX)
+        {
+            setTime(dp, v, best);
+            pqPush(dp->pq, v, PQ_KEY(best, v));
+        }
+    }
+}
+
+// 从队列中的候选出发做Dijkstra，只有时间变短的计算机才会入队，所以只在受影响的区域内展开。
+// 候选都在第一次出队之前入队，之后入队的时间严格大于当前出队的时间，满足基数堆的单调性。
+static void propagate(DynamicPoodle *dp)
+{
+    while (!pqIsEmpty(dp->pq))
+    {
+        int u = pqPopMin(dp->pq, NULL);
+        AdjList *list = &dp->adj[u];
+        for (int i = 0; i < list->len; i++)
+        {
+            relax(dp, u, list->entries[i].neighbor, entryTime(dp, &list->entries[i]));
+        }
+    }
+}
+
+// 与poodleSearch的选择相同：在给出time[v]的入侵者中取(入侵时间, 编号)最小的。
+// Dijkstra中按(时间, 编号)出队，第一个把v更新到最终时间的就是这样的入侵者。
+static int chooseParent(DynamicPoodle *dp, int v)
+{
+    if (v == dp->start || dp->time[v] == INT_MAX)
+        return -1;
+
+    int best = -1;
+    AdjList *list = &dp->adj[v];
+    for (int i = 0; i < list->len; i++)
+    {
+        int u = list->entries[i].neighbor;
+        if (dp->time[u] == INT_MAX || !canAttack(dp, u, v) ||
+            dp->time[u] + entryTime(dp, &list->entries[i]) + dp->computers[v].poodleTime != dp->time[v])
+            continue;
+        if (best == -1 || dp->time[u] < dp->time[best] || (dp->time[u] == dp->time[best] && u < best))
+            best = u;
+    }
+    return best;
+}
+
+// 时间变化的计算机可能成为邻居新的最优入侵者，把它们的邻居也加入待重选的集合
+static void markNeighborsOfChanged(DynamicPoodle *dp)
+{
+    int numChanged = dp->numDirty;
+    for (int i = 0; i < numChanged; i++)
+    {
+        AdjList *list = &dp->adj[dp->dirty[i]];
+        for (int k = 0; k < list->len; k++)
+        {
+            markDirty(dp, list->entries[k].neighbor);
+        }
+    }
+}
+
+static void finishUpdate(DynamicPoodle *dp)
+{
+    for (int i = 0; i < dp->numDirty; i++)
+    {
+        int v = dp->dirty[i];
+        dp->parent[v] = chooseParent(dp, v);
+    }
+    dp->lastAffected = dp->numDirty;
+}
+
+DynamicPoodle *createDynamicPoodle(struct computer computers[], int numComputers,
+                                   struct connection connections[], int numConnections,
+                                   int startingComputer)
+{
+    DynamicPoodle *dp = (DynamicPoodle *)calloc(1, sizeof(DynamicPoodle));
+    if (!dp)
+        return NULL;
+
+    int n = numComputers;
+    dp->numComputers = n;
+    dp->start = startingComputer;
+    dp->computers = (struct computer *)malloc(n * sizeof(struct computer));
+    dp->adj = (AdjList *)calloc(n, sizeof(AdjList));
+    dp->capConns = numConnections > 0 ? numConnections : 1;
+    dp->conns = (DynConnection *)malloc(dp->capConns * sizeof(DynConnection));
+    dp->time = (int *)malloc(n * sizeof(int));
+    dp->parent = (int *)malloc(n * sizeof(int));
+    dp->pq = createPQueue(PQ_QUAD_HEAP, n); // d叉堆的空间一次分配到位，更新途中入队不会失败，失败时状态不变
+    dp->invalidStamp = (int *)calloc(n, sizeof(int));
+    dp->dirtyStamp = (int *)calloc(n, sizeof(int));
+    dp->supportStamp = (int *)calloc(n, sizeof(int));
+    dp->invalid = (int *)malloc(n * sizeof(int));
+    dp->dirty = (int *)malloc(n * sizeof(int));
+    if (!dp->computers || !dp->adj || !dp->conns || !dp->time || !dp->parent || !dp->pq ||
+        !dp->invalidStamp || !dp->dirtyStamp || !dp->supportStamp || !dp->invalid || !dp->dirty)
+    {
+        freeDynamicPoodle(dp);
+        return NULL;
+    }
+    memcpy(dp->computers, computers, n * sizeof(struct computer));
+
+    // 先统计度数，每个邻接表一次分配到位
+    for (int i = 0; i < numConnections; i++)
+    {
+        dp->adj[connections[i].computerA].cap++;
+        dp->adj[connections[i].computerB].cap++;
+    }
+    for (int v = 0; v < n; v++)
+    {
+        if (dp->adj[v].cap > 0)
+        {
+            dp->adj[v].entries = (AdjEntry *)malloc(dp->adj[v].cap * sizeof(AdjEntry));
+            if (!dp->adj[v].entries)
+            {
+                freeDynamicPoodle(dp);
+                return NULL;
+            }
+        }
+    }
+    for (int i = 0; i < numConnections; i++)
+    {
+        int a = connections[i].computerA;
+        int b = connections[i].computerB;
+        dp->conns[i] = (DynConnection){a, b, connections[i].transmissionTime};
+        adjAppend(&dp->adj[a], b, i);
+        adjAppend(&dp->adj[b], a, i);
+    }
+    dp->numConns = numConnections;
+
+    // 初始的入侵树：从起点做一次完整的Dijkstra，再为每台计算机选择parent
+    for (int v = 0; v < n; v++)
+    {
+        dp->time[v] = INT_MAX;
+        dp->parent[v] = -1;
+    }
+    beginUpdate(dp);
+    setTime(dp, startingComputer, computers[startingComputer].poodleTime);
+    pqPush(dp->pq, startingComputer, PQ_KEY(dp->time[startingComputer], startingComputer));
+    propagate(dp);
+    for (int v = 0; v < n; v++)
+    {
+        dp->parent[v] = chooseParent(dp, v);
+    }
+    dp->lastAffected = n;
+
+    return dp;
+}
+
+void freeDynamicPoodle(DynamicPoodle *dp)
+{
+    if (dp)
+    {
+        if (dp->adj)
+        {
+            for (int v = 0; v < dp->numComputers; v++)
+            {
+                free(dp->adj[v].entries);
+            }
+        }
+        free(dp->adj);
+        free(dp->computers);
+        free(dp->conns);
+        free(dp->time);
+        free(dp->parent);
+        freePQueue(dp->pq);
+        free(dp->invalidStamp);
+        free(dp->dirtyStamp);
+        free(dp->supportStamp);
+        free(dp->invalid);
+        free(dp->dirty);
+        free(dp);
+    }
+}
+
+static bool validConnection(DynamicPoodle *dp, int connection)
+{
+    return connection >= 0 && connection < dp->numConns && dp->conns[connection].a != -1;
+}
+
+int dynamicAddConnection(DynamicPoodle *dp, int a, int b, int transmissionTime)
+{
+    if (a < 0 || a >= dp->numComputers || b < 0 || b >= dp->numComputers || a == b ||
+        transmissionTime <= 0)
+        return -1;
+
+    if (dp->numConns == dp->capConns)
+    {
+        DynConnection *conns = (DynConnection *)realloc(dp->conns, 2 * dp->capConns * sizeof(DynConnection));
+        if (!conns)
+            return -1;
+        dp->conns = conns;
+        dp->capConns *= 2;
+    }
+    int id = dp->numConns;
+    if (!adjAppend(&dp->adj[a], b, id))
+        return -1;
+    if (!adjAppend(&dp->adj[b], a, id))
+    {
+        dp->adj[a].len--;
+        return -1;
+    }
+    dp->conns[id] = (DynConnection){a, b, transmissionTime};
+    dp->numConns++;
+
+    // 新增连接只可能让时间变短
+    beginUpdate(dp);
+    relax(dp, a, b, transmissionTime);
+    relax(dp, b, a, transmissionTime);
+    propagate(dp);
+    markNeighborsOfChanged(dp);
+    markDirty(dp, a);
+    markDirty(dp, b);
+    finishUpdate(dp);
+    return id;
+}
+
+bool dynamicRemoveConnection(DynamicPoodle *dp, int connection)
+{
+    if (!validConnection(dp, connection))
+        return false;
+
+    int a = dp->conns[connection].a;
+    int b = dp->conns[connection].b;
+    adjRemove(&dp->adj[a], connection);
+    adjRemove(&dp->adj[b], connection);
+    dp->conns[connection].a = -1;
+
+    // 删除连接只可能让时间变长：若它支撑着某一端，那一端的子树失效
+    beginUpdate(dp);
+    if (dp->parent[b] == a && !isSupported(dp, b))
+        addInvalidRoot(dp, b);
+    if (dp->parent[a] == b && !isSupported(dp, a))
+        addInvalidRoot(dp, a);
+    invalidateSubtrees(dp);
+    propagate(dp);
+    markNeighborsOfChanged(dp);
+    markDirty(dp, a);
+    markDirty(dp, b);
+    finishUpdate(dp);
+    return true;
+}
+
+bool dynamicSetTransmissionTime(DynamicPoodle *dp, int connection, int transmissionTime)
+{
+    if (!validConnection(dp, connection) || transmissionTime <= 0)
+        return false;
+
+    int a = dp->conns[connection].a;
+    int b = dp->conns[connection].b;
+    dp->conns[connection].transmissionTime = transmissionTime;
+
+    // 变大时按删除处理，变小时按新增处理；两种检查都不满足时不做任何事
+    beginUpdate(dp);
+    if (dp->parent[b] == a && !isSupported(dp, b))
+        addInvalidRoot(dp, b);
+    if (dp->parent[a] == b && !isSupported(dp, a))
+        addInvalidRoot(dp, a);
+    invalidateSubtrees(dp);
+    relax(dp, a, b, transmissionTime);
+    relax(dp, b, a, transmissionTime);
+    propagate(dp);
+    markNeighborsOfChanged(dp);
+    markDirty(dp, a);
+    markDirty(dp, b);
+    finishUpdate(dp);
+    return true;
+}
+
+bool dynamicSetSecurityLevel(DynamicPoodle *dp, int computer, int securityLevel)
+{
+    if (computer < 0 || computer >= dp->numComputers || securityLevel < 1 ||
+        securityLevel > MAX_SECURITY_LEVEL)
+        return false;
+
+    dp->computers[computer].securityLevel = securityLevel;
+
+    // 等级变化同时影响computer入侵邻居与邻居入侵computer的权限：
+    // 失去权限的入侵树边使子树失效，新获得的权限作为候选
+    beginUpdate(dp);
+    if (dp->parent[computer] != -1 && !isSupported(dp, computer))
+        addInvalidRoot(dp, computer);
+    collectUnsupportedChildren(dp, computer);
+    invalidateSubtrees(dp);
+
+    AdjList *list = &dp->adj[computer];
+    for (int i = 0; i < list->len; i++)
+    {
+        int y = list->entries[i].neighbor;
+        int w = entryTime(dp, &list->entries[i]);
+        relax(dp, computer, y, w);
+        relax(dp, y, computer, w);
+    }
+    propagate(dp);
+    markNeighborsOfChanged(dp);
+    markDirty(dp, computer);
+    for (int i = 0; i < list->len; i++)
+    {
+        markDirty(dp, list->entries[i].neighbor);
+    }
+    finishUpdate(dp);
+    return true;
+}
+
+const int *dynamicTimes(DynamicPoodle *dp)
+{
+    return dp->time;
+}
+
+const int *dynamicParents(DynamicPoodle *dp)
+{
+    return dp->parent;
+}
+
+int dynamicNumInfected(DynamicPoodle *dp)
+{
+    return dp->numInfected;
+}
+
+int dynamicLastAffected(DynamicPoodle *dp)
+{
+    return dp->lastAffected;
+}
+
+static int compareKeys(const void *a, const void *b)
+{
+    uint64_t x = *(const uint64_t *)a;
+    uint64_t y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+// 按(时间, 编号)排列能被入侵的计算机，与poodleSearch的出队顺序相同。
+// order[]的长度至少为numInfected，内存不足时返回false
+static bool infectionOrder(DynamicPoodle *dp, int order[])
+{
+    uint64_t *keys = (uint64_t *)malloc(dp->numInfected * sizeof(uint64_t));
+    if (!keys)
+        return false;
+
+    int count = 0;
+    for (int v = 0; v < dp->numComputers; v++)
+    {
+        if (dp->time[v] != INT_MAX)
+            keys[count++] = PQ_KEY(dp->time[v], v);
+    }
+    qsort(keys, count, sizeof(uint64_t), compareKeys);
+    for (int i = 0; i < count; i++)
+    {
+        order[i] = (int)(uint32_t)keys[i];
+    }
+
+    free(keys);
+    return true;
+}
+
+struct poodleResult dynamicPoodleResult(DynamicPoodle *dp)
+{
+    struct poodleResult res = {0, NULL};
+
+    int *order = (int *)malloc(dp->numInfected * sizeof(int));
+    if (order && infectionOrder(dp, order))
+        res = buildPoodleResult(dp->time, dp->parent, order, dp->numComputers, dp->numInfected, NULL);
+
+    free(order);
+    return res;
+}
+
+InfectionTree *dynamicInfectionTree(DynamicPoodle *dp)
+{
+    InfectionTree *tree = NULL;
+
+    int *order = (int *)malloc(dp->numInfected * sizeof(int));
+    if (order && infectionOrder(dp, order))
+        tree = buildInfectionTree(dp->time, dp->parent, order, dp->numComputers, dp->numInfected);
+
+    free(order);
+    return tree;
+}
@@ -0,0 +1,61 @@
+#ifndef DYNAMIC_H
+#define DYNAMIC_H
+
+#include <stdbool.h>
+
+#include "InfectionTree.h"
+#include "poodle.h"
+
+// 动态poodle：网络不断变化时维护从固定起点出发的入侵树
+//
+// 保存poodle(Task 3)计算的time[]与parent[]，每次增删连接、修改传输时间或安全等级后
+// 只修复受影响的部分，而不是从头重算：
+// - 变差的更新(删除连接、传输时间变大、失去入侵权限)使以失去支撑的计算机为根的子树失效，
+//   子树中的计算机从子树外的邻居重新取得候选时间；
+// - 变好的更新(新增连接、传输时间变小、获得入侵权限)把变短的时间作为候选；
+// 两类候选一起做一次只在受影响区域内展开的Dijkstra，最后只为时间变化的计算机及其邻居重选parent。
+// parent的选择规则与networkPoodle相同(时间相同时取入侵时间最早、其次编号最小的入侵者)，
+// 所以任何更新之后的dynamicPoodleResult都与在当前网络上重新调用poodle的结果完全相同。
+//
+// 连接用编号表示：初始的connections[i]编号为i，之后新增的连接依次编号。
+// 更新函数在参数不合法(编号越界、连接已删除、自环、非正的传输时间、非法的安全等级)
+// 或内存不足时返回false(dynamicAddConnection返回-1)，此时状态不变。
+typedef struct DynamicPoodle DynamicPoodle;
+
+// 计算初始的入侵树，内存不足时返回NULL。computers[]与connections[]都会被拷贝。
+DynamicPoodle *createDynamicPoodle(struct computer computers[], int numComputers,
+                                   struct connection connections[], int numConnections,
+                                   int startingComputer);
+
+// 释放全部内存(NULL安全)
+void freeDynamicPoodle(DynamicPoodle *dp);
+
+// 在计算机a与b之间新增一条连接，返回其编号
+int dynamicAddConnection(DynamicPoodle *dp, int a, int b, int transmissionTime);
+
+bool dynamicRemoveConnection(DynamicPoodle *dp, int connection);
+
+bool dynamicSetTransmissionTime(DynamicPoodle *dp, int connection, int transmissionTime);
+
+bool dynamicSetSecurityLevel(DynamicPoodle *dp, int computer, int securityLevel);
+
+// 当前每台计算机最早被入侵的时间(无法入侵为INT_MAX)与入侵者(起点与无法入侵的为-1)，
+// 长度为计算机数量，在下一次更新之前有效
+const int *dynamicTimes(DynamicPoodle *dp);
+const int *dynamicParents(DynamicPoodle *dp);
+
+// 当前能被入侵的计算机数量
+int dynamicNumInfected(DynamicPoodle *dp);
+
+// 上一次更新中时间发生变化或需要重新计算的计算机数量，用于衡量修复的范围
+int dynamicLastAffected(DynamicPoodle *dp);
+
+// 按当前的入侵树构建与networkPoodle格式相同的结果，用freePoodleResult释放。
+// 入侵顺序需要对能被入侵的计算机按(时间, 编号)排序，代价为O(V log V)。
+struct poodleResult dynamicPoodleResult(DynamicPoodle *dp);
+
+// 按当前的入侵树构建InfectionTree(见InfectionTree.h)，与更新无关，用freeInfectionTree释放。
+// 代价同样为O(V log V)，内存不足时返回NULL。
+InfectionTree *dynamicInfectionTree(DynamicPoodle *dp);
+
+#endif // DYNAMIC_H
@@ -1,35 +1,88 @@
 #include "Graph.h"
 #include "poodle.h"
+#include <limits.h>
+#include <stdalign.h>
+#include <stddef.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
-Edge *createEdge(int dest, int transmissionTime)
+// 按label[](为NULL时编号不变)从调用者的computers[]填充poodleTime[]与securityLevels[]
+static void fillAttributes(Graph *graph, const struct computer computers[], const int label[])
 {
-    Edge *newEdge = (Edge *)malloc(sizeof(Edge));
-    if (newEdge)
+    memset(graph->securityLevels, 0, GRAPH_LEVELS_SIZE(graph->numComputers));
+    for (int v = 0; v < graph->numComputers; v++)
     {
-        newEdge->dest = dest;
-        newEdge->transmissionTime = transmissionTime;
-        newEdge->next = NULL;
+        const struct computer *computer = &computers[label ? label[v] : v];
+        graph->poodleTime[v] = computer->poodleTime;
+        graph->securityLevels[v >> 1] |= (uint8_t)((computer->securityLevel & 0xF) << ((v & 1) << 2));
     }
-    return newEdge;
 }
 
 Graph *buildGraph(struct computer computers[], int numComputers,
                   struct connection connections[], int numConnections)
 {
-    Graph *graph = (Graph *)malloc(sizeof(Graph));
-    if (!graph)
+    // 图的结构体与各个数组大小都已知，放进同一个区域的同一块内存中，freeGraph一次释放
+    int numEdges = 2 * numConnections;
+    size_t offsetsSize = (numComputers + 1) * sizeof(int);
+    size_t edgeSize = (numEdges + 1) * sizeof(int);
+    size_t levelsSize = GRAPH_LEVELS_SIZE(numComputers) + 1;
+    Arena *arena = createArena(sizeof(Graph) + 2 * offsetsSize + 2 * edgeSize + levelsSize +
+                               6 * alignof(max_align_t));
+    if (!arena)
         return NULL;
 
+    Graph *graph = (Graph *)arenaAlloc(arena, sizeof(Graph));
+    int *offsets = (int *)arenaAlloc(arena, offsetsSize);
+    int *dest = (int *)arenaAlloc(arena, edgeSize);
+    int *transmissionTime = (int *)arenaAlloc(arena, edgeSize);
+    int *poodleTime = (int *)arenaAlloc(arena, offsetsSize);
+    uint8_t *securityLevels = (uint8_t *)arenaAlloc(arena, levelsSize);
+    if (!graph || !offsets || !dest || !transmissionTime || !poodleTime || !securityLevels)
+    {
+        freeArena(arena);
+        return NULL;
+    }
+
     graph->numComputers = numComputers;
-    graph->computers = computers;
-    graph->array = (AdjList *)calloc(numComputers, sizeof(AdjList));
-    if (!graph->array)
+    graph->numEdges = numEdges;
+    graph->offsets = offsets;
+    graph->dest = dest;
+    graph->transmissionTime = transmissionTime;
+    graph->arena = arena;
+    graph->label = NULL;
+    graph->position = NULL;
+    graph->poodleTime = poodleTime;
+    graph->securityLevels = securityLevels;
+    fillAttributes(graph, computers, NULL);
+    memset(offsets, 0, offsetsSize);
+
+    // 第一遍：统计每个节点的度数
+    for (int i = 0; i < numConnections; i++)
+    {
+        offsets[connections[i].computerA + 1]++;
+        offsets[connections[i].computerB + 1]++;
+    }
+
+    // 前缀和，得到每一行的起始位置
+    for (int u = 0; u < numComputers; u++)
+    {
+        offsets[u + 1] += offsets[u];
+    }
+
+    // 第二遍：从每一行的末尾向前填充。
+    // 旧的链表实现是头插法，所以这样得到的行内顺序与其遍历顺序完全相同。
+    int *fill = (int *)malloc((numComputers + 1) * sizeof(int));
+    if (!fill)
     {
-        free(graph);
+        freeGraph(graph);
         return NULL;
     }
+    for (int u = 0; u < numComputers; u++)
+    {
+        fill[u] = offsets[u + 1];
+    }
 
     for (int i = 0; i < numConnections; i++)
     {
@@ -37,42 +90,438 @@ Graph *buildGraph(struct computer computers[], int numComputers,
         int dest = connections[i].computerB;
         int time = connections[i].transmissionTime;
 
-        Edge *newEdge = createEdge(dest, time);
-        if (newEdge)
+        int e = --fill[src];
+        graph->dest[e] = dest;
+        graph->transmissionTime[e] = time;
+
+        e = --fill[dest];
+        graph->dest[e] = src;
+        graph->transmissionTime[e] = time;
+    }
+
+    free(fill);
+    computeWeightStats(graph);
+    return graph;
+}
+
+// 按度数做一次计数排序，度数相同时原编号小的在前；descending为true时度数大的在前
+static bool degreeSort(const Graph *graph, bool descending, int out[])
+{
+    int n = graph->numComputers;
+    int maxDegree = 0;
+    for (int u = 0; u < n; u++)
+    {
+        int degree = graph->offsets[u + 1] - graph->offsets[u];
+        if (degree > maxDegree)
+            maxDegree = degree;
+    }
+
+    int *start = (int *)calloc(maxDegree + 2, sizeof(int));
+    if (!start)
+        return false;
+    for (int u = 0; u < n; u++)
+    {
+        int degree = graph->offsets[u + 1] - graph->offsets[u];
+        start[(descending ? maxDegree - degree : degree) + 1]++;
+    }
+    for (int d = 0; d <= maxDegree; d++)
+    {
+        start[d + 1] += start[d];
+    }
+    for (int u = 0; u < n; u++)
+    {
+        int degree = graph->offsets[u + 1] - graph->offsets[u];
+        out[start[descending ? maxDegree - degree : degree]++] = u;
+    }
+
+    free(start);
+    return true;
+}
+
+static int compareKeys(const void *a, const void *b)
+{
+    uint64_t x = *(const uint64_t *)a;
+    uint64_t y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+// BFS顺序：依次从starts[]中第一台尚未编号的计算机出发，直到全部编号，label[]本身就是BFS的队列。
+// sortNeighbors为true时(Cuthill–McKee)每台计算机的未编号邻居按(度数, 原编号)升序入队，否则按邻接行的顺序
+static bool bfsOrder(const Graph *graph, const int starts[], bool sortNeighbors, int label[])
+{
+    int n = graph->numComputers;
+    bool *visited = (bool *)calloc(n, sizeof(bool));
+    uint64_t *keys = NULL;
+    if (sortNeighbors)
+    {
+        int maxDegree = 0;
+        for (int u = 0; u < n; u++)
         {
-            newEdge->next = graph->array[src].headEdge;
-            graph->array[src].headEdge = newEdge;
+            int degree = graph->offsets[u + 1] - graph->offsets[u];
+            if (degree > maxDegree)
+                maxDegree = degree;
         }
+        keys = (uint64_t *)malloc((maxDegree + 1) * sizeof(uint64_t));
+    }
+    if (!visited || (sortNeighbors && !keys))
+    {
+        free(visited);
+        free(keys);
+        return false;
+    }
+
+    int tail = 0;
+    for (int i = 0; i < n; i++)
+    {
+        if (visited[starts[i]])
+            continue;
+        int head = tail;
+        label[tail++] = starts[i];
+        visited[starts[i]] = true;
 
-        newEdge = createEdge(src, time);
-        if (newEdge)
+        while (head < tail)
         {
-            newEdge->next = graph->array[dest].headEdge;
-            graph->array[dest].headEdge = newEdge;
+            int u = label[head++];
+            int k = 0;
+            for (int e = graph->offsets[u]; e < graph->offsets[u + 1]; e++)
+            {
+                int v = graph->dest[e];
+                if (visited[v])
+                    continue;
+                visited[v] = true;
+                if (sortNeighbors)
+                    keys[k++] = (uint64_t)(graph->offsets[v + 1] - graph->offsets[v]) << 32 | (uint32_t)v;
+                else
+                    label[tail++] = v;
+            }
+            if (sortNeighbors)
+            {
+                qsort(keys, k, sizeof(uint64_t), compareKeys);
+                for (int j = 0; j < k; j++)
+                {
+                    label[tail++] = (int)(uint32_t)keys[j];
+                }
+            }
         }
     }
 
-    return graph;
+    free(visited);
+    free(keys);
+    return true;
+}
+
+// 按order计算新编号到原编号的对应关系label[]
+static bool computeOrder(const Graph *graph, GraphOrder order, int label[])
+{
+    int n = graph->numComputers;
+    if (order == ORDER_DEGREE)
+        return degreeSort(graph, true, label);
+
+    int *starts = (int *)malloc((n + 1) * sizeof(int));
+    bool ok = starts && degreeSort(graph, order == ORDER_BFS, starts) &&
+              bfsOrder(graph, starts, order == ORDER_RCM, label);
+    free(starts);
+
+    if (ok && order == ORDER_RCM)
+    {
+        for (int i = 0, j = n - 1; i < j; i++, j--)
+        {
+            int temp = label[i];
+            label[i] = label[j];
+            label[j] = temp;
+        }
+    }
+    return ok;
+}
+
+Graph *buildGraphOrdered(struct computer computers[], int numComputers, struct connection connections[],
+                         int numConnections, GraphOrder order)
+{
+    Graph *graph = buildGraph(computers, numComputers, connections, numConnections);
+    if (!graph || order == ORDER_NONE)
+        return graph;
+
+    // 重排后的图连同label/position与计算机的属性放进同一个区域
+    int n = numComputers;
+    int numEdges = graph->numEdges;
+    size_t offsetsSize = (n + 1) * sizeof(int);
+    size_t edgeSize = (numEdges + 1) * sizeof(int);
+    size_t levelsSize = GRAPH_LEVELS_SIZE(n) + 1;
+    Arena *arena = createArena(sizeof(Graph) + 4 * offsetsSize + 2 * edgeSize + levelsSize +
+                               8 * alignof(max_align_t));
+    if (!arena)
+    {
+        freeGraph(graph);
+        return NULL;
+    }
+
+    Graph *ordered = (Graph *)arenaAlloc(arena, sizeof(Graph));
+    int *offsets = (int *)arenaAlloc(arena, offsetsSize);
+    int *dest = (int *)arenaAlloc(arena, edgeSize);
+    int *transmissionTime = (int *)arenaAlloc(arena, edgeSize);
+    int *label = (int *)arenaAlloc(arena, offsetsSize);
+    int *position = (int *)arenaAlloc(arena, offsetsSize);
+    int *poodleTime = (int *)arenaAlloc(arena, offsetsSize);
+    uint8_t *securityLevels = (uint8_t *)arenaAlloc(arena, levelsSize);
+    if (!ordered || !offsets || !dest || !transmissionTime || !label || !position || !poodleTime ||
+        !securityLevels || !computeOrder(graph, order, label))
+    {
+        freeArena(arena);
+        freeGraph(graph);
+        return NULL;
+    }
+
+    *ordered = *graph; // 边数与边权统计不变
+    ordered->offsets = offsets;
+    ordered->dest = dest;
+    ordered->transmissionTime = transmissionTime;
+    ordered->arena = arena;
+    ordered->label = label;
+    ordered->position = position;
+    ordered->poodleTime = poodleTime;
+    ordered->securityLevels = securityLevels;
+    fillAttributes(ordered, computers, label);
+
+    for (int v = 0; v < n; v++)
+    {
+        position[label[v]] = v;
+    }
+
+    // 新编号v的一行就是原计算机label[v]的一行，行内顺序不变，目标换成新编号
+    int pos = 0;
+    for (int v = 0; v < n; v++)
+    {
+        int u = label[v];
+        offsets[v] = pos;
+        for (int e = graph->offsets[u]; e < graph->offsets[u + 1]; e++)
+        {
+            dest[pos] = position[graph->dest[e]];
+            transmissionTime[pos] = graph->transmissionTime[e];
+            pos++;
+        }
+    }
+    offsets[n] = pos;
+
+    freeGraph(graph);
+    return ordered;
 }
 
 void freeGraph(Graph *graph)
 {
     if (graph)
     {
-        if (graph->array)
+        freeArena(graph->arena); // 结构体本身也在区域中
+    }
+}
+
+static int gcd(int a, int b)
+{
+    while (b != 0)
+    {
+        int r = a % b;
+        a = b;
+        b = r;
+    }
+    return a;
+}
+
+void computeWeightStats(Graph *graph)
+{
+    int minWeight = INT_MAX, maxWeight = 0, weightGcd = 0;
+    for (int e = 0; e < graph->numEdges; e++)
+    {
+        int weight = graph->transmissionTime[e] + graph->poodleTime[graph->dest[e]];
+        if (weight < minWeight)
+            minWeight = weight;
+        if (weight > maxWeight)
+            maxWeight = weight;
+        // 公约数一旦为1就不会再变
+        if (weightGcd != 1)
+            weightGcd = gcd(weight, weightGcd);
+    }
+    graph->minWeight = graph->numEdges > 0 ? minWeight : 0;
+    graph->maxWeight = maxWeight;
+    graph->weightGcd = weightGcd;
+}
+
+Graph *buildAttackGraph(const Graph *graph)
+{
+    int n = graph->numComputers;
+
+    // 两遍都要逐边比较两端的安全等级：先把4位的等级解包成每台一个字节，省掉每条边的移位与掩码
+    uint8_t *levels = (uint8_t *)malloc(n + 1);
+    if (!levels)
+        return NULL;
+    for (size_t i = 0; i < GRAPH_LEVELS_SIZE(n); i++)
+    {
+        levels[2 * i] = graph->securityLevels[i] & 0xF;
+        levels[2 * i + 1] = graph->securityLevels[i] >> 4;
+    }
+
+    // 第一遍：统计保留下来的边数，用于一次分配精确大小的区域
+    int numEdges = 0;
+    for (int u = 0; u < n; u++)
+    {
+        int level = levels[u] + 1;
+        for (int e = graph->offsets[u]; e < graph->offsets[u + 1]; e++)
         {
-            for (int i = 0; i < graph->numComputers; i++)
+            numEdges += level >= levels[graph->dest[e]];
+        }
+    }
+
+    size_t offsetsSize = (n + 1) * sizeof(int);
+    size_t edgeSize = (numEdges + 1) * sizeof(int);
+    Arena *arena = createArena(sizeof(Graph) + offsetsSize + 2 * edgeSize + 4 * alignof(max_align_t));
+    if (!arena)
+    {
+        free(levels);
+        return NULL;
+    }
+
+    Graph *attack = (Graph *)arenaAlloc(arena, sizeof(Graph));
+    int *offsets = (int *)arenaAlloc(arena, offsetsSize);
+    int *dest = (int *)arenaAlloc(arena, edgeSize);
+    int *transmissionTime = (int *)arenaAlloc(arena, edgeSize);
+    if (!attack || !offsets || !dest || !transmissionTime)
+    {
+        free(levels);
+        freeArena(arena);
+        return NULL;
+    }
+
+    attack->numComputers = n;
+    attack->numEdges = numEdges;
+    attack->offsets = offsets;
+    attack->dest = dest;
+    attack->transmissionTime = transmissionTime;
+    attack->arena = arena;
+    attack->label = graph->label;
+    attack->position = graph->position;
+    attack->poodleTime = graph->poodleTime;
+    attack->securityLevels = graph->securityLevels;
+
+    // 第二遍：按原来的行内顺序复制保留下来的边
+    int pos = 0;
+    for (int u = 0; u < n; u++)
+    {
+        offsets[u] = pos;
+        int level = levels[u] + 1;
+        for (int e = graph->offsets[u]; e < graph->offsets[u + 1]; e++)
+        {
+            int v = graph->dest[e];
+            if (level >= levels[v])
             {
-                Edge *current = graph->array[i].headEdge;
-                while (current)
-                {
-                    Edge *temp = current;
-                    current = current->next;
-                    free(temp);
-                }
+                dest[pos] = v;
+                transmissionTime[pos] = graph->transmissionTime[e];
+                pos++;
             }
-            free(graph->array);
         }
-        free(graph);
     }
-}
\ No newline at end of file
+    offsets[n] = pos;
+    free(levels);
+
+    computeWeightStats(attack);
+    return attack;
+}
+
+EdgeIndex *buildEdgeIndex(Graph *graph)
+{
+    int n = graph->numComputers;
+    int m = graph->numEdges;
+    EdgeIndex *index = (EdgeIndex *)malloc(sizeof(EdgeIndex));
+    int *byDest = (int *)malloc((m + 1) * sizeof(int)); // 按目标节点稳定排序后的边
+    int *src = (int *)malloc((m + 1) * sizeof(int));
+    int *count = (int *)calloc(n + 1, sizeof(int));
+    if (!index || !byDest || !src || !count)
+    {
+        free(index);
+        free(byDest);
+        free(src);
+        free(count);
+        return NULL;
+    }
+    index->dest = (int *)malloc((m + 1) * sizeof(int));
+    index->transmissionTime = (int *)malloc((m + 1) * sizeof(int));
+    if (!index->dest || !index->transmissionTime)
+    {
+        freeEdgeIndex(index);
+        free(byDest);
+        free(src);
+        free(count);
+        return NULL;
+    }
+
+    // 第一遍：按目标节点对所有边做稳定的计数排序
+    for (int u = 0; u < n; u++)
+    {
+        for (int e = graph->offsets[u]; e < graph->offsets[u + 1]; e++)
+        {
+            src[e] = u;
+            count[graph->dest[e] + 1]++;
+        }
+    }
+    for (int v = 0; v < n; v++)
+    {
+        count[v + 1] += count[v];
+    }
+    for (int e = 0; e < m; e++)
+    {
+        byDest[count[graph->dest[e]]++] = e;
+    }
+
+    // 第二遍：按目标节点的顺序把边放回各自的行，每一行因此按dest有序，
+    // 相同dest的边保持原来的行内顺序
+    for (int u = 0; u < n; u++)
+    {
+        count[u] = graph->offsets[u];
+    }
+    for (int i = 0; i < m; i++)
+    {
+        int e = byDest[i];
+        int pos = count[src[e]]++;
+        index->dest[pos] = graph->dest[e];
+        index->transmissionTime[pos] = graph->transmissionTime[e];
+    }
+
+    free(byDest);
+    free(src);
+    free(count);
+    return index;
+}
+
+void freeEdgeIndex(EdgeIndex *index)
+{
+    if (index)
+    {
+        free(index->dest);
+        free(index->transmissionTime);
+        free(index);
+    }
+}
+
+// 行长度不超过该值时直接线性扫描，比二分查找更快
+#define LINEAR_SEARCH_LIMIT 16
+
+int edgeIndexFind(Graph *graph, EdgeIndex *index, int src, int dest)
+{
+    int lo = graph->offsets[src];
+    int hi = graph->offsets[src + 1];
+
+    // 二分查找第一个dest不小于目标的位置
+    while (hi - lo > LINEAR_SEARCH_LIMIT)
+    {
+        int mid = lo + (hi - lo) / 2;
+        if (index->dest[mid] < dest)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+
+    int end = graph->offsets[src + 1];
+    for (int e = lo; e < end && index->dest[e] <= dest; e++)
+    {
+        if (index->dest[e] == dest)
+            return index->transmissionTime[e];
+    }
+    return -1;
+}
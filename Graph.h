@@ -2,38 +2,104 @@
 #define GRAPH_H
 
 #include <stdbool.h>
+#include <stdint.h>
+#include "Arena.h"
 #include "poodle.h"
 
-// 边链表
-typedef struct Edge
-{
-    int dest;             // 这条边所连接的点的索引
-    int transmissionTime; // 传输时间(即边的权重)
-    struct Edge *next;    // 指向下一条边的指针
-} Edge;
-
-// 邻接表(一个存储节点信息和链表的数组)
-typedef struct AdjList
-{
-    struct computer computer; // 存储该节点的计算机信息
-    Edge *headEdge;           // 指向边链表的指针
-} AdjList;
-
-// 图
+// 压缩稀疏行(CSR)图
+// 节点u的所有边存放在下标区间 [offsets[u], offsets[u + 1]) 中,
+// dest与transmissionTime是两个紧凑排列的并行数组。
+// 每条连接(无向)会在两个端点处各存一条有向边。
 typedef struct Graph
 {
     int numComputers;
-    AdjList *array; // 数组
-    struct computer *computers;
+    int numEdges;               // 有向边总数(= 2 * numConnections)
+    int *offsets;               // 长度为numComputers + 1的行偏移数组
+    int *dest;                  // 每条边所连接的点的索引
+    int *transmissionTime;      // 每条边的传输时间(即边的权重)
+    Arena *arena;               // buildGraph分配的全部内存(含结构体本身)；不归Graph所有时为NULL
+
+    // 重排(见buildGraphOrdered)：图中的计算机v是调用者的计算机label[v]，
+    // 调用者的计算机c在图中的编号为position[c]。没有重排时两者都为NULL，编号相同
+    int *label;
+    int *position;
+
+    // 计算机的属性按属性分开连续存放(而不是struct computer的数组)，建图时从调用者的computers[]拷贝，
+    // 之后不再读取调用者的数组。松弛一条边只读目标的poodleTime，每台计算机4字节而不是8字节；
+    // 安全等级不超过MAX_SECURITY_LEVEL，两台计算机共用一个字节，用GRAPH_LEVEL读取。
+    // 每百万台计算机共4.5MB(struct computer数组为8MB)
+    int *poodleTime;
+    uint8_t *securityLevels; // 编号为v的计算机在第v / 2个字节中，v为偶数时在低4位
+
+    // 边权(传输时间 + 目标的poodleTime，即沿这条边入侵的代价)的统计，没有边时全为0。
+    // 引擎据此判断是否可以用桶代替优先队列(见BucketSearch.h)
+    int minWeight;
+    int maxWeight;
+    int weightGcd; // 全部边权的最大公约数
 } Graph;
 
-// 创建边
-Edge *createEdge(int dest, int transmissionTime);
+// 遍历节点u的所有边: for (int e = graph->offsets[u]; e < graph->offsets[u + 1]; e++)
+
+// 图中的编号与调用者的编号互相转换。平局按编号决定先后的地方(出队顺序、入侵者的选择、结果的排序)
+// 都比较调用者的编号，所以重排之后结果与不重排时完全相同
+#define GRAPH_LABEL(graph, v) ((graph)->label ? (graph)->label[v] : (v))
+#define GRAPH_POSITION(graph, c) ((graph)->position ? (graph)->position[c] : (c))
+
+// 计算机v的安全等级
+#define GRAPH_LEVEL(graph, v) (((graph)->securityLevels[(v) >> 1] >> (((v) & 1) << 2)) & 0xF)
+
+// numComputers台计算机的securityLevels所占的字节数
+#define GRAPH_LEVELS_SIZE(numComputers) (((size_t)(numComputers) + 1) / 2)
 
-// 构建邻接表图
+// 构建CSR图
+// 先对connections[]做一次计数,得到每个节点的度数,再按前缀和填充边数组。
+// 每一行内边的顺序与旧的链表实现一致(即连接输入顺序的逆序)。
 Graph *buildGraph(struct computer computers[], int numComputers, struct connection connections[], int numConnections);
 
-// 释放图的内存
+// 计算机的重排方式。输入中的编号通常来自资产清单，相邻的计算机在time[]、parent[]、poodleTime[]中
+// 相隔很远，几乎每次松弛都是一次缓存缺失；重排后相邻的计算机编号接近。平局一律按原编号决定。
+typedef enum GraphOrder
+{
+    ORDER_NONE,   // 保持原编号
+    ORDER_BFS,    // 从度数最大的计算机(hub)出发的BFS顺序，邻居按邻接行的顺序；每个连通分量依次处理
+    ORDER_RCM,    // 反向Cuthill–McKee：从度数最小的计算机出发BFS，邻居按度数升序加入，最后整体反转
+    ORDER_DEGREE, // 按度数降序，度数相同时原编号小的在前
+} GraphOrder;
+
+// 与buildGraph相同，但按order重排计算机：图中的编号为新编号，label/position记录对应关系，
+// poodleTime与securityLevels也按新编号存放。每一行内边的顺序与buildGraph相同。
+// order为ORDER_NONE时就是buildGraph。内存不足时返回NULL。
+Graph *buildGraphOrdered(struct computer computers[], int numComputers, struct connection connections[],
+                         int numConnections, GraphOrder order);
+
+// 释放buildGraph构建的图(NULL安全)
 void freeGraph(Graph *graph);
 
-#endif // GRAPH_H
\ No newline at end of file
+// 扫描一遍边，填写minWeight、maxWeight与weightGcd。
+// buildGraph与buildAttackGraph构建时已经调用，快照把结果保存在文件头中
+void computeWeightStats(Graph *graph);
+
+// 攻击图：只保留安全等级允许的有向边u -> v(level(u) + 1 >= level(v))的CSR，格式与Graph相同，
+// 每一行内边的顺序与原图相同，计算机的属性与label/position与原图共用(原图必须比攻击图活得更久)。
+// 安全等级固定的遍历(poodle、chooseSource等)在攻击图上进行，不再逐边读取两端的安全等级，也不会扫描到被权限拒绝的边。
+// 反向的遍历(查找v的入侵者)仍然使用原图。numEdges为保留下来的边数；内存不足时返回NULL，用freeGraph释放。
+Graph *buildAttackGraph(const Graph *graph);
+
+// 边索引：每一行按目标节点排序后的(dest, transmissionTime)副本，用于O(log d)地查找连接。
+// 同一行中指向同一节点的重复连接保持原来的行内顺序，所以查到的总是按行顺序遍历时
+// 第一个遇到的那一条，与线性扫描的结果一致。行偏移与Graph的offsets相同。
+typedef struct EdgeIndex
+{
+    int *dest;
+    int *transmissionTime;
+} EdgeIndex;
+
+// 用两遍计数排序在O(V + E)内构建边索引；内存不足时返回NULL
+EdgeIndex *buildEdgeIndex(Graph *graph);
+
+void freeEdgeIndex(EdgeIndex *index);
+
+// 返回src到dest的连接的传输时间，不存在时返回-1
+int edgeIndexFind(Graph *graph, EdgeIndex *index, int src, int dest);
+
+#endif // GRAPH_H
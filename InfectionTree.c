@@ -0,0 +1,165 @@
+#include "InfectionTree.h"
+#include "Arena.h"
+#include <limits.h>
+#include <stdalign.h>
+#include <stddef.h>
+#include <stdlib.h>
+
+struct InfectionTree
+{
+    Arena *arena; // 结构体与全部数组都从这个区域中分配
+    int numComputers;
+    int numInfected;
+    int *rank; // rank[v]为v的入侵顺序，无法入侵为-1
+
+    // 以下按秩索引，长度为numInfected
+    int *computer;
+    int *time;
+    int *parentRank; // 源为-1
+    int *depth;
+    int *subtreeSize;
+};
+
+InfectionTree *buildInfectionTree(const int time[], const int parent[], const int order[],
+                                  int numComputers, int stepcount)
+{
+    // 按精确的总大小创建区域，全部分配落在同一块内存中(每次分配最多多出一个对齐单位)
+    size_t size = sizeof(InfectionTree) + (numComputers + 5 * (size_t)stepcount) * sizeof(int) +
+                  7 * alignof(max_align_t);
+    Arena *arena = createArena(size);
+    if (!arena)
+        return NULL;
+
+    InfectionTree *tree = (InfectionTree *)arenaAlloc(arena, sizeof(InfectionTree));
+    if (!tree)
+    {
+        freeArena(arena);
+        return NULL;
+    }
+    tree->arena = arena;
+    tree->numComputers = numComputers;
+    tree->numInfected = stepcount;
+    tree->rank = (int *)arenaAlloc(arena, numComputers * sizeof(int));
+    tree->computer = (int *)arenaAlloc(arena, stepcount * sizeof(int));
+    tree->time = (int *)arenaAlloc(arena, stepcount * sizeof(int));
+    tree->parentRank = (int *)arenaAlloc(arena, stepcount * sizeof(int));
+    tree->depth = (int *)arenaAlloc(arena, stepcount * sizeof(int));
+    tree->subtreeSize = (int *)arenaAlloc(arena, stepcount * sizeof(int));
+    if (!tree->rank || !tree->computer || !tree->time || !tree->parentRank || !tree->depth || !tree->subtreeSize)
+    {
+        freeArena(arena);
+        return NULL;
+    }
+
+    for (int v = 0; v < numComputers; v++)
+    {
+        tree->rank[v] = -1;
+    }
+    for (int i = 0; i < stepcount; i++)
+    {
+        tree->rank[order[i]] = i;
+    }
+
+    // 入侵者排在接收者之前，所以按秩顺序一遍就能得到深度
+    for (int i = 0; i < stepcount; i++)
+    {
+        int v = order[i];
+        int p = i == 0 ? -1 : tree->rank[parent[v]];
+        tree->computer[i] = v;
+        tree->time[i] = time[v];
+        tree->parentRank[i] = p;
+        tree->depth[i] = p == -1 ? 0 : tree->depth[p] + 1;
+        tree->subtreeSize[i] = 1;
+    }
+
+    // 逆序把子树大小累加到入侵者上
+    for (int i = stepcount - 1; i > 0; i--)
+    {
+        tree->subtreeSize[tree->parentRank[i]] += tree->subtreeSize[i];
+    }
+
+    return tree;
+}
+
+void freeInfectionTree(InfectionTree *tree)
+{
+    if (tree)
+        freeArena(tree->arena);
+}
+
+int infectionTreeSource(const InfectionTree *tree)
+{
+    return tree->numInfected > 0 ? tree->computer[0] : -1;
+}
+
+int infectionTreeNumInfected(const InfectionTree *tree)
+{
+    return tree->numInfected;
+}
+
+int infectionTreeTime(const InfectionTree *tree, int computer)
+{
+    int r = tree->rank[computer];
+    return r == -1 ? INT_MAX : tree->time[r];
+}
+
+int infectionTreeParent(const InfectionTree *tree, int computer)
+{
+    int r = tree->rank[computer];
+    return r == -1 || tree->parentRank[r] == -1 ? -1 : tree->computer[tree->parentRank[r]];
+}
+
+int infectionTreeDepth(const InfectionTree *tree, int computer)
+{
+    int r = tree->rank[computer];
+    return r == -1 ? -1 : tree->depth[r];
+}
+
+int infectionTreeSubtreeSize(const InfectionTree *tree, int computer)
+{
+    int r = tree->rank[computer];
+    return r == -1 ? 0 : tree->subtreeSize[r];
+}
+
+// 从秩r沿入侵者回溯到源，把路径从后往前写入path[0..depth]
+static void writePath(const InfectionTree *tree, int r, int path[])
+{
+    for (int i = tree->depth[r]; i >= 0; i--)
+    {
+        path[i] = tree->computer[r];
+        r = tree->parentRank[r];
+    }
+}
+
+int infectionTreePathTo(const InfectionTree *tree, int computer, int path[])
+{
+    int r = tree->rank[computer];
+    if (r == -1)
+        return 0;
+
+    writePath(tree, r, path);
+    return tree->depth[r] + 1;
+}
+
+int *infectionTreePaths(const InfectionTree *tree, const int targets[], int numTargets, int pathOffsets[])
+{
+    // 路径长度就是深度 + 1，先算出全部偏移，再把每条路径直接写到它的位置上
+    pathOffsets[0] = 0;
+    for (int t = 0; t < numTargets; t++)
+    {
+        int r = tree->rank[targets[t]];
+        pathOffsets[t + 1] = pathOffsets[t] + (r == -1 ? 0 : tree->depth[r] + 1);
+    }
+
+    int *pathNodes = (int *)malloc((pathOffsets[numTargets] + 1) * sizeof(int));
+    if (!pathNodes)
+        return NULL;
+
+    for (int t = 0; t < numTargets; t++)
+    {
+        int r = tree->rank[targets[t]];
+        if (r != -1)
+            writePath(tree, r, pathNodes + pathOffsets[t]);
+    }
+    return pathNodes;
+}
@@ -0,0 +1,49 @@
+#ifndef INFECTION_TREE_H
+#define INFECTION_TREE_H
+
+// 入侵树：poodle(Task 3)搜索得到的最短入侵树的紧凑形式
+//
+// 被入侵的k台计算机按入侵顺序编号(秩)，按秩连续保存计算机、时间、入侵者的秩、深度与子树大小，
+// 另有一个按计算机编号索引的秩数组，全部数组在同一块内存中。构建代价为O(V)，之后不需要重新搜索：
+// - 从源到任意计算机的入侵路径，代价O(深度)；
+// - 子树大小(经由这台计算机入侵的计算机数量，含自身)，代价O(1)；
+// - 多个目标的路径一次写出，代价与路径的总长度成正比。
+typedef struct InfectionTree InfectionTree;
+
+// 由一次搜索的结果构建入侵树，numComputers为计算机数量。
+// order[]为按入侵先后排列的stepcount台计算机(order[0]为源)，parent[v]为入侵v的计算机，
+// 入侵者必须排在接收者之前；只读取order[]中的计算机的time[]与parent[]。内存不足时返回NULL。
+InfectionTree *buildInfectionTree(const int time[], const int parent[], const int order[],
+                                  int numComputers, int stepcount);
+
+// 释放入侵树(NULL安全)
+void freeInfectionTree(InfectionTree *tree);
+
+// 源，没有任何计算机被入侵时为-1
+int infectionTreeSource(const InfectionTree *tree);
+
+int infectionTreeNumInfected(const InfectionTree *tree);
+
+// computer最早被入侵的时间，无法入侵为INT_MAX
+int infectionTreeTime(const InfectionTree *tree, int computer);
+
+// 入侵computer的计算机，源与无法入侵的为-1
+int infectionTreeParent(const InfectionTree *tree, int computer);
+
+// 从源到computer的路径上的连接数量，源为0，无法入侵为-1
+int infectionTreeDepth(const InfectionTree *tree, int computer);
+
+// 以computer为根的子树中的计算机数量(含自身)，无法入侵为0
+int infectionTreeSubtreeSize(const InfectionTree *tree, int computer);
+
+// 把从源到computer的入侵路径写入path[](长度至少为深度 + 1)，返回路径上的计算机数量，
+// 无法入侵时返回0
+int infectionTreePathTo(const InfectionTree *tree, int computer, int path[]);
+
+// 批量取得numTargets个目标的路径：第t条路径为pathNodes[pathOffsets[t]]到pathNodes[pathOffsets[t + 1] - 1]
+// (与networkProbePathBatch的输入格式相同)，无法入侵的目标路径为空。
+// pathOffsets[]由调用者提供，长度为numTargets + 1；返回的pathNodes由调用者用free释放。
+// 内存不足时返回NULL。
+int *infectionTreePaths(const InfectionTree *tree, const int targets[], int numTargets, int pathOffsets[]);
+
+#endif // INFECTION_TREE_H
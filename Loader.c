@@ -0,0 +1,387 @@
+#include "Loader.h"
+#include <fcntl.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+const char *loadStatusMessage(LoadStatus status)
+{
+    switch (status)
+    {
+    case LOAD_OK:
+        return "ok";
+    case LOAD_IO_ERROR:
+        return "cannot read or write file";
+    case LOAD_FORMAT_ERROR:
+        return "malformed network file";
+    case LOAD_INVALID_VALUE:
+        return "invalid value in network file";
+    case LOAD_BAD_SNAPSHOT:
+        return "not a valid snapshot (wrong magic, version, byte order or size)";
+    case LOAD_OUT_OF_MEMORY:
+        return "out of memory";
+    }
+    return "unknown error";
+}
+
+// 只读映射整个文件；空文件返回NULL且*size为0
+static const char *mapFile(const char *filename, size_t *size, LoadStatus *status)
+{
+    *size = 0;
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0)
+    {
+        *status = LOAD_IO_ERROR;
+        return NULL;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0)
+    {
+        close(fd);
+        *status = LOAD_IO_ERROR;
+        return NULL;
+    }
+    *size = (size_t)st.st_size;
+    if (*size == 0)
+    {
+        close(fd);
+        *status = LOAD_OK;
+        return NULL;
+    }
+
+    void *data = mmap(NULL, *size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd); // 映射建立后即可关闭文件描述符
+    if (data == MAP_FAILED)
+    {
+        *status = LOAD_IO_ERROR;
+        return NULL;
+    }
+    *status = LOAD_OK;
+    return (const char *)data;
+}
+
+////////////////////////////////////////////////////////////////////////
+// 文本格式
+
+// 文本解析的游标
+typedef struct Cursor
+{
+    const char *p;
+    const char *end;
+} Cursor;
+
+static inline bool isSpace(char c)
+{
+    return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+
+// 读一个十进制整数(与fscanf的%d一样允许前导空白与正负号)，溢出int或没有数字时返回false
+static inline bool nextInt(Cursor *cur, int *out)
+{
+    const char *p = cur->p;
+    const char *end = cur->end;
+    while (p < end && isSpace(*p))
+        p++;
+
+    bool negative = false;
+    if (p < end && (*p == '-' || *p == '+'))
+    {
+        negative = *p == '-';
+        p++;
+    }
+    if (p == end || *p < '0' || *p > '9')
+        return false;
+
+    long long value = 0;
+    while (p < end && *p >= '0' && *p <= '9')
+    {
+        value = value * 10 + (*p - '0');
+        if (value > (long long)INT_MAX + 1)
+            return false;
+        p++;
+    }
+    if (negative)
+        value = -value;
+    if (value > INT_MAX || value < INT_MIN)
+        return false;
+
+    cur->p = p;
+    *out = (int)value;
+    return true;
+}
+
+static LoadStatus parseNetwork(Cursor *cur, NetworkData *out)
+{
+    int n, m;
+    if (!nextInt(cur, &n) || !nextInt(cur, &m))
+        return LOAD_FORMAT_ERROR;
+    if (n <= 0 || m < 0)
+        return LOAD_INVALID_VALUE;
+
+    out->computers = (struct computer *)malloc(n * sizeof(struct computer));
+    out->connections = (struct connection *)malloc((m + 1) * sizeof(struct connection));
+    if (!out->computers || !out->connections)
+        return LOAD_OUT_OF_MEMORY;
+
+    for (int i = 0; i < n; i++)
+    {
+        int securityLevel, poodleTime;
+        if (!nextInt(cur, &securityLevel) || !nextInt(cur, &poodleTime))
+            return LOAD_FORMAT_ERROR;
+        if (securityLevel < 1 || securityLevel > MAX_SECURITY_LEVEL || poodleTime <= 0)
+            return LOAD_INVALID_VALUE;
+        out->computers[i] = (struct computer){securityLevel, poodleTime};
+    }
+
+    for (int i = 0; i < m; i++)
+    {
+        int a, b, time;
+        if (!nextInt(cur, &a) || !nextInt(cur, &b) || !nextInt(cur, &time))
+            return LOAD_FORMAT_ERROR;
+        if (a < 0 || a >= n || b < 0 || b >= n || a == b || time <= 0)
+            return LOAD_INVALID_VALUE;
+        out->connections[i] = (struct connection){a, b, time};
+    }
+
+    out->numComputers = n;
+    out->numConnections = m;
+    return LOAD_OK;
+}
+
+LoadStatus loadNetworkText(const char *filename, NetworkData *out)
+{
+    memset(out, 0, sizeof(*out));
+
+    size_t size;
+    LoadStatus status;
+    const char *text = mapFile(filename, &size, &status);
+    if (status != LOAD_OK)
+        return status;
+    if (!text)
+        return LOAD_FORMAT_ERROR; // 空文件
+
+    // 提示内核顺序读取，预读更积极
+    madvise((void *)text, size, MADV_SEQUENTIAL);
+
+    Cursor cur = {text, text + size};
+    status = parseNetwork(&cur, out);
+    munmap((void *)text, size);
+
+    if (status != LOAD_OK)
+    {
+        freeNetworkData(out);
+    }
+    return status;
+}
+
+void freeNetworkData(NetworkData *data)
+{
+    free(data->computers);
+    free(data->connections);
+    memset(data, 0, sizeof(*data));
+}
+
+////////////////////////////////////////////////////////////////////////
+// 二进制快照
+
+struct Snapshot
+{
+    const char *data;
+    size_t size;
+    Graph graph; // 数组指向data中的各段
+};
+
+static uint64_t alignUp(uint64_t x)
+{
+    return (x + SNAPSHOT_ALIGN - 1) / SNAPSHOT_ALIGN * SNAPSHOT_ALIGN;
+}
+
+// 按计算机与边的数量计算各段的位置
+static void layoutSnapshot(SnapshotHeader *header, int numComputers, int numEdges)
+{
+    memset(header, 0, sizeof(*header));
+    memcpy(header->magic, SNAPSHOT_MAGIC, sizeof(header->magic));
+    header->version = SNAPSHOT_VERSION;
+    header->byteOrder = SNAPSHOT_BYTE_ORDER;
+    header->numComputers = numComputers;
+    header->numEdges = numEdges;
+    header->offsetsStart = alignUp(sizeof(SnapshotHeader));
+    header->destStart = alignUp(header->offsetsStart + (uint64_t)(numComputers + 1) * sizeof(int32_t));
+    header->transmissionTimeStart = alignUp(header->destStart + (uint64_t)numEdges * sizeof(int32_t));
+    header->poodleTimeStart = alignUp(header->transmissionTimeStart + (uint64_t)numEdges * sizeof(int32_t));
+    header->securityLevelsStart = alignUp(header->poodleTimeStart + (uint64_t)numComputers * sizeof(int32_t));
+    header->fileSize = header->securityLevelsStart + GRAPH_LEVELS_SIZE(numComputers);
+}
+
+// 写入一段数据，并在前面补零使其从start开始
+static bool writeSection(FILE *fp, uint64_t *position, uint64_t start, const void *data, size_t size)
+{
+    static const char zeros[SNAPSHOT_ALIGN] = {0};
+    while (*position < start)
+    {
+        size_t pad = start - *position < SNAPSHOT_ALIGN ? (size_t)(start - *position) : SNAPSHOT_ALIGN;
+        if (fwrite(zeros, 1, pad, fp) != pad)
+            return false;
+        *position += pad;
+    }
+    if (size > 0 && fwrite(data, 1, size, fp) != size)
+        return false;
+    *position += size;
+    return true;
+}
+
+LoadStatus writeSnapshot(const char *filename, Graph *graph)
+{
+    if (graph->label)
+        return LOAD_INVALID_VALUE; // 快照不保存重排的对应关系
+    SnapshotHeader header;
+    layoutSnapshot(&header, graph->numComputers, graph->numEdges);
+    header.minWeight = graph->minWeight;
+    header.maxWeight = graph->maxWeight;
+    header.weightGcd = graph->weightGcd;
+
+    FILE *fp = fopen(filename, "wb");
+    if (!fp)
+        return LOAD_IO_ERROR;
+
+    uint64_t position = 0;
+    bool ok = writeSection(fp, &position, 0, &header, sizeof(header)) &&
+              writeSection(fp, &position, header.offsetsStart, graph->offsets,
+                           (graph->numComputers + 1) * sizeof(int32_t)) &&
+              writeSection(fp, &position, header.destStart, graph->dest,
+                           graph->numEdges * sizeof(int32_t)) &&
+              writeSection(fp, &position, header.transmissionTimeStart, graph->transmissionTime,
+                           graph->numEdges * sizeof(int32_t)) &&
+              writeSection(fp, &position, header.poodleTimeStart, graph->poodleTime,
+                           graph->numComputers * sizeof(int32_t)) &&
+              writeSection(fp, &position, header.securityLevelsStart, graph->securityLevels,
+                           GRAPH_LEVELS_SIZE(graph->numComputers));
+
+    if (fclose(fp) != 0)
+        ok = false;
+    return ok ? LOAD_OK : LOAD_IO_ERROR;
+}
+
+// 检查文件头：魔数、版本、字节序，以及各段是否与按计数重新计算的布局一致
+static bool validHeader(const SnapshotHeader *header, size_t size)
+{
+    if (size < sizeof(SnapshotHeader) || memcmp(header->magic, SNAPSHOT_MAGIC, sizeof(header->magic)) != 0 ||
+        header->version != SNAPSHOT_VERSION || header->byteOrder != SNAPSHOT_BYTE_ORDER ||
+        header->numComputers <= 0 || header->numEdges < 0)
+        return false;
+
+    // 边权统计至少要能安全地使用(桶引擎会除以weightGcd)，是否与边一致由validGraph检查
+    if (header->numEdges == 0 ? header->minWeight != 0 || header->maxWeight != 0 || header->weightGcd != 0
+                              : header->minWeight <= 0 || header->weightGcd <= 0 ||
+                                    header->minWeight > header->maxWeight)
+        return false;
+
+    SnapshotHeader expected;
+    layoutSnapshot(&expected, header->numComputers, header->numEdges);
+    return header->offsetsStart == expected.offsetsStart && header->destStart == expected.destStart &&
+           header->transmissionTimeStart == expected.transmissionTimeStart &&
+           header->poodleTimeStart == expected.poodleTimeStart &&
+           header->securityLevelsStart == expected.securityLevelsStart && header->fileSize == expected.fileSize &&
+           header->fileSize == size;
+}
+
+// 完整检查图的内容，包括文件头中的边权统计
+static bool validGraph(const Graph *graph)
+{
+    int n = graph->numComputers;
+    if (graph->offsets[0] != 0 || graph->offsets[n] != graph->numEdges)
+        return false;
+    for (int u = 0; u < n; u++)
+    {
+        if (graph->offsets[u] > graph->offsets[u + 1])
+            return false;
+        int level = GRAPH_LEVEL(graph, u);
+        if (level < 1 || level > MAX_SECURITY_LEVEL || graph->poodleTime[u] <= 0)
+            return false;
+        for (int e = graph->offsets[u]; e < graph->offsets[u + 1]; e++)
+        {
+            int v = graph->dest[e];
+            if (v < 0 || v >= n || v == u || graph->transmissionTime[e] <= 0)
+                return false;
+        }
+    }
+
+    // 边都合法之后才能按dest读取poodleTime
+    Graph expected = *graph;
+    computeWeightStats(&expected);
+    return expected.minWeight == graph->minWeight && expected.maxWeight == graph->maxWeight &&
+           expected.weightGcd == graph->weightGcd;
+}
+
+LoadStatus mapSnapshot(const char *filename, bool verify, Snapshot **out)
+{
+    *out = NULL;
+
+    size_t size;
+    LoadStatus status;
+    const char *data = mapFile(filename, &size, &status);
+    if (status != LOAD_OK)
+        return status;
+    if (!data)
+        return LOAD_BAD_SNAPSHOT;
+
+    const SnapshotHeader *header = (const SnapshotHeader *)data;
+    if (!validHeader(header, size))
+    {
+        munmap((void *)data, size);
+        return LOAD_BAD_SNAPSHOT;
+    }
+
+    Snapshot *snapshot = (Snapshot *)malloc(sizeof(Snapshot));
+    if (!snapshot)
+    {
+        munmap((void *)data, size);
+        return LOAD_OUT_OF_MEMORY;
+    }
+    snapshot->data = data;
+    snapshot->size = size;
+
+    // 图的数组直接指向映射区，映射是只读的，图在构建之后也从不被修改
+    Graph *graph = &snapshot->graph;
+    graph->numComputers = header->numComputers;
+    graph->numEdges = header->numEdges;
+    graph->offsets = (int *)(data + header->offsetsStart);
+    graph->dest = (int *)(data + header->destStart);
+    graph->transmissionTime = (int *)(data + header->transmissionTimeStart);
+    graph->arena = NULL;
+    graph->label = NULL;
+    graph->position = NULL;
+    graph->poodleTime = (int *)(data + header->poodleTimeStart);
+    graph->securityLevels = (uint8_t *)(data + header->securityLevelsStart);
+    graph->minWeight = header->minWeight;
+    graph->maxWeight = header->maxWeight;
+    graph->weightGcd = header->weightGcd;
+
+    if (verify && !validGraph(graph))
+    {
+        unmapSnapshot(snapshot);
+        return LOAD_BAD_SNAPSHOT;
+    }
+
+    *out = snapshot;
+    return LOAD_OK;
+}
+
+Graph *snapshotGraph(Snapshot *snapshot)
+{
+    return &snapshot->graph;
+}
+
+void unmapSnapshot(Snapshot *snapshot)
+{
+    if (snapshot)
+    {
+        munmap((void *)snapshot->data, snapshot->size);
+        free(snapshot);
+    }
+}
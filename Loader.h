@@ -0,0 +1,92 @@
+#ifndef LOADER_H
+#define LOADER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "Graph.h"
+#include "poodle.h"
+
+// 网络加载器
+// 1. 文本格式(data/目录下的格式)：用mmap把整个文件映射进来一次性解析，
+//    校验规则与testPoodle.c中的readNetworkFile相同。
+// 2. 二进制快照：直接保存构建好的CSR图，加载时mmap文件，图的数组直接指向映射区，不做任何拷贝。
+
+typedef enum LoadStatus
+{
+    LOAD_OK,
+    LOAD_IO_ERROR,       // 无法打开、读取、写入或映射文件
+    LOAD_FORMAT_ERROR,   // 缺少数字或数字格式错误
+    LOAD_INVALID_VALUE,  // 数值不满足约束(等级越界、时间非正、自环、计算机编号越界等)
+    LOAD_BAD_SNAPSHOT,   // 快照的魔数、版本、字节序或各段大小不正确
+    LOAD_OUT_OF_MEMORY,
+} LoadStatus;
+
+const char *loadStatusMessage(LoadStatus status);
+
+// 从文本文件读出的网络，数组由loadNetworkText分配
+typedef struct NetworkData
+{
+    int numComputers;
+    struct computer *computers;
+    int numConnections;
+    struct connection *connections;
+} NetworkData;
+
+// 解析文本格式的网络文件。失败时*out被清空，不需要释放
+LoadStatus loadNetworkText(const char *filename, NetworkData *out);
+
+void freeNetworkData(NetworkData *data);
+
+////////////////////////////////////////////////////////////////////////
+// 二进制快照
+//
+// 文件布局(所有整数为写入机器的本地字节序，各段按SNAPSHOT_ALIGN对齐)：
+//   SnapshotHeader
+//   offsets[numComputers + 1]      int32
+//   dest[numEdges]                 int32
+//   transmissionTime[numEdges]     int32
+//   poodleTime[numComputers]       int32
+//   securityLevels[(numComputers + 1) / 2]  uint8，每个字节两台计算机(见Graph.h)
+// 格式变化时增加SNAPSHOT_VERSION，旧版本的快照会被拒绝(需要重新转换)。
+
+#define SNAPSHOT_MAGIC "POODLECS"
+#define SNAPSHOT_VERSION 3
+#define SNAPSHOT_BYTE_ORDER 0x01020304u
+#define SNAPSHOT_ALIGN 64
+
+typedef struct SnapshotHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t byteOrder; // 写入时为SNAPSHOT_BYTE_ORDER，读入时不相等说明字节序不同
+    int32_t numComputers;
+    int32_t numEdges;
+    uint64_t offsetsStart; // 各段在文件中的字节偏移
+    uint64_t destStart;
+    uint64_t transmissionTimeStart;
+    uint64_t poodleTimeStart;
+    uint64_t securityLevelsStart;
+    uint64_t fileSize;
+    int32_t minWeight; // 边权的统计(见Graph.h)，映射时直接使用，不必扫描全部边
+    int32_t maxWeight;
+    int32_t weightGcd;
+    int32_t reserved; // 补齐到8字节，写入时为0
+} SnapshotHeader;
+
+// 把图(包括计算机的属性)写成快照。快照不保存重排的对应关系，重排过的图(见buildGraphOrdered)
+// 返回LOAD_INVALID_VALUE
+LoadStatus writeSnapshot(const char *filename, Graph *graph);
+
+typedef struct Snapshot Snapshot;
+
+// 映射快照。verify为true时还会检查每一行的偏移与每条边的内容，以及文件头中的边权统计
+// (O(V + E)，会读入整个文件)；为false时只检查文件头与各段大小，不读取各段的内容，适合可信的快照。
+LoadStatus mapSnapshot(const char *filename, bool verify, Snapshot **out);
+
+// 快照中的图，数组都指向映射区(只读)，在unmapSnapshot之前有效。不要对它调用freeGraph
+Graph *snapshotGraph(Snapshot *snapshot);
+
+void unmapSnapshot(Snapshot *snapshot);
+
+#endif // LOADER_H
@@ -0,0 +1,1993 @@
+#include "Network.h"
+#include "BucketSearch.h"
+#include "DeltaStepping.h"
+#include "DenseSearch.h"
+#include "Graph.h"
+#include "InfectionTree.h"
+#include "Loader.h"
+#include "PQueue.h"
+#include "QueryStats.h"
+#include "Reach.h"
+#include "ThreadPool.h"
+#include <assert.h>
+#include <limits.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "poodle.h"
+
+// probePath使用的访问标记：stamp[v] == epoch 表示本次查询中v已被访问。
+// 每次查询只需将epoch加一，无需O(V)地清空数组。
+typedef struct VisitMarks
+{
+	int *stamp;
+	int epoch;
+} VisitMarks;
+
+// 全源扫描中一个工作者的临时缓冲区。time[]在两次搜索之间保持全为INT_MAX，
+// 每次搜索后只按order[]恢复被入侵的计算机，所以到达范围小的源不需要O(V)的清空。
+typedef struct SweepScratch
+{
+	int *time;
+	int *order;
+	PQueue *queue;
+	bool failed; // 本次扫描中队列内存不足
+} SweepScratch;
+
+// 提前终止的poodle查询使用的缓冲区，第一次使用时创建。time[]在两次查询之间保持全为INT_MAX、
+// parent[]全为-1，每次查询后只恢复被访问过的计算机，所以一次查询的代价与它访问的范围成正比。
+typedef struct PrefixScratch
+{
+	int *time;
+	int *parent;
+	int *order;
+} PrefixScratch;
+
+// advancedPoodle使用的缓冲区，第一次使用时创建。stateTime[]在两次查询之间保持全为INT_MAX、
+// settledLevel[]全为0，同样只恢复被访问过的部分。
+typedef struct StateScratch
+{
+	int *stateTime;
+	char *settledLevel; // 每台计算机已出队的最高等级，0表示未入侵
+	int *order;
+	int *orderTime; // orderTime[i]为order[i]的最早入侵时间
+} StateScratch;
+
+// 点到点双向搜索使用的缓冲区，第一次使用时创建。两侧的时间在查询之间保持全为INT_MAX，
+// touched[]记录本次查询中被任意一侧访问过的计算机，结束后只恢复这些计算机。
+typedef struct BidirScratch
+{
+	int *forwardTime;  // 从源出发，计算机被入侵的时间
+	int *parent;       // 正向搜索中的入侵者
+	int *backwardTime; // 计算机被入侵后，再入侵到目标还需要的时间
+	int *next;         // 反向搜索中通往目标的下一台计算机
+	int *touched;
+} BidirScratch;
+
+// 网络句柄
+struct Network
+{
+	Graph *graph;
+	Snapshot *snapshot; // 从快照打开时图归快照所有，关闭时解除映射而不是freeGraph
+	Graph *attack;      // 只含可入侵方向的边的攻击图，第一次使用时构建，总是归句柄所有
+	DenseMatrix *dense; // ENGINE_DENSE使用的边权矩阵，第一次使用时构建
+
+	VisitMarks visit; // 单次probePath使用
+
+	// 批量probePath使用的线程池与每个工作线程各自的访问标记，按需创建，在批次之间复用
+	ThreadPool *pool;
+	VisitMarks *workerVisit;
+	int numWorkerVisit;
+
+	// 全源扫描中每个工作者各自的time/order/优先队列，按需创建，在扫描之间复用
+	struct SweepScratch *workerScratch;
+	int numWorkerScratch;
+
+	// probePath查找连接用的边索引，线性扫描的累计代价超过建索引的代价后才构建
+	EdgeIndex *edgeIndex;
+	long long scanWork;
+
+	// poodle与advancedPoodle使用的优先队列，按需创建，在查询之间复用
+	PoodleEngine engine;
+	int poodleThreads; // ENGINE_DELTA_STEPPING使用的线程数，<= 0 为全部CPU核
+	int delta;         // ENGINE_DELTA_STEPPING的桶宽，第一次使用时选择
+	PQueue *queue;      // 以计算机为元素
+	PQueue *stateQueue; // 以(计算机, 安全等级)状态为元素
+	PQueue *backwardQueue; // 点到点查询的反向搜索
+	PrefixScratch prefix;
+	StateScratch states;
+	BidirScratch bidir;
+
+	// chooseSource使用的凝聚图，第一次使用时构建
+	Condensation *condensation;
+
+	QueryStats *stats; // 查询统计，NULL时关闭(见setQueryStats)
+};
+
+// 在已经构建好的图上完成句柄的初始化，失败时关闭句柄(连同图一起释放)并返回NULL
+static Network *initNetwork(Network *net)
+{
+	if (!net->graph)
+	{
+		closeNetwork(net);
+		return NULL;
+	}
+
+	net->visit.stamp = (int *)calloc(net->graph->numComputers, sizeof(int));
+	if (!net->visit.stamp)
+	{
+		closeNetwork(net);
+		return NULL;
+	}
+	net->visit.epoch = 0;
+	net->engine = ENGINE_AUTO;
+
+	return net;
+}
+
+Network *openNetwork(struct computer computers[], int numComputers,
+					 struct connection connections[], int numConnections)
+{
+	return openNetworkOrdered(computers, numComputers, connections, numConnections, ORDER_NONE);
+}
+
+Network *openNetworkOrdered(struct computer computers[], int numComputers,
+							struct connection connections[], int numConnections, GraphOrder order)
+{
+	Network *net = (Network *)calloc(1, sizeof(Network));
+	if (!net)
+		return NULL;
+
+	net->graph = buildGraphOrdered(computers, numComputers, connections, numConnections, order);
+	return initNetwork(net);
+}
+
+Network *openNetworkSnapshot(const char *filename, bool verify)
+{
+	Network *net = (Network *)calloc(1, sizeof(Network));
+	if (!net)
+		return NULL;
+
+	if (mapSnapshot(filename, verify, &net->snapshot) == LOAD_OK)
+	{
+		net->graph = snapshotGraph(net->snapshot);
+	}
+	return initNetwork(net);
+}
+
+void setPoodleEngine(Network *net, PoodleEngine engine)
+{
+	net->engine = engine;
+}
+
+void setPoodleThreads(Network *net, int numThreads)
+{
+	net->poodleThreads = numThreads;
+}
+
+void setQueryStats(Network *net, QueryStats *stats)
+{
+	net->stats = stats;
+}
+
+// 查询统计的辅助函数：统计关闭时每个都只是一次指针判断，每次查询只调用常数次。
+// 热循环中的计数见dijkstraFrom与advancedSearch。
+
+// 开始一次查询：清零并记下开始时刻(statsEnd时换成耗时)
+static void statsBegin(Network *net, const char *query)
+{
+	if (net->stats)
+	{
+		resetQueryStats(net->stats, query);
+		net->stats->totalNs = statsNowNs();
+	}
+}
+
+static void statsEnd(Network *net)
+{
+	if (net->stats)
+		net->stats->totalNs = statsNowNs() - net->stats->totalNs;
+}
+
+// 阶段计时的起点。扣除已经计入PHASE_BUILD的时间，所以一个阶段之中按需构建(包括嵌套的构建，
+// 例如凝聚图先构建攻击图)的时间只计入PHASE_BUILD一次
+static long long statsClock(Network *net)
+{
+	return net->stats ? statsNowNs() - net->stats->phaseNs[PHASE_BUILD] : 0;
+}
+
+static void statsPhase(Network *net, StatsPhase phase, long long start)
+{
+	if (net->stats)
+		net->stats->phaseNs[phase] += statsNowNs() - net->stats->phaseNs[PHASE_BUILD] - start;
+}
+
+static void statsAlloc(Network *net, long long bytes)
+{
+	if (net->stats)
+		net->stats->allocatedBytes += bytes;
+}
+
+static void statsEngine(Network *net, const char *engine)
+{
+	if (net->stats)
+		net->stats->engine = engine;
+}
+
+static const char *queueName(PQueue *pq)
+{
+	switch (pqKind(pq))
+	{
+	case PQ_BINARY_HEAP:
+		return "binary heap";
+	case PQ_QUAD_HEAP:
+		return "quad heap";
+	default:
+		return "radix heap";
+	}
+}
+
+// 由一次正向搜索的order[](图中的编号)统计确定的计算机、检查过的边与被安全等级挡住的边：
+// 攻击图只保留可入侵的边，原图中同一台计算机多出来的边就是被挡住的边
+static void statsSettled(Network *net, const Graph *attack, const int order[], int count)
+{
+	QueryStats *stats = net->stats;
+	if (!stats)
+		return;
+
+	const Graph *graph = net->graph;
+	stats->settled += count;
+	for (int i = 0; i < count; i++)
+	{
+		int u = order[i];
+		int kept = attack->offsets[u + 1] - attack->offsets[u];
+		stats->edgesScanned += kept;
+		stats->permissionRejections += graph->offsets[u + 1] - graph->offsets[u] - kept;
+	}
+}
+
+// 结果的步骤数组与接收者节点占用的字节数
+static long long resultBytes(int stepcount, bool withRecipients)
+{
+	long long size = (long long)stepcount * sizeof(struct step);
+	if (withRecipients && stepcount > 0)
+		size += (long long)(stepcount - 1) * sizeof(struct computerList);
+	return size;
+}
+
+// 取得与当前引擎对应的、容量为capacity的空优先队列，必要时重新创建
+// (ENGINE_DELTA_STEPPING、ENGINE_BUCKET、ENGINE_DENSE与ENGINE_AUTO只用于poodle，其余仍需要队列的搜索使用基数堆)
+static PQueue *reuseQueue(Network *net, PQueue **slot, int capacity)
+{
+	PQueueKind kind = net->engine == ENGINE_BINARY_HEAP ? PQ_BINARY_HEAP
+					  : net->engine == ENGINE_QUAD_HEAP ? PQ_QUAD_HEAP
+														: PQ_RADIX_HEAP;
+	if (*slot && (pqKind(*slot) != kind || pqCapacity(*slot) != capacity))
+	{
+		freePQueue(*slot);
+		*slot = NULL;
+	}
+	if (!*slot)
+	{
+		long long start = statsClock(net);
+		*slot = createPQueue(kind, capacity);
+		statsPhase(net, PHASE_BUILD, start);
+	}
+	else
+	{
+		pqClear(*slot);
+	}
+	return *slot;
+}
+
+void closeNetwork(Network *net)
+{
+	if (net)
+	{
+		if (net->snapshot)
+			unmapSnapshot(net->snapshot);
+		else
+			freeGraph(net->graph);
+		freeGraph(net->attack);
+		freeDenseMatrix(net->dense);
+		free(net->visit.stamp);
+		freeThreadPool(net->pool);
+		for (int i = 0; i < net->numWorkerVisit; i++)
+		{
+			free(net->workerVisit[i].stamp);
+		}
+		free(net->workerVisit);
+		for (int i = 0; i < net->numWorkerScratch; i++)
+		{
+			free(net->workerScratch[i].time);
+			free(net->workerScratch[i].order);
+			freePQueue(net->workerScratch[i].queue);
+		}
+		free(net->workerScratch);
+		free(net->prefix.time);
+		free(net->prefix.parent);
+		free(net->prefix.order);
+		free(net->states.stateTime);
+		free(net->states.settledLevel);
+		free(net->states.order);
+		free(net->states.orderTime);
+		free(net->bidir.forwardTime);
+		free(net->bidir.parent);
+		free(net->bidir.backwardTime);
+		free(net->bidir.next);
+		free(net->bidir.touched);
+		freeEdgeIndex(net->edgeIndex);
+		freePQueue(net->queue);
+		freePQueue(net->stateQueue);
+		freePQueue(net->backwardQueue);
+		freeCondensation(net->condensation);
+		free(net);
+	}
+}
+
+// 取得(必要时构建)攻击图。安全等级固定，所以只需构建一次；
+// 之后正向的遍历不再逐边检查权限。内存不足时返回NULL。
+static Graph *networkAttackGraph(Network *net)
+{
+	if (!net->attack)
+	{
+		long long start = statsClock(net);
+		net->attack = buildAttackGraph(net->graph);
+		statsPhase(net, PHASE_BUILD, start);
+	}
+	return net->attack;
+}
+
+// 取得(必要时构建)稠密引擎的边权矩阵；计算机太多或内存不足时返回NULL
+static DenseMatrix *networkDenseMatrix(Network *net, Graph *attack)
+{
+	if (!net->dense)
+	{
+		long long start = statsClock(net);
+		net->dense = buildDenseMatrix(attack);
+		statsPhase(net, PHASE_BUILD, start);
+	}
+	return net->dense;
+}
+
+////////////////////////////////////////////////////////////////////////
+// Task 1
+
+/* 辅助函数：查找连接时间，有边索引时二分查找，否则线性扫描邻接行
+   (work不为NULL时累加扫描过的边数) */
+static int findConnectionTime(Graph *graph, EdgeIndex *index, int src, int dest, long long *work)
+{
+	if (src == dest)
+		return 0; // 自环连接，可看作边长为0
+
+	if (index)
+		return edgeIndexFind(graph, index, src, dest);
+
+	if (work)
+		*work += graph->offsets[src + 1] - graph->offsets[src];
+	for (int e = graph->offsets[src]; e < graph->offsets[src + 1]; e++)
+	{
+		if (graph->dest[e] == dest)
+		{
+			return graph->transmissionTime[e];
+		}
+	}
+	return -1; // 未找到连接
+}
+
+// 探测一条路径(调用者的编号)，first-visit的poodleTime用marks判断。
+// work不为NULL时，*index为空则先线性扫描，并在累计扫描的边数超过边的总数时构建*index
+// (构建的代价约为扫描一遍所有边)，这样只探测少量跳的调用不会为索引付出额外的代价。
+static struct probePathResult probeOne(Graph *graph, EdgeIndex **index, const int path[],
+									   int pathLength, VisitMarks *marks, long long *work)
+{
+	struct probePathResult res = {SUCCESS, 0};
+
+	if (pathLength == 0)
+	{
+		return res;
+	}
+
+	const int *poodleTime = graph->poodleTime;
+
+	// 开启新一轮访问标记；计数器回绕时才需要真正清空数组
+	if (++marks->epoch == INT_MAX)
+	{
+		for (int i = 0; i < graph->numComputers; i++)
+		{
+			marks->stamp[i] = 0;
+		}
+		marks->epoch = 1;
+	}
+	int *visitStamp = marks->stamp;
+	int epoch = marks->epoch;
+
+	// 处理path[0]
+	int countTime = 0;
+	int prev = GRAPH_POSITION(graph, path[0]);
+	if (visitStamp[prev] != epoch)
+	{
+		countTime += poodleTime[prev];
+		visitStamp[prev] = epoch;
+	}
+
+	// 处理path[1]到path[pathLength-1]
+	for (int i = 1; i < pathLength; i++)
+	{
+		int current = GRAPH_POSITION(graph, path[i]);
+
+		if (!*index && work && *work > graph->numEdges)
+		{
+			*index = buildEdgeIndex(graph);
+			if (!*index)
+				*work = LLONG_MIN; // 内存不足，之后一直线性扫描
+		}
+
+		// 检查连接是否存在，若连接不存在，则res.status转为NO_CONNECTION
+		int transmissionTime = findConnectionTime(graph, *index, prev, current, work);
+		if (transmissionTime == -1)
+		{
+			res.status = NO_CONNECTION;
+			res.elapsedTime = countTime;
+			return res;
+		}
+
+		// 检查安全等级是否合法，若安全权限不足，则res.status转为NO_PERMISSION
+		if (GRAPH_LEVEL(graph, prev) + 1 < GRAPH_LEVEL(graph, current))
+		{
+			res.status = NO_PERMISSION;
+			res.elapsedTime = countTime;
+			return res;
+		}
+
+		// 累加传输时间transmissionTime(边的权重)
+		countTime += transmissionTime;
+
+		// 只有初次访问该计算机，才需要计算poodleTime(点的权重)
+		if (visitStamp[current] != epoch)
+		{
+			countTime += poodleTime[current];
+			visitStamp[current] = epoch;
+		}
+
+		prev = current;
+	}
+
+	res.elapsedTime = countTime;
+	return res;
+}
+
+// 取得(必要时构建)边索引；内存不足时返回NULL，调用者退回线性扫描
+static EdgeIndex *networkEdgeIndex(Network *net)
+{
+	if (!net->edgeIndex)
+	{
+		long long start = statsClock(net);
+		net->edgeIndex = buildEdgeIndex(net->graph);
+		statsPhase(net, PHASE_BUILD, start);
+	}
+	return net->edgeIndex;
+}
+
+struct probePathResult networkProbePath(Network *net, int path[], int pathLength)
+{
+	statsBegin(net, "probePath");
+	long long start = statsClock(net);
+	struct probePathResult res = probeOne(net->graph, &net->edgeIndex, path, pathLength, &net->visit, &net->scanWork);
+	statsPhase(net, PHASE_SEARCH, start);
+	statsEnd(net);
+	return res;
+}
+
+// 取得有numThreads个工作者的线程池(numThreads <= 0 时为全部CPU核)，必要时重新创建；失败时返回NULL
+static ThreadPool *networkPool(Network *net, int numThreads)
+{
+	if (numThreads <= 0)
+	{
+		numThreads = onlineCpuCount();
+	}
+	if (net->pool && threadPoolSize(net->pool) != numThreads)
+	{
+		freeThreadPool(net->pool);
+		net->pool = NULL;
+	}
+	if (!net->pool)
+	{
+		net->pool = createThreadPool(numThreads);
+	}
+	return net->pool;
+}
+
+// 批量探测时传给线程池的参数
+typedef struct ProbeBatch
+{
+	Graph *graph;
+	EdgeIndex *index;
+	VisitMarks *workerVisit;
+	const int *pathOffsets;
+	const int *pathNodes;
+	struct probePathResult *results;
+} ProbeBatch;
+
+static void probeBatchTask(void *context, int worker, int begin, int end)
+{
+	ProbeBatch *batch = (ProbeBatch *)context;
+	EdgeIndex *index = batch->index;
+	for (int p = begin; p < end; p++)
+	{
+		int first = batch->pathOffsets[p];
+		batch->results[p] = probeOne(batch->graph, &index, &batch->pathNodes[first],
+									 batch->pathOffsets[p + 1] - first, &batch->workerVisit[worker], NULL);
+	}
+}
+
+// 每个工作者每次领取的路径数量：足够大以分摊原子操作，又足够小以保持负载均衡
+#define PROBE_BATCH_CHUNK 256
+
+static bool probePathBatch(Network *net, const int pathOffsets[], const int pathNodes[],
+						   int numPaths, struct probePathResult results[], int numThreads)
+{
+	if (!networkPool(net, numThreads))
+		return false;
+
+	// 为每个工作者准备访问标记
+	int workers = threadPoolSize(net->pool);
+	if (net->numWorkerVisit < workers)
+	{
+		VisitMarks *marks = (VisitMarks *)realloc(net->workerVisit, workers * sizeof(VisitMarks));
+		if (!marks)
+			return false;
+		net->workerVisit = marks;
+		for (int i = net->numWorkerVisit; i < workers; i++)
+		{
+			marks[i].stamp = (int *)calloc(net->graph->numComputers, sizeof(int));
+			marks[i].epoch = 0;
+			if (!marks[i].stamp)
+				return false;
+			net->numWorkerVisit++;
+		}
+	}
+
+	// 边索引必须在启动线程之前构建好，工作线程之间只读共享
+	ProbeBatch batch = {net->graph, networkEdgeIndex(net), net->workerVisit,
+						pathOffsets, pathNodes, results};
+	long long start = statsClock(net);
+	threadPoolRun(net->pool, numPaths, PROBE_BATCH_CHUNK, probeBatchTask, &batch);
+	statsPhase(net, PHASE_SEARCH, start);
+	return true;
+}
+
+bool networkProbePathBatch(Network *net, const int pathOffsets[], const int pathNodes[],
+						   int numPaths, struct probePathResult results[], int numThreads)
+{
+	statsBegin(net, "probePathBatch");
+	bool ok = probePathBatch(net, pathOffsets, pathNodes, numPaths, results, numThreads);
+	statsEnd(net);
+	return ok;
+}
+
+////////////////////////////////////////////////////////////////////////
+// Task 2
+
+// 取得(必要时构建)句柄缓存的凝聚图，安全等级固定，所以只需构建一次
+static Condensation *networkCondensation(Network *net)
+{
+	if (!net->condensation && networkAttackGraph(net))
+	{
+		long long start = statsClock(net);
+		net->condensation = buildCondensation(net->attack);
+		statsPhase(net, PHASE_BUILD, start);
+	}
+	return net->condensation;
+}
+
+// 在凝聚图上从SCC c出发做迭代DFS，把能到达的SCC标记为mark，返回它们包含的计算机总数
+static int reachFrom(Condensation *cond, int c, int stamp[], int mark, int stack[])
+{
+	int top = 0;
+	int count = 0;
+	stack[top++] = c;
+	stamp[c] = mark;
+	while (top > 0)
+	{
+		int k = stack[--top];
+		count += cond->size[k];
+		for (int e = cond->offsets[k]; e < cond->offsets[k + 1]; e++)
+		{
+			int d = cond->dest[e];
+			if (stamp[d] != mark)
+			{
+				stamp[d] = mark;
+				stack[top++] = d;
+			}
+		}
+	}
+	return count;
+}
+
+// 计算从入度为0的SCC c出发能入侵的计算机数量。
+// hubReach[]标记了从hub(最大的SCC)出发能到达的SCC集合D，共hubCount台计算机。
+// DFS不进入D：只要碰到hub本身，D就整个可达，直接加上hubCount；
+// 只碰到D中的其他SCC时才需要进入D求并集。随机网络中绝大多数源都会连到hub，
+// 于是每个源的代价只与它自己"上游"的那一小部分有关，而不是整张凝聚图。
+static int countReach(Condensation *cond, int c, int hub, const bool hubReach[], int hubCount,
+					  int stamp[], int mark, int stack[], int boundary[])
+{
+	if (c == hub)
+		return hubCount;
+
+	int top = 0;
+	int numBoundary = 0;
+	int count = 0;
+	bool touchedHub = false;
+
+	stack[top++] = c;
+	stamp[c] = mark;
+	while (top > 0)
+	{
+		int k = stack[--top];
+		count += cond->size[k];
+		for (int e = cond->offsets[k]; e < cond->offsets[k + 1]; e++)
+		{
+			int d = cond->dest[e];
+			if (stamp[d] == mark)
+				continue;
+			stamp[d] = mark;
+
+			if (d == hub)
+				touchedHub = true;
+			else if (hubReach[d])
+				boundary[numBoundary++] = d;
+			else
+				stack[top++] = d;
+		}
+	}
+
+	if (touchedHub)
+		return count + hubCount;
+
+	// 没有碰到hub：从边界上的SCC继续DFS(它们能到达的SCC都在D中)
+	for (int i = 0; i < numBoundary; i++)
+	{
+		stack[top++] = boundary[i];
+		while (top > 0)
+		{
+			int k = stack[--top];
+			count += cond->size[k];
+			for (int e = cond->offsets[k]; e < cond->offsets[k + 1]; e++)
+			{
+				int d = cond->dest[e];
+				if (stamp[d] != mark)
+				{
+					stamp[d] = mark;
+					stack[top++] = d;
+				}
+			}
+		}
+	}
+	return count;
+}
+
+// 能入侵的集合按SCC计算：同一SCC内的计算机结果相同；若SCC a能到达SCC b，
+// 则a的可入侵集合严格包含b的，所以最佳源一定在入度为0的SCC中。
+// 在凝聚图上对这些SCC分别计数(见countReach)，取计算机最多者，数量相同时取编号最小的计算机，
+// 与原先从每台计算机分别dfs的结果一致。
+static struct chooseSourceResult chooseBestSource(Network *net)
+{
+	struct chooseSourceResult res = {0, 0, NULL};
+
+	int numComputers = net->graph->numComputers;
+	Condensation *cond = networkCondensation(net);
+	if (!cond || cond->numComponents == 0)
+	{
+		return res; // 没有计算机时也没有可选的源
+	}
+
+	long long start = statsClock(net);
+	int numComponents = cond->numComponents;
+	statsAlloc(net, 3LL * numComponents * sizeof(int) + numComponents * sizeof(bool));
+	int *stamp = (int *)malloc(numComponents * sizeof(int));
+	int *stack = (int *)malloc(numComponents * sizeof(int));
+	int *boundary = (int *)malloc(numComponents * sizeof(int));
+	bool *hubReach = (bool *)calloc(numComponents, sizeof(bool));
+	if (!stamp || !stack || !boundary || !hubReach)
+	{
+		free(stamp);
+		free(stack);
+		free(boundary);
+		free(hubReach);
+		return res;
+	}
+	for (int k = 0; k < numComponents; k++)
+	{
+		stamp[k] = -1;
+	}
+
+	// 以最大的SCC为hub，预先求出它能到达的集合
+	int hub = 0;
+	for (int k = 1; k < numComponents; k++)
+	{
+		if (cond->size[k] > cond->size[hub])
+			hub = k;
+	}
+	int hubCount = reachFrom(cond, hub, stamp, numComponents, stack);
+	for (int k = 0; k < numComponents; k++)
+	{
+		hubReach[k] = stamp[k] == numComponents;
+	}
+
+	int maxCount = 0;
+	int bestComponent = -1;
+	for (int k = 0; k < numComponents; k++)
+	{
+		if (cond->inDegree[k] != 0)
+			continue;
+
+		int count = countReach(cond, k, hub, hubReach, hubCount, stamp, k, stack, boundary);
+		if (count > maxCount ||
+			(count == maxCount && cond->minComputer[k] < cond->minComputer[bestComponent]))
+		{
+			maxCount = count;
+			bestComponent = k;
+		}
+	}
+
+	// 重新标记最佳源能到达的SCC，并按(原)编号顺序收集计算机(结果天然有序)
+	statsPhase(net, PHASE_SEARCH, start);
+	start = statsClock(net);
+	int mark = numComponents + 1;
+	reachFrom(cond, bestComponent, stamp, mark, stack);
+	statsAlloc(net, (long long)maxCount * sizeof(int));
+	int *bestComputers = (int *)malloc(maxCount * sizeof(int));
+	int index = 0;
+	for (int c = 0; c < numComputers && bestComputers; c++)
+	{
+		if (stamp[cond->component[GRAPH_POSITION(net->graph, c)]] == mark)
+		{
+			bestComputers[index++] = c;
+		}
+	}
+
+	free(stamp);
+	free(stack);
+	free(boundary);
+	free(hubReach);
+
+	// 设置结果
+	res.sourceComputer = cond->minComputer[bestComponent];
+	res.numComputers = maxCount;
+	res.computers = bestComputers;
+	statsPhase(net, PHASE_RESULT, start);
+
+	return res;
+}
+
+struct chooseSourceResult networkChooseSource(Network *net)
+{
+	statsBegin(net, "chooseSource");
+	struct chooseSourceResult res = chooseBestSource(net);
+	statsEnd(net);
+	return res;
+}
+
+static bool reachCounts(Network *net, int reachCount[])
+{
+	Condensation *cond = networkCondensation(net);
+	if (!cond)
+		return false;
+
+	long long start = statsClock(net);
+	statsAlloc(net, (long long)cond->numComponents * sizeof(int));
+	int *componentReach = (int *)malloc(cond->numComponents * sizeof(int));
+	if (!componentReach || !condensationReachCounts(cond, componentReach))
+	{
+		free(componentReach);
+		return false;
+	}
+	statsPhase(net, PHASE_SEARCH, start);
+
+	start = statsClock(net);
+	for (int v = 0; v < cond->numComputers; v++)
+	{
+		reachCount[GRAPH_LABEL(net->graph, v)] = componentReach[cond->component[v]];
+	}
+	statsPhase(net, PHASE_RESULT, start);
+
+	free(componentReach);
+	return true;
+}
+
+bool networkReachCounts(Network *net, int reachCount[])
+{
+	statsBegin(net, "reachCounts");
+	bool ok = reachCounts(net, reachCount);
+	statsEnd(net);
+	return ok;
+}
+
+////////////////////////////////////////////////////////////////////////
+// Task 3
+
+// 提前终止的条件：只入侵时间不超过deadline的计算机，并且最多入侵maxSteps台
+typedef struct SearchLimit
+{
+	int deadline;
+	int maxSteps;
+} SearchLimit;
+
+static const SearchLimit NO_LIMIT = {INT_MAX, INT_MAX};
+
+// Dijkstra：计算从startingComputer出发每台计算机最早被入侵的时间
+// attack为攻击图，每条边都是合法的入侵方向，所以松弛时不需要检查安全等级。
+// 调用前time[]必须全为INT_MAX、parent[]全为-1(parent可以为NULL)，pq必须为空。
+// order[]按被入侵的先后顺序记录计算机，返回其数量；order[]之外的time[]与parent[]保持不变。
+// 时间相同时(原)编号小的计算机先出队，与原先线性扫描(取第一个最小值)的顺序一致，
+// 因此parent[]的选择也与原实现相同。
+//
+// 达到limit时立即停止，order[]是完整入侵顺序的前缀。此时pq中恰好剩下
+// 被更新过时间但没有进入order[]的计算机(边界)，调用者可以依次弹出它们来恢复time[]与parent[]。
+//
+// 队列内存不足(只有基数堆会发生)时清空pq并返回-1，此时time[]与parent[]可能已被部分修改。
+//
+// stats不为NULL时统计队列操作(确定的计算机与边由调用者按order[]统计，见statsSettled)。
+// 总是内联进dijkstraFrom，stats为常量NULL的一份不含任何计数代码。
+static inline __attribute__((always_inline)) int dijkstraSearch(Graph *attack, PQueue *pq, int startingComputer,
+																int time[], int parent[], int order[],
+																SearchLimit limit, QueryStats *stats)
+{
+	const int *poodleTime = attack->poodleTime;
+
+	time[startingComputer] = poodleTime[startingComputer];
+	if (!pqPush(pq, startingComputer, PQ_KEY(time[startingComputer], GRAPH_LABEL(attack, startingComputer))))
+		return -1;
+	if (stats)
+		stats->pushes++;
+
+	int stepcount = 0;
+	while (!pqIsEmpty(pq))
+	{
+		uint64_t key;
+		int u = pqPopMin(pq, &key);
+		if (u < 0)
+		{
+			pqClear(pq);
+			return -1;
+		}
+		if (stats)
+			stats->pops++;
+		if (time[u] > limit.deadline || stepcount >= limit.maxSteps)
+		{
+			// 放回原来的键，不破坏基数堆的单调性(刚弹出的元素所在的桶0不需要扩容)
+			pqPush(pq, u, key);
+			break;
+		}
+		order[stepcount++] = u;
+
+		// 尝试更新邻居节点的时间
+		// 边权和点权都为正，已出队节点的时间不可能再被更新，因此不需要单独的inDjikstra标记
+		for (int e = attack->offsets[u]; e < attack->offsets[u + 1]; e++)
+		{
+			int v = attack->dest[e];
+			int newTime = time[u] + attack->transmissionTime[e] + poodleTime[v];
+
+			// 如果时间可以变得更短，则更新时间
+			if (newTime < time[v])
+			{
+				if (stats)
+				{
+					if (time[v] == INT_MAX)
+						stats->pushes++;
+					else
+						stats->decreaseKeys++;
+				}
+				time[v] = newTime;
+				if (parent)
+					parent[v] = u;
+				if (!pqPush(pq, v, PQ_KEY(newTime, GRAPH_LABEL(attack, v))))
+				{
+					pqClear(pq);
+					return -1;
+				}
+			}
+		}
+	}
+
+	return stepcount;
+}
+
+// 见dijkstraSearch。按是否统计各展开一份搜索，每次查询只判断一次
+static int dijkstraFrom(Graph *attack, PQueue *pq, int startingComputer, int time[], int parent[], int order[],
+						SearchLimit limit, QueryStats *stats)
+{
+	if (stats)
+		return dijkstraSearch(attack, pq, startingComputer, time, parent, order, limit, stats);
+	return dijkstraSearch(attack, pq, startingComputer, time, parent, order, limit, NULL);
+}
+
+// 初始化time[]与parent[](可以为NULL)后用句柄的优先队列做一次dijkstraFrom，
+// 或者在ENGINE_DELTA_STEPPING下用线程池做并行delta-stepping，
+// 在ENGINE_DENSE(以及攻击图足够稠密时的ENGINE_AUTO)下用数组扫描，
+// 在ENGINE_BUCKET(以及边权合适时的ENGINE_AUTO)下用桶队列(无法使用或内存不足时都退回Dijkstra)。
+// 内存不足时返回-1
+static int poodleSearch(Network *net, int startingComputer, int time[], int parent[], int order[])
+{
+	int numComputers = net->graph->numComputers;
+	Graph *attack = networkAttackGraph(net);
+	if (!attack)
+		return -1;
+
+	if (net->engine == ENGINE_DELTA_STEPPING && networkPool(net, net->poodleThreads))
+	{
+		if (net->delta == 0)
+		{
+			net->delta = chooseDelta(attack);
+		}
+		int count = deltaSteppingSearch(net->graph, attack, net->pool, net->delta, startingComputer, time, parent,
+										order);
+		if (count >= 0)
+		{
+			statsEngine(net, "delta stepping");
+			return count;
+		}
+	}
+
+	if (net->engine == ENGINE_DENSE || (net->engine == ENGINE_AUTO && denseSearchSuits(attack)))
+	{
+		DenseMatrix *matrix = networkDenseMatrix(net, attack);
+		int count = matrix ? denseSearch(matrix, attack, denseBestKernel(), startingComputer, time, parent, order)
+						   : -1;
+		if (count >= 0)
+		{
+			statsEngine(net, "dense");
+			return count;
+		}
+	}
+
+	if (net->engine == ENGINE_BUCKET || (net->engine == ENGINE_AUTO && bucketSearchSuits(attack)))
+	{
+		int count = bucketSearch(attack, startingComputer, time, parent, order);
+		if (count >= 0)
+		{
+			statsEngine(net, "bucket");
+			return count;
+		}
+	}
+
+	for (int i = 0; i < numComputers; i++)
+	{
+		time[i] = INT_MAX;
+		if (parent)
+			parent[i] = -1;
+	}
+
+	PQueue *pq = reuseQueue(net, &net->queue, numComputers);
+	if (!pq)
+		return -1;
+
+	statsEngine(net, queueName(pq));
+	return dijkstraFrom(attack, pq, startingComputer, time, parent, order, NO_LIMIT, net->stats);
+}
+
+// 把一次搜索的time[]、parent[](可以为NULL)与order[]的前stepcount项从图中的编号换成调用者的编号，
+// scratch[]为长度为计算机数量的临时数组。order[]中时间相同的计算机已经按原编号排列，
+// 换过之后仍然是(时间, 编号)的顺序。图没有重排时什么都不做。
+static void toCallerIds(const Graph *graph, int time[], int parent[], int order[], int stepcount, int scratch[])
+{
+	const int *label = graph->label;
+	int numComputers = graph->numComputers;
+	if (!label)
+		return;
+
+	memcpy(scratch, time, numComputers * sizeof(int));
+	for (int v = 0; v < numComputers; v++)
+	{
+		time[label[v]] = scratch[v];
+	}
+	if (parent)
+	{
+		memcpy(scratch, parent, numComputers * sizeof(int));
+		for (int v = 0; v < numComputers; v++)
+		{
+			parent[label[v]] = scratch[v] == -1 ? -1 : label[scratch[v]];
+		}
+	}
+	for (int i = 0; i < stepcount; i++)
+	{
+		order[i] = label[order[i]];
+	}
+}
+
+int networkInfectionTimes(Network *net, int startingComputer, int time[])
+{
+	Graph *graph = net->graph;
+	statsBegin(net, "infectionTimes");
+	statsAlloc(net, (long long)graph->numComputers * sizeof(int));
+	int *order = (int *)malloc(graph->numComputers * sizeof(int));
+	int count = -1;
+	if (order)
+	{
+		long long start = statsClock(net);
+		count = poodleSearch(net, GRAPH_POSITION(graph, startingComputer), time, NULL, order);
+		statsPhase(net, PHASE_SEARCH, start);
+	}
+	if (count >= 0)
+	{
+		statsSettled(net, net->attack, order, count);
+
+		// order[]之后不再需要，用作换回原编号的临时数组
+		long long start = statsClock(net);
+		toCallerIds(graph, time, NULL, NULL, 0, order);
+		statsPhase(net, PHASE_RESULT, start);
+	}
+
+	free(order);
+	statsEnd(net);
+	return count >= 0 ? count : 0;
+}
+
+struct poodleResult buildPoodleResult(const int time[], const int parent[], const int order[],
+									  int numComputers, int stepcount, Arena *arena)
+{
+	struct poodleResult res = {0, NULL};
+
+	int *childEnd = (int *)calloc(numComputers + 1, sizeof(int));
+	if (!childEnd)
+		return res;
+
+	// task3的专属任务：找出每台计算机入侵的所有子节点，并且按升序输出。
+	// 对parent[]做一次计数排序得到"子节点CSR"：先统计每台计算机的子节点数量，
+	// 再按计算机编号从小到大把每个子节点放进其父节点的区间，区间内自然是升序的。
+	// 填充结束后childEnd[p]为p的区间末尾，p的区间起点为childEnd[p - 1](p为0时为0)。
+	for (int v = 0; v < numComputers; v++)
+	{
+		if (parent[v] != -1)
+			childEnd[parent[v] + 1]++;
+	}
+	for (int p = 0; p < numComputers; p++)
+	{
+		childEnd[p + 1] += childEnd[p];
+	}
+
+	// 步骤数组与全部computerList节点放在同一块内存中：stepcount个步骤之后是stepcount - 1个节点
+	// (除起点外每台被入侵的计算机恰好是一个接收者)
+	int numRecipients = stepcount > 0 ? stepcount - 1 : 0;
+	size_t size = stepcount * sizeof(struct step) + numRecipients * sizeof(struct computerList);
+	struct step *steps = (struct step *)(arena ? arenaAlloc(arena, size) : malloc(size));
+	if (!steps)
+	{
+		free(childEnd);
+		return res;
+	}
+	struct computerList *nodes = (struct computerList *)(steps + stepcount);
+
+	for (int v = 0; v < numComputers; v++)
+	{
+		if (parent[v] != -1)
+			nodes[childEnd[parent[v]]++].computer = v;
+	}
+
+	// 将代表步骤数的stepcount赋值给result (即所有可以被入侵的计算机数量)，
+	// 并按order的顺序，对每一步填充计算机序号cur、它被入侵的时刻以及接收者链表
+	res.numSteps = stepcount;
+	res.steps = steps;
+	for (int i = 0; i < stepcount; i++)
+	{
+		int cur = order[i];
+		int begin = cur == 0 ? 0 : childEnd[cur - 1];
+		int end = childEnd[cur];
+
+		steps[i].computer = cur;
+		steps[i].time = time[cur];
+		steps[i].recipients = begin < end ? &nodes[begin] : NULL;
+		for (int k = begin; k < end; k++)
+		{
+			nodes[k].next = k + 1 < end ? &nodes[k + 1] : NULL;
+		}
+	}
+
+	free(childEnd);
+	return res;
+}
+
+// 一次poodle搜索，res不为NULL时构建结果(从arena分配，arena为NULL时用malloc)，
+// tree不为NULL时构建入侵树(内存不足时为NULL)
+static void poodleQuery(Network *net, int startingComputer, Arena *arena, struct poodleResult *res,
+						InfectionTree **tree)
+{
+	Graph *graph = net->graph;
+	int numComputers = graph->numComputers;
+
+	// 初始化：所有缓冲区都按网络的实际规模分配(图重排过时另需一个换回原编号用的临时数组)
+	statsAlloc(net, (graph->label ? 4LL : 3LL) * numComputers * sizeof(int));
+	int *time = (int *)malloc(numComputers * sizeof(int));
+	int *parent = (int *)malloc(numComputers * sizeof(int));
+	int *resQueue = (int *)malloc(numComputers * sizeof(int));
+	int *scratch = graph->label ? (int *)malloc(numComputers * sizeof(int)) : NULL;
+	int stepcount = -1;
+	if (time && parent && resQueue && (scratch || !graph->label))
+	{
+		long long start = statsClock(net);
+		stepcount = poodleSearch(net, GRAPH_POSITION(graph, startingComputer), time, parent, resQueue);
+		statsPhase(net, PHASE_SEARCH, start);
+	}
+	if (stepcount >= 0)
+	{
+		statsSettled(net, net->attack, resQueue, stepcount);
+
+		long long start = statsClock(net);
+		toCallerIds(graph, time, parent, resQueue, stepcount, scratch);
+		if (res)
+		{
+			*res = buildPoodleResult(time, parent, resQueue, numComputers, stepcount, arena);
+			statsAlloc(net, resultBytes(res->numSteps, true));
+		}
+		if (tree)
+			*tree = buildInfectionTree(time, parent, resQueue, numComputers, stepcount);
+		statsPhase(net, PHASE_RESULT, start);
+	}
+
+	// 释放内存资源
+	free(time);
+	free(parent);
+	free(resQueue);
+	free(scratch);
+}
+
+struct poodleResult networkPoodle(Network *net, int startingComputer)
+{
+	return networkPoodleInArena(net, startingComputer, NULL);
+}
+
+struct poodleResult networkPoodleInArena(Network *net, int startingComputer, Arena *arena)
+{
+	struct poodleResult res = {0, NULL};
+	statsBegin(net, "poodle");
+	poodleQuery(net, startingComputer, arena, &res, NULL);
+	statsEnd(net);
+	return res;
+}
+
+struct poodleResult networkPoodleWithTree(Network *net, int startingComputer, InfectionTree **tree)
+{
+	struct poodleResult res = {0, NULL};
+	*tree = NULL;
+	statsBegin(net, "poodleWithTree");
+	poodleQuery(net, startingComputer, NULL, &res, tree);
+	statsEnd(net);
+	return res;
+}
+
+InfectionTree *networkInfectionTree(Network *net, int startingComputer)
+{
+	InfectionTree *tree = NULL;
+	statsBegin(net, "infectionTree");
+	poodleQuery(net, startingComputer, NULL, NULL, &tree);
+	statsEnd(net);
+	return tree;
+}
+
+void freePoodleResult(struct poodleResult res)
+{
+	free(res.steps);
+}
+
+// 一次入侵：按(入侵者, 接收者)排序后，每台计算机的接收者连续且按编号升序
+typedef struct Infection
+{
+	int parent;
+	int child;
+} Infection;
+
+static int compareInfection(const void *a, const void *b)
+{
+	const Infection *x = (const Infection *)a;
+	const Infection *y = (const Infection *)b;
+	if (x->parent != y->parent)
+		return x->parent < y->parent ? -1 : 1;
+	return (x->child > y->child) - (x->child < y->child);
+}
+
+// 由提前终止的搜索得到的前缀构建结果，格式与buildPoodleResult相同，结果中是调用者的编号，
+// 代价为O(k log k)(k为步骤数)，不随网络规模变化。
+// 入侵者的时间严格早于接收者，所以前缀中除起点外每台计算机的入侵者都在前缀中，
+// 接收者也只包括前缀中的计算机。
+static struct poodleResult buildPrefixResult(const Graph *graph, const int time[], const int parent[],
+											 const int order[], int stepcount)
+{
+	struct poodleResult res = {0, NULL};
+	if (stepcount == 0)
+		return res;
+
+	int numRecipients = stepcount - 1;
+	Infection *infections = (Infection *)malloc((numRecipients + 1) * sizeof(Infection));
+	size_t size = stepcount * sizeof(struct step) + numRecipients * sizeof(struct computerList);
+	struct step *steps = (struct step *)malloc(size);
+	if (!infections || !steps)
+	{
+		free(infections);
+		free(steps);
+		return res;
+	}
+	struct computerList *nodes = (struct computerList *)(steps + stepcount);
+
+	for (int i = 1; i < stepcount; i++)
+	{
+		infections[i - 1].parent = GRAPH_LABEL(graph, parent[order[i]]);
+		infections[i - 1].child = GRAPH_LABEL(graph, order[i]);
+	}
+	qsort(infections, numRecipients, sizeof(Infection), compareInfection);
+	for (int k = 0; k < numRecipients; k++)
+	{
+		nodes[k].computer = infections[k].child;
+		nodes[k].next = k + 1 < numRecipients && infections[k + 1].parent == infections[k].parent
+							? &nodes[k + 1]
+							: NULL;
+	}
+
+	for (int i = 0; i < stepcount; i++)
+	{
+		int cur = GRAPH_LABEL(graph, order[i]);
+
+		// 二分查找cur的第一个接收者
+		int lo = 0, hi = numRecipients;
+		while (lo < hi)
+		{
+			int mid = lo + (hi - lo) / 2;
+			if (infections[mid].parent < cur)
+				lo = mid + 1;
+			else
+				hi = mid;
+		}
+
+		steps[i].computer = cur;
+		steps[i].time = time[order[i]];
+		steps[i].recipients = lo < numRecipients && infections[lo].parent == cur ? &nodes[lo] : NULL;
+	}
+
+	free(infections);
+	res.numSteps = stepcount;
+	res.steps = steps;
+	return res;
+}
+
+// 取得提前终止查询的缓冲区，第一次使用时创建，内存不足时返回NULL
+static PrefixScratch *networkPrefixScratch(Network *net)
+{
+	PrefixScratch *scratch = &net->prefix;
+	if (!scratch->time)
+	{
+		long long start = statsClock(net);
+		int numComputers = net->graph->numComputers;
+		int *time = (int *)malloc(numComputers * sizeof(int));
+		int *parent = (int *)malloc(numComputers * sizeof(int));
+		int *order = (int *)malloc(numComputers * sizeof(int));
+		if (!time || !parent || !order)
+		{
+			free(time);
+			free(parent);
+			free(order);
+			return NULL;
+		}
+		for (int i = 0; i < numComputers; i++)
+		{
+			time[i] = INT_MAX;
+			parent[i] = -1;
+		}
+		scratch->time = time;
+		scratch->parent = parent;
+		scratch->order = order;
+		statsPhase(net, PHASE_BUILD, start);
+	}
+	return scratch;
+}
+
+// 队列内存不足时不知道哪些计算机被访问过，整个恢复缓冲区并清空队列
+static void resetPrefixScratch(Graph *attack, PrefixScratch *scratch, PQueue *pq)
+{
+	for (int i = 0; i < attack->numComputers; i++)
+	{
+		scratch->time[i] = INT_MAX;
+		scratch->parent[i] = -1;
+	}
+	pqClear(pq);
+}
+
+static struct poodleResult poodleBounded(Network *net, int startingComputer, int deadline, int maxSteps)
+{
+	struct poodleResult res = {0, NULL};
+
+	Graph *attack = networkAttackGraph(net);
+	PrefixScratch *scratch = networkPrefixScratch(net);
+	PQueue *pq = reuseQueue(net, &net->queue, net->graph->numComputers);
+	if (!attack || !scratch || !pq)
+		return res;
+
+	long long start = statsClock(net);
+	SearchLimit limit = {deadline, maxSteps};
+	statsEngine(net, queueName(pq));
+	int stepcount = dijkstraFrom(attack, pq, GRAPH_POSITION(attack, startingComputer), scratch->time,
+								 scratch->parent, scratch->order, limit, net->stats);
+	statsPhase(net, PHASE_SEARCH, start);
+	if (stepcount < 0)
+	{
+		resetPrefixScratch(attack, scratch, pq);
+		return res;
+	}
+	statsSettled(net, attack, scratch->order, stepcount);
+
+	start = statsClock(net);
+	res = buildPrefixResult(attack, scratch->time, scratch->parent, scratch->order, stepcount);
+	statsAlloc(net, resultBytes(res.numSteps, true));
+	statsPhase(net, PHASE_RESULT, start);
+
+	// 恢复缓冲区：结果中的计算机，以及留在队列中的边界
+	for (int i = 0; i < stepcount; i++)
+	{
+		scratch->time[scratch->order[i]] = INT_MAX;
+		scratch->parent[scratch->order[i]] = -1;
+	}
+	while (!pqIsEmpty(pq))
+	{
+		int v = pqPopMin(pq, NULL);
+		if (v < 0)
+		{
+			resetPrefixScratch(attack, scratch, pq);
+			break;
+		}
+		scratch->time[v] = INT_MAX;
+		scratch->parent[v] = -1;
+	}
+
+	return res;
+}
+
+struct poodleResult networkPoodleBounded(Network *net, int startingComputer, int deadline, int maxSteps)
+{
+	statsBegin(net, "poodleBounded");
+	struct poodleResult res = poodleBounded(net, startingComputer, deadline, maxSteps);
+	statsEnd(net);
+	return res;
+}
+
+// 取得点到点查询的缓冲区，第一次使用时创建，内存不足时返回NULL
+static BidirScratch *networkBidirScratch(Network *net)
+{
+	BidirScratch *scratch = &net->bidir;
+	if (!scratch->forwardTime)
+	{
+		long long start = statsClock(net);
+		int numComputers = net->graph->numComputers;
+		int *forwardTime = (int *)malloc(numComputers * sizeof(int));
+		int *parent = (int *)malloc(numComputers * sizeof(int));
+		int *backwardTime = (int *)malloc(numComputers * sizeof(int));
+		int *next = (int *)malloc(numComputers * sizeof(int));
+		int *touched = (int *)malloc(numComputers * sizeof(int));
+		if (!forwardTime || !parent || !backwardTime || !next || !touched)
+		{
+			free(forwardTime);
+			free(parent);
+			free(backwardTime);
+			free(next);
+			free(touched);
+			return NULL;
+		}
+		for (int i = 0; i < numComputers; i++)
+		{
+			forwardTime[i] = INT_MAX;
+			backwardTime[i] = INT_MAX;
+		}
+		scratch->forwardTime = forwardTime;
+		scratch->parent = parent;
+		scratch->backwardTime = backwardTime;
+		scratch->next = next;
+		scratch->touched = touched;
+		statsPhase(net, PHASE_BUILD, start);
+	}
+	return scratch;
+}
+
+// networkInfectionPath的搜索循环：两侧队列中已经放好源与目标，touched[]中已有*numTouched台计算机。
+// 更新*mu、*meet与*numTouched，队列内存不足时返回false(被改过的计算机仍然都在touched[]中)。
+// 与dijkstraSearch相同，stats为常量NULL的一份不含计数代码
+static inline __attribute__((always_inline)) bool bidirSearch(Graph *graph, Graph *attack, BidirScratch *scratch,
+															  PQueue *forward, PQueue *backward, int *numTouched,
+															  long long *mu, int *meet, QueryStats *stats)
+{
+	const int *poodleTime = graph->poodleTime;
+	int *forwardTime = scratch->forwardTime;
+	int *backwardTime = scratch->backwardTime;
+
+	long long lastForward = 0, lastBackward = 0;
+	while (!pqIsEmpty(forward) && !pqIsEmpty(backward))
+	{
+		if (lastForward <= lastBackward)
+		{
+			int u = pqPopMin(forward, NULL);
+			if (u < 0)
+				return false;
+			lastForward = forwardTime[u];
+			if (stats)
+				stats->pops++;
+			if (lastForward + lastBackward >= *mu)
+				break;
+
+			if (stats)
+			{
+				int kept = attack->offsets[u + 1] - attack->offsets[u];
+				stats->settled++;
+				stats->edgesScanned += kept;
+				stats->permissionRejections += graph->offsets[u + 1] - graph->offsets[u] - kept;
+			}
+			for (int e = attack->offsets[u]; e < attack->offsets[u + 1]; e++)
+			{
+				int v = attack->dest[e];
+				int newTime = forwardTime[u] + attack->transmissionTime[e] + poodleTime[v];
+				if (newTime >= forwardTime[v])
+					continue;
+
+				if (stats)
+				{
+					if (forwardTime[v] == INT_MAX)
+						stats->pushes++;
+					else
+						stats->decreaseKeys++;
+				}
+				if (forwardTime[v] == INT_MAX && backwardTime[v] == INT_MAX)
+					scratch->touched[(*numTouched)++] = v;
+				forwardTime[v] = newTime;
+				scratch->parent[v] = u;
+				if (!pqPush(forward, v, PQ_KEY(newTime, v)))
+					return false;
+				if (backwardTime[v] != INT_MAX && (long long)newTime + backwardTime[v] < *mu)
+				{
+					*mu = (long long)newTime + backwardTime[v];
+					*meet = v;
+				}
+			}
+		}
+		else
+		{
+			int v = pqPopMin(backward, NULL);
+			if (v < 0)
+				return false;
+			lastBackward = backwardTime[v];
+			if (stats)
+				stats->pops++;
+			if (lastForward + lastBackward >= *mu)
+				break;
+
+			if (stats)
+				stats->settled++;
+			int level = GRAPH_LEVEL(graph, v);
+			for (int e = graph->offsets[v]; e < graph->offsets[v + 1]; e++)
+			{
+				int u = graph->dest[e];
+				if (GRAPH_LEVEL(graph, u) + 1 < level)
+				{
+					if (stats)
+						stats->permissionRejections++;
+					continue;
+				}
+				if (stats)
+					stats->edgesScanned++;
+				int newTime = backwardTime[v] + graph->transmissionTime[e] + poodleTime[v];
+				if (newTime >= backwardTime[u])
+					continue;
+
+				if (stats)
+				{
+					if (backwardTime[u] == INT_MAX)
+						stats->pushes++;
+					else
+						stats->decreaseKeys++;
+				}
+				if (forwardTime[u] == INT_MAX && backwardTime[u] == INT_MAX)
+					scratch->touched[(*numTouched)++] = u;
+				backwardTime[u] = newTime;
+				scratch->next[u] = v;
+				if (!pqPush(backward, u, PQ_KEY(newTime, u)))
+					return false;
+				if (forwardTime[u] != INT_MAX && (long long)forwardTime[u] + newTime < *mu)
+				{
+					*mu = (long long)forwardTime[u] + newTime;
+					*meet = u;
+				}
+			}
+		}
+	}
+	return true;
+}
+
+// 双向Dijkstra
+//
+// 正向搜索与dijkstraFrom相同：u入侵v(要求level(u) + 1 >= level(v))的代价为传输时间加上v的poodleTime，
+// 起点的时间为源的poodleTime。反向搜索从目标出发沿同一条边反向走：
+// 弹出v时，对每个能入侵v的邻居u(同样要求level(u) + 1 >= level(v))，u到目标的时间为
+// v到目标的时间 + 传输时间 + v的poodleTime，目标自身为0。
+// 一台计算机两侧的时间之和就是一条经过它的入侵路径的总时间，mu记录其中最小的一条。
+//
+// 每次扩展最近弹出的键较小的一侧(两侧的搜索半径保持接近)。弹出的键加上另一侧最近弹出的键
+// 不小于mu时，之后任何经过未扫描计算机的路径都不会更短，停止；任一侧队列为空时同样停止
+// (例如正向搜索结束时目标的正向时间已经确定，而目标的反向时间为0)。
+static InfectionPath infectionPath(Network *net, int sourceComputer, int targetComputer)
+{
+	InfectionPath res = {-1, 0, NULL};
+
+	// 正向沿攻击图的出边扩展；反向需要的是入边，攻击图不保存入边，所以沿无向图扩展并检查安全等级
+	Graph *graph = net->graph;
+	Graph *attack = networkAttackGraph(net);
+	const int *poodleTime = graph->poodleTime;
+	int numComputers = graph->numComputers;
+	BidirScratch *scratch = networkBidirScratch(net);
+	PQueue *forward = reuseQueue(net, &net->queue, numComputers);
+	PQueue *backward = reuseQueue(net, &net->backwardQueue, numComputers);
+	if (!attack || !scratch || !forward || !backward)
+		return res;
+	sourceComputer = GRAPH_POSITION(graph, sourceComputer);
+	targetComputer = GRAPH_POSITION(graph, targetComputer);
+
+	long long start = statsClock(net);
+	statsEngine(net, queueName(forward));
+	int *forwardTime = scratch->forwardTime;
+	int *backwardTime = scratch->backwardTime;
+	int numTouched = 0;
+
+	forwardTime[sourceComputer] = poodleTime[sourceComputer];
+	scratch->parent[sourceComputer] = -1;
+	scratch->touched[numTouched++] = sourceComputer;
+	bool ok = pqPush(forward, sourceComputer, PQ_KEY(forwardTime[sourceComputer], sourceComputer));
+	if (backwardTime[targetComputer] == INT_MAX && forwardTime[targetComputer] == INT_MAX)
+		scratch->touched[numTouched++] = targetComputer;
+	backwardTime[targetComputer] = 0;
+	scratch->next[targetComputer] = -1;
+	ok = ok && pqPush(backward, targetComputer, PQ_KEY(0, targetComputer));
+	if (net->stats)
+		net->stats->pushes += 2;
+
+	long long mu = LLONG_MAX;
+	int meet = -1;
+	if (sourceComputer == targetComputer)
+	{
+		mu = forwardTime[sourceComputer];
+		meet = sourceComputer;
+	}
+
+	// 按是否统计各展开一份搜索循环
+	if (ok && net->stats)
+		ok = bidirSearch(graph, attack, scratch, forward, backward, &numTouched, &mu, &meet, net->stats);
+	else if (ok)
+		ok = bidirSearch(graph, attack, scratch, forward, backward, &numTouched, &mu, &meet, NULL);
+	statsPhase(net, PHASE_SEARCH, start);
+	start = statsClock(net);
+
+	res.time = ok ? INT_MAX : -1;
+	if (ok && meet != -1)
+	{
+		// 路径 = 源 -> ... -> meet(沿parent回溯) + meet -> ... -> 目标(沿next前进)
+		int length = 0;
+		for (int v = meet; v != -1; v = scratch->parent[v])
+			length++;
+		for (int v = scratch->next[meet]; v != -1; v = scratch->next[v])
+			length++;
+
+		statsAlloc(net, (long long)length * sizeof(int));
+		res.computers = (int *)malloc(length * sizeof(int));
+		if (res.computers)
+		{
+			int i = 0;
+			for (int v = meet; v != -1; v = scratch->parent[v])
+				res.computers[i++] = GRAPH_LABEL(graph, v);
+			for (int a = 0, b = i - 1; a < b; a++, b--)
+			{
+				int temp = res.computers[a];
+				res.computers[a] = res.computers[b];
+				res.computers[b] = temp;
+			}
+			for (int v = scratch->next[meet]; v != -1; v = scratch->next[v])
+				res.computers[i++] = GRAPH_LABEL(graph, v);
+			res.time = (int)mu;
+			res.length = length;
+		}
+		else
+		{
+			res.time = -1;
+		}
+	}
+	statsPhase(net, PHASE_RESULT, start);
+
+	// 恢复缓冲区
+	for (int i = 0; i < numTouched; i++)
+	{
+		forwardTime[scratch->touched[i]] = INT_MAX;
+		backwardTime[scratch->touched[i]] = INT_MAX;
+	}
+	pqClear(forward);
+	pqClear(backward);
+
+	return res;
+}
+
+InfectionPath networkInfectionPath(Network *net, int sourceComputer, int targetComputer)
+{
+	statsBegin(net, "infectionPath");
+	InfectionPath res = infectionPath(net, sourceComputer, targetComputer);
+	statsEnd(net);
+	return res;
+}
+
+void freeInfectionPath(InfectionPath path)
+{
+	free(path.computers);
+}
+
+// 全源扫描时传给线程池的参数
+typedef struct Sweep
+{
+	Graph *attack;
+	SweepScratch *workerScratch;
+	SourceSummary *summaries;
+} Sweep;
+
+// 第p百分位的入侵时间(最近秩法)：按入侵顺序排在第ceil(p% · reached)位的计算机的时间
+static int percentileTime(const int time[], const int order[], int reached, int p)
+{
+	int rank = (int)(((long long)p * reached + 99) / 100);
+	return time[order[rank - 1]];
+}
+
+static void sweepTask(void *context, int worker, int begin, int end)
+{
+	Sweep *sweep = (Sweep *)context;
+	SweepScratch *scratch = &sweep->workerScratch[worker];
+	for (int s = begin; s < end; s++)
+	{
+		// 出队顺序就是入侵时间的升序，百分位直接按order[]取，不需要排序。
+		// 基数堆要求键单调，换一个源之前必须清空(重置其当前最小键)
+		pqClear(scratch->queue);
+		int reached =
+			dijkstraFrom(sweep->attack, scratch->queue, s, scratch->time, NULL, scratch->order, NO_LIMIT, NULL);
+		if (reached < 0)
+		{
+			// 不知道哪些计算机的时间被改过，整个恢复
+			for (int v = 0; v < sweep->attack->numComputers; v++)
+			{
+				scratch->time[v] = INT_MAX;
+			}
+			scratch->failed = true;
+			return;
+		}
+		SourceSummary *summary = &sweep->summaries[GRAPH_LABEL(sweep->attack, s)];
+		summary->reached = reached;
+		summary->fullSpreadTime = scratch->time[scratch->order[reached - 1]];
+		summary->p50 = percentileTime(scratch->time, scratch->order, reached, 50);
+		summary->p90 = percentileTime(scratch->time, scratch->order, reached, 90);
+		summary->p99 = percentileTime(scratch->time, scratch->order, reached, 99);
+
+		for (int i = 0; i < reached; i++)
+		{
+			scratch->time[scratch->order[i]] = INT_MAX;
+		}
+	}
+}
+
+// 每个工作者每次领取一个源：一次搜索的代价远大于领取任务的一次原子操作，
+// 而不同源的到达范围相差悬殊，逐个领取才能让各线程同时结束
+#define SWEEP_CHUNK 1
+
+static bool sourceSummaries(Network *net, SourceSummary summaries[], int numThreads)
+{
+	Graph *attack = networkAttackGraph(net);
+	if (!attack || !networkPool(net, numThreads))
+		return false;
+
+	// 为每个工作者准备临时缓冲区，队列的种类跟随当前引擎
+	int numComputers = net->graph->numComputers;
+	int workers = threadPoolSize(net->pool);
+	if (net->numWorkerScratch < workers)
+	{
+		SweepScratch *scratch = (SweepScratch *)realloc(net->workerScratch, workers * sizeof(SweepScratch));
+		if (!scratch)
+			return false;
+		net->workerScratch = scratch;
+		for (int i = net->numWorkerScratch; i < workers; i++)
+		{
+			scratch[i].time = (int *)malloc(numComputers * sizeof(int));
+			scratch[i].order = (int *)malloc(numComputers * sizeof(int));
+			scratch[i].queue = NULL;
+			if (!scratch[i].time || !scratch[i].order)
+			{
+				free(scratch[i].time);
+				free(scratch[i].order);
+				return false;
+			}
+			for (int v = 0; v < numComputers; v++)
+			{
+				scratch[i].time[v] = INT_MAX;
+			}
+			net->numWorkerScratch++;
+		}
+	}
+	for (int i = 0; i < workers; i++)
+	{
+		if (!reuseQueue(net, &net->workerScratch[i].queue, numComputers))
+			return false;
+		net->workerScratch[i].failed = false;
+	}
+
+	long long start = statsClock(net);
+	Sweep sweep = {attack, net->workerScratch, summaries};
+	threadPoolRun(net->pool, numComputers, SWEEP_CHUNK, sweepTask, &sweep);
+	statsPhase(net, PHASE_SEARCH, start);
+
+	bool ok = true;
+	for (int i = 0; i < workers; i++)
+	{
+		ok = ok && !net->workerScratch[i].failed;
+	}
+	return ok;
+}
+
+bool networkSourceSummaries(Network *net, SourceSummary summaries[], int numThreads)
+{
+	statsBegin(net, "sourceSummaries");
+	bool ok = sourceSummaries(net, summaries, numThreads);
+	statsEnd(net);
+	return ok;
+}
+
+////////////////////////////////////////////////////////////////////////
+// Task 4
+
+// 一次性的(计算机, 安全等级)状态空间搜索
+//
+// 状态(v, l)表示v已被一只安全等级为l的pug入侵，l = max(v自身的等级, 入侵者的等级)。
+// 从(u, l)出发可以入侵安全等级不超过l + 1的邻居v，得到状态(v, max(l, level(v)))，
+// 代价为传输时间加上v的poodleTime。起点为(source, level(source))。
+// 每台计算机的最早入侵时间就是它所有状态中最小的时间。
+// 因为MAX_SECURITY_LEVEL只有10，状态数为V·L，一次Dijkstra即可得到全部结果，
+// 复杂度为O((V·L + E·L) log(V·L))，取代了原先按sourceQueue逐个重跑Dijkstra的做法。
+//
+// 剪枝：状态按时间顺序出队，若v的某个等级不低于l的状态已经出队，
+// 则(v, l)被它支配(更早且能入侵的范围更大)，无需再展开。
+#define NUM_LEVELS MAX_SECURITY_LEVEL
+#define STATE_ID(v, level) ((v) * NUM_LEVELS + (level) - 1)
+
+// 取得advancedPoodle的缓冲区，第一次使用时创建，内存不足时返回NULL
+static StateScratch *networkStateScratch(Network *net)
+{
+	StateScratch *scratch = &net->states;
+	if (!scratch->stateTime)
+	{
+		long long start = statsClock(net);
+		int numComputers = net->graph->numComputers;
+		int numStates = numComputers * NUM_LEVELS;
+		int *stateTime = (int *)malloc(numStates * sizeof(int));
+		char *settledLevel = (char *)calloc(numComputers, sizeof(char));
+		int *order = (int *)malloc(numComputers * sizeof(int));
+		int *orderTime = (int *)malloc(numComputers * sizeof(int));
+		if (!stateTime || !settledLevel || !order || !orderTime)
+		{
+			free(stateTime);
+			free(settledLevel);
+			free(order);
+			free(orderTime);
+			return NULL;
+		}
+		for (int i = 0; i < numStates; i++)
+		{
+			stateTime[i] = INT_MAX;
+		}
+		scratch->stateTime = stateTime;
+		scratch->settledLevel = settledLevel;
+		scratch->order = order;
+		scratch->orderTime = orderTime;
+		statsPhase(net, PHASE_BUILD, start);
+	}
+	return scratch;
+}
+
+// 队列内存不足时放弃本次搜索：不知道哪些状态被访问过，整个恢复缓冲区并清空队列
+static int abandonStateSearch(Graph *graph, PQueue *pq, StateScratch *scratch)
+{
+	int numComputers = graph->numComputers;
+	for (int i = 0; i < numComputers * NUM_LEVELS; i++)
+	{
+		scratch->stateTime[i] = INT_MAX;
+	}
+	memset(scratch->settledLevel, 0, numComputers * sizeof(char));
+	pqClear(pq);
+	return 0;
+}
+
+// 按最早入侵的先后顺序把计算机与其时间写入scratch->order[]与scratch->orderTime[]，返回其数量。
+// 出队顺序为(时间, 状态编号)，所以时间相同时编号小的计算机在前。
+// 达到limit时立即停止；结束前只恢复被访问过的状态，代价与访问的范围成正比。
+// 队列内存不足时返回0。
+//
+// stats不为NULL时统计队列操作、边与按更高等级再次展开的次数(相当于原先从sourceQueue重跑的轮数)。
+// 与dijkstraSearch相同，总是内联进advancedSearch，stats为常量NULL的一份不含计数代码。
+static inline __attribute__((always_inline)) int stateSearch(Graph *graph, PQueue *pq, StateScratch *scratch,
+															 int sourceComputer, SearchLimit limit,
+															 QueryStats *stats)
+{
+	const int *poodleTime = graph->poodleTime;
+	int *stateTime = scratch->stateTime;
+	char *settledLevel = scratch->settledLevel;
+
+	// 键中的平局编号用原编号的状态编号，出队顺序与重排无关
+	int sourceLevel = GRAPH_LEVEL(graph, sourceComputer);
+	int start = STATE_ID(sourceComputer, sourceLevel);
+	stateTime[start] = poodleTime[sourceComputer];
+	if (!pqPush(pq, start, PQ_KEY(stateTime[start], STATE_ID(GRAPH_LABEL(graph, sourceComputer), sourceLevel))))
+		return abandonStateSearch(graph, pq, scratch);
+	if (stats)
+		stats->pushes++;
+
+	int stepCount = 0;
+	while (!pqIsEmpty(pq))
+	{
+		uint64_t key;
+		int id = pqPopMin(pq, &key);
+		if (id < 0)
+			return abandonStateSearch(graph, pq, scratch);
+		int u = id / NUM_LEVELS;
+		int level = id % NUM_LEVELS + 1;
+		if (stats)
+			stats->pops++;
+
+		if (stateTime[id] > limit.deadline || stepCount >= limit.maxSteps)
+		{
+			pqPush(pq, id, key); // 之后出队的状态都不会再产生新的步骤
+			break;
+		}
+		if (settledLevel[u] >= level)
+			continue; // 被u上更早出队的更高等级状态支配
+
+		if (settledLevel[u] == 0)
+		{
+			// u第一次被入侵
+			scratch->order[stepCount] = u;
+			scratch->orderTime[stepCount] = stateTime[id];
+			stepCount++;
+		}
+		else if (stats)
+		{
+			stats->levelUpgrades++;
+		}
+		settledLevel[u] = level;
+
+		for (int e = graph->offsets[u]; e < graph->offsets[u + 1]; e++)
+		{
+			int v = graph->dest[e];
+			int vLevel = GRAPH_LEVEL(graph, v);
+			if (vLevel > level + 1)
+			{
+				if (stats)
+					stats->permissionRejections++;
+				continue; // 权限不足
+			}
+			if (stats)
+				stats->edgesScanned++;
+
+			int newLevel = vLevel > level ? vLevel : level;
+			if (settledLevel[v] >= newLevel)
+				continue;
+
+			int sid = STATE_ID(v, newLevel);
+			int newTime = stateTime[id] + graph->transmissionTime[e] + poodleTime[v];
+			if (newTime < stateTime[sid])
+			{
+				if (stats)
+				{
+					if (stateTime[sid] == INT_MAX)
+						stats->pushes++;
+					else
+						stats->decreaseKeys++;
+				}
+				stateTime[sid] = newTime;
+				if (!pqPush(pq, sid, PQ_KEY(newTime, STATE_ID(GRAPH_LABEL(graph, v), newLevel))))
+					return abandonStateSearch(graph, pq, scratch);
+			}
+		}
+	}
+	if (stats)
+		stats->settled += stepCount;
+
+	// 恢复缓冲区：出队过的状态都属于order[]中的计算机，其余被访问过的状态都还在队列中
+	for (int i = 0; i < stepCount; i++)
+	{
+		int u = scratch->order[i];
+		settledLevel[u] = 0;
+		for (int level = 1; level <= NUM_LEVELS; level++)
+		{
+			stateTime[STATE_ID(u, level)] = INT_MAX;
+		}
+	}
+	while (!pqIsEmpty(pq))
+	{
+		int id = pqPopMin(pq, NULL);
+		if (id < 0)
+			return abandonStateSearch(graph, pq, scratch);
+		stateTime[id] = INT_MAX;
+	}
+
+	return stepCount;
+}
+
+// 见stateSearch。按是否统计各展开一份搜索，每次查询只判断一次
+static int advancedSearch(Network *net, StateScratch *scratch, int sourceComputer, SearchLimit limit)
+{
+	Graph *graph = net->graph;
+	PQueue *pq = reuseQueue(net, &net->stateQueue, graph->numComputers * NUM_LEVELS);
+	if (!pq)
+		return 0;
+
+	statsEngine(net, queueName(pq));
+	if (net->stats)
+		return stateSearch(graph, pq, scratch, sourceComputer, limit, net->stats);
+	return stateSearch(graph, pq, scratch, sourceComputer, limit, NULL);
+}
+
+// 由advancedSearch的结果构建poodleResult(没有接收者)
+static struct poodleResult advancedResult(Network *net, int sourceComputer, SearchLimit limit, Arena *arena)
+{
+	struct poodleResult res = {0, NULL};
+
+	StateScratch *scratch = networkStateScratch(net);
+	if (!scratch)
+		return res;
+
+	// 搜索结果已经按(时间, 计算机编号)升序排列，不需要再排序
+	long long start = statsClock(net);
+	int stepCount = advancedSearch(net, scratch, GRAPH_POSITION(net->graph, sourceComputer), limit);
+	statsPhase(net, PHASE_SEARCH, start);
+	if (stepCount == 0)
+		return res;
+
+	start = statsClock(net);
+	statsAlloc(net, resultBytes(stepCount, false));
+	res.steps = (struct step *)(arena ? arenaAlloc(arena, stepCount * sizeof(struct step))
+									  : malloc(stepCount * sizeof(struct step)));
+	if (!res.steps)
+		return res;
+	res.numSteps = stepCount;
+
+	// 填充步骤信息
+	for (int i = 0; i < stepCount; i++)
+	{
+		res.steps[i].computer = GRAPH_LABEL(net->graph, scratch->order[i]);
+		res.steps[i].time = scratch->orderTime[i];
+		res.steps[i].recipients = NULL;
+	}
+	statsPhase(net, PHASE_RESULT, start);
+
+	return res;
+}
+
+// advancedResult加上查询统计的开始与结束
+static struct poodleResult advancedQuery(Network *net, const char *query, int sourceComputer, SearchLimit limit,
+										 Arena *arena)
+{
+	statsBegin(net, query);
+	struct poodleResult res = advancedResult(net, sourceComputer, limit, arena);
+	statsEnd(net);
+	return res;
+}
+
+struct poodleResult networkAdvancedPoodle(Network *net, int sourceComputer)
+{
+	return networkAdvancedPoodleInArena(net, sourceComputer, NULL);
+}
+
+struct poodleResult networkAdvancedPoodleInArena(Network *net, int sourceComputer, Arena *arena)
+{
+	return advancedQuery(net, "advancedPoodle", sourceComputer, NO_LIMIT, arena);
+}
+
+struct poodleResult networkAdvancedPoodleBounded(Network *net, int sourceComputer, int deadline, int maxSteps)
+{
+	SearchLimit limit = {deadline, maxSteps};
+	return advancedQuery(net, "advancedPoodleBounded", sourceComputer, limit, NULL);
+}
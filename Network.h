@@ -0,0 +1,161 @@
+#ifndef NETWORK_H
+#define NETWORK_H
+
+#include <stdbool.h>
+
+#include "Arena.h"
+#include "Graph.h"
+#include "InfectionTree.h"
+#include "QueryStats.h"
+#include "poodle.h"
+
+// 可重复使用的网络句柄
+// 用computers[]/connections[]打开一次，之后可以对同一个网络执行任意多次
+// probe / chooseSource / poodle / advancedPoodle 查询，最后关闭。
+// 建图只在openNetwork中发生一次，查询之间会复用句柄内部的临时缓冲区。
+//
+// 注意：
+// - 图中保存了计算机属性的副本(见Graph.h)，computers[]与connections[]在openNetwork返回后即可释放。
+// - 同一个句柄上的查询不是线程安全的(networkProbePathBatch在内部使用多个线程)。
+typedef struct Network Network;
+
+// 打开网络句柄，内存不足时返回NULL
+Network *openNetwork(struct computer computers[], int numComputers,
+                     struct connection connections[], int numConnections);
+
+// 与openNetwork相同，但句柄内部的图按order重排(见buildGraphOrdered)，使相邻的计算机在各个数组中也相邻。
+// 所有接口的参数与结果仍然使用调用者的编号，结果与openNetwork打开的句柄完全相同。
+Network *openNetworkOrdered(struct computer computers[], int numComputers,
+                            struct connection connections[], int numConnections, GraphOrder order);
+
+// 从二进制快照(见Loader.h)打开句柄：图的数组直接映射自文件，不需要建图，也不拷贝数据。
+// 计算机的属性同样来自快照。verify见mapSnapshot。
+// 文件不存在、不是合法的快照或内存不足时返回NULL。
+Network *openNetworkSnapshot(const char *filename, bool verify);
+
+// 关闭句柄并释放其全部内存(NULL安全)
+void closeNetwork(Network *net);
+
+// poodle(Task 3)使用的最短路引擎。所有引擎的结果完全相同，只影响性能。
+typedef enum PoodleEngine
+{
+    ENGINE_BINARY_HEAP, // 带decrease-key的索引二叉堆
+    ENGINE_QUAD_HEAP,   // 带decrease-key的索引4叉堆
+    ENGINE_RADIX_HEAP,  // 单调基数堆，利用入侵时间是整数且单调不减
+    ENGINE_DELTA_STEPPING, // 多线程delta-stepping(见DeltaStepping.h)，用于单次查询延迟敏感的大网络
+    ENGINE_BUCKET,      // 桶队列/BFS(见BucketSearch.h)，边权不全为正或桶太多时退回基数堆
+    ENGINE_DENSE,       // 边权矩阵上的SIMD数组扫描(见DenseSearch.h)，计算机超过DENSE_MAX_COMPUTERS时退回基数堆
+    ENGINE_AUTO,        // 根据攻击图选择(默认)：边数不少于V² / DENSE_AUTO_DENSITY(且CPU支持SIMD核)时用数组扫描，
+                        // 否则桶数量不超过BUCKET_AUTO_MAX_BUCKETS时用桶，再否则用基数堆
+} PoodleEngine;
+
+void setPoodleEngine(Network *net, PoodleEngine engine);
+
+// ENGINE_DELTA_STEPPING使用的线程数，<= 0 (默认)时使用全部CPU核。线程池与批量probePath共用。
+void setPoodleThreads(Network *net, int numThreads);
+
+// 开启(stats不为NULL)或关闭(NULL，默认)查询统计(见QueryStats.h)。
+// 开启后，下面的每个查询开始时都清零*stats，并在返回前填入本次查询的计数与各阶段耗时
+// (多线程的networkProbePathBatch与networkSourceSummaries只记录耗时)。
+// *stats由调用者持有，在关闭统计或关闭句柄之前必须保持有效。统计不改变任何查询的结果。
+void setQueryStats(Network *net, QueryStats *stats);
+
+// Task 1
+struct probePathResult networkProbePath(Network *net, int path[], int pathLength);
+
+// 批量探测numPaths条路径，第p条路径为pathNodes[pathOffsets[p]]到pathNodes[pathOffsets[p + 1] - 1]，
+// 结果写入results[p]，与逐条调用networkProbePath的结果相同。
+// 路径分给numThreads个线程并行处理(numThreads <= 0 时使用全部CPU核)，
+// 线程池与每个线程的访问标记保存在句柄中，供之后的批次复用。
+// 内存不足或无法创建线程时返回false。
+bool networkProbePathBatch(Network *net, const int pathOffsets[], const int pathNodes[],
+                           int numPaths, struct probePathResult results[], int numThreads);
+
+// Task 2
+struct chooseSourceResult networkChooseSource(Network *net);
+
+// 计算每台计算机作为源时能入侵的计算机数量(含自身)，写入reachCount[]
+// (长度为计算机数量)，用于按风险对所有候选源排序。内存不足时返回false。
+bool networkReachCounts(Network *net, int reachCount[]);
+
+// Task 3
+// 结果的步骤数组与全部接收者节点(computerList)在同一块内存中，构建代价与网络规模成线性。
+// 必须用freePoodleResult整体释放，不能逐个free接收者节点
+// (poodle.h中的poodle()会转换成逐个分配节点的形式)。
+struct poodleResult networkPoodle(Network *net, int startingComputer);
+
+// 释放networkPoodle或networkAdvancedPoodle返回的结果
+void freePoodleResult(struct poodleResult res);
+
+// 与networkPoodle相同，但结果从arena中分配：不能用freePoodleResult释放，
+// 而是与同一区域中的其他结果一起，用一次arenaReset或freeArena释放。
+// 适合一次请求中执行多个查询、最后整体丢弃结果的场景。
+struct poodleResult networkPoodleInArena(Network *net, int startingComputer, Arena *arena);
+
+// 做一次poodle搜索并保留其最短入侵树(见InfectionTree.h)，之后查询任意计算机的入侵路径、
+// 子树大小都不需要重新搜索。用freeInfectionTree释放，内存不足时返回NULL。
+InfectionTree *networkInfectionTree(Network *net, int startingComputer);
+
+// 一次搜索同时得到networkPoodle的结果与入侵树(*tree，内存不足时为NULL)，分别释放
+struct poodleResult networkPoodleWithTree(Network *net, int startingComputer, InfectionTree **tree);
+
+// 提前终止的poodle查询，用于"T秒之内哪些计算机会被入侵"或"最先被入侵的K台计算机"：
+// 只返回networkPoodle完整结果的前缀，即入侵时间不超过deadline、并且排在前maxSteps位的步骤
+// (不限制时传INT_MAX)。步骤的顺序与时间和完整结果相同，接收者只包括结果之内的计算机。
+// 搜索在条件满足时立即停止，句柄中的缓冲区在查询之间保持初始状态、每次只恢复被访问过的部分，
+// 所以代价只与结果及其边界的规模有关，与网络规模无关。用freePoodleResult释放。
+struct poodleResult networkPoodleBounded(Network *net, int startingComputer, int deadline, int maxSteps);
+
+// 点到点查询的结果
+typedef struct InfectionPath
+{
+    int time;       // 目标最早被入侵的时间，无法入侵时为INT_MAX，内存不足时为-1
+    int length;     // 路径上的计算机数量(含源与目标)，无法入侵时为0
+    int *computers; // 从源到目标的一条入侵路径，用freeInfectionPath释放
+} InfectionPath;
+
+// "攻击从source开始时，target何时被入侵"：用双向Dijkstra只搜索源与目标附近的部分网络。
+// time与networkPoodle中target的时间相同；有多条最短入侵路径时返回其中一条，
+// 不一定是networkPoodle的入侵树中的那一条。
+InfectionPath networkInfectionPath(Network *net, int sourceComputer, int targetComputer);
+
+void freeInfectionPath(InfectionPath path);
+
+// 由一棵入侵树构建与networkPoodle格式相同的结果。
+// order[]为按入侵先后排列的stepcount台计算机，parent[v]为入侵v的计算机(起点与无法入侵的为-1)。
+// arena为NULL时结果用malloc分配(用freePoodleResult释放)，否则从arena中分配。
+// 内存不足时返回{0, NULL}。
+struct poodleResult buildPoodleResult(const int time[], const int parent[], const int order[],
+                                      int numComputers, int stepcount, Arena *arena);
+
+// 以某台计算机为源的入侵范围摘要
+typedef struct SourceSummary
+{
+    int reached;        // 能入侵的计算机数量(含源本身)
+    int fullSpreadTime; // 最后一台能入侵的计算机被入侵的时间
+    int p50;            // 入侵时间的第50/90/99百分位(最近秩法：至少p%的计算机在此时间之前被入侵)
+    int p90;
+    int p99;
+} SourceSummary;
+
+// 以每一台计算机为源各做一次poodle搜索，摘要写入summaries[](长度为计算机数量)。
+// 源分给numThreads个线程(numThreads <= 0 时使用全部CPU核)动态领取，
+// 每个线程复用自己的time/order/优先队列，这些缓冲区保存在句柄中供之后的扫描复用。
+// 内存不足或无法创建线程时返回false。
+bool networkSourceSummaries(Network *net, SourceSummary summaries[], int numThreads);
+
+// 只计算从startingComputer出发每台计算机最早被入侵的时间，不构建poodleResult。
+// time[]由调用者提供，长度为计算机数量，无法入侵的计算机为INT_MAX。
+// 返回能被入侵的计算机数量，内存不足时返回0(此时time[]的内容没有意义)。
+int networkInfectionTimes(Network *net, int startingComputer, int time[]);
+
+// Task 4
+struct poodleResult networkAdvancedPoodle(Network *net, int startingComputer);
+
+// 结果从arena中分配，见networkPoodleInArena
+struct poodleResult networkAdvancedPoodleInArena(Network *net, int startingComputer, Arena *arena);
+
+// networkAdvancedPoodle结果的前缀，含义与代价见networkPoodleBounded
+struct poodleResult networkAdvancedPoodleBounded(Network *net, int startingComputer, int deadline, int maxSteps);
+
+#endif // NETWORK_H
@@ -0,0 +1,341 @@
+#include "PQueue.h"
+#include <stdlib.h>
+
+#define RADIX_BUCKETS 65 // 键为64位，桶0存放与last相等的键
+#define KEY_NONE UINT64_MAX
+
+// 基数堆的桶
+typedef struct RadixBucket
+{
+    uint64_t *keys;
+    int *items;
+    int len;
+    int cap;
+} RadixBucket;
+
+struct PQueue
+{
+    PQueueKind kind;
+    int capacity;
+    int size; // 队列中(有效)元素的数量
+
+    // d叉堆
+    int arity;
+    uint64_t *heapKey; // 堆数组：键
+    int *heapItem;     // 堆数组：元素
+    int *pos;          // pos[item]为item在堆数组中的下标，不在堆中为-1
+
+    // 基数堆：过期的条目采用惰性删除
+    uint64_t last;     // 最近一次出队的键
+    uint64_t *curKey;  // curKey[item]为item当前的键，不在队列中为KEY_NONE
+    RadixBucket buckets[RADIX_BUCKETS];
+};
+
+PQueue *createPQueue(PQueueKind kind, int capacity)
+{
+    PQueue *pq = (PQueue *)calloc(1, sizeof(PQueue));
+    if (!pq)
+        return NULL;
+
+    pq->kind = kind;
+    pq->capacity = capacity;
+    pq->size = 0;
+
+    if (kind == PQ_RADIX_HEAP)
+    {
+        pq->curKey = (uint64_t *)malloc((capacity + 1) * sizeof(uint64_t));
+        if (!pq->curKey)
+        {
+            freePQueue(pq);
+            return NULL;
+        }
+        for (int i = 0; i < capacity; i++)
+        {
+            pq->curKey[i] = KEY_NONE;
+        }
+        pq->last = 0;
+    }
+    else
+    {
+        pq->arity = kind == PQ_QUAD_HEAP ? 4 : 2;
+        pq->heapKey = (uint64_t *)malloc((capacity + 1) * sizeof(uint64_t));
+        pq->heapItem = (int *)malloc((capacity + 1) * sizeof(int));
+        pq->pos = (int *)malloc((capacity + 1) * sizeof(int));
+        if (!pq->heapKey || !pq->heapItem || !pq->pos)
+        {
+            freePQueue(pq);
+            return NULL;
+        }
+        for (int i = 0; i < capacity; i++)
+        {
+            pq->pos[i] = -1;
+        }
+    }
+
+    return pq;
+}
+
+void freePQueue(PQueue *pq)
+{
+    if (pq)
+    {
+        free(pq->heapKey);
+        free(pq->heapItem);
+        free(pq->pos);
+        free(pq->curKey);
+        for (int b = 0; b < RADIX_BUCKETS; b++)
+        {
+            free(pq->buckets[b].keys);
+            free(pq->buckets[b].items);
+        }
+        free(pq);
+    }
+}
+
+PQueueKind pqKind(PQueue *pq)
+{
+    return pq->kind;
+}
+
+int pqCapacity(PQueue *pq)
+{
+    return pq->capacity;
+}
+
+bool pqIsEmpty(PQueue *pq)
+{
+    return pq->size == 0;
+}
+
+////////////////////////////////////////////////////////////////////////
+// d叉堆
+
+static void heapPlace(PQueue *pq, int i, uint64_t key, int item)
+{
+    pq->heapKey[i] = key;
+    pq->heapItem[i] = item;
+    pq->pos[item] = i;
+}
+
+static void heapSiftUp(PQueue *pq, int i, uint64_t key, int item)
+{
+    while (i > 0)
+    {
+        int parent = (i - 1) / pq->arity;
+        if (pq->heapKey[parent] <= key)
+            break;
+        heapPlace(pq, i, pq->heapKey[parent], pq->heapItem[parent]);
+        i = parent;
+    }
+    heapPlace(pq, i, key, item);
+}
+
+static void heapSiftDown(PQueue *pq, int i, uint64_t key, int item)
+{
+    int n = pq->size;
+    int arity = pq->arity;
+    for (;;)
+    {
+        int first = i * arity + 1;
+        if (first >= n)
+            break;
+
+        // 找出最小的孩子
+        int last = first + arity < n ? first + arity : n;
+        int best = first;
+        for (int c = first + 1; c < last; c++)
+        {
+            if (pq->heapKey[c] < pq->heapKey[best])
+                best = c;
+        }
+
+        if (pq->heapKey[best] >= key)
+            break;
+        heapPlace(pq, i, pq->heapKey[best], pq->heapItem[best]);
+        i = best;
+    }
+    heapPlace(pq, i, key, item);
+}
+
+static bool heapPush(PQueue *pq, int item, uint64_t key)
+{
+    int i = pq->pos[item];
+    if (i == -1)
+    {
+        heapSiftUp(pq, pq->size++, key, item);
+    }
+    else if (key < pq->heapKey[i])
+    {
+        heapSiftUp(pq, i, key, item);
+    }
+    return true;
+}
+
+static int heapPopMin(PQueue *pq, uint64_t *key)
+{
+    int item = pq->heapItem[0];
+    if (key)
+        *key = pq->heapKey[0];
+    pq->pos[item] = -1;
+
+    pq->size--;
+    if (pq->size > 0)
+    {
+        heapSiftDown(pq, 0, pq->heapKey[pq->size], pq->heapItem[pq->size]);
+    }
+    return item;
+}
+
+static void heapClear(PQueue *pq)
+{
+    for (int i = 0; i < pq->size; i++)
+    {
+        pq->pos[pq->heapItem[i]] = -1;
+    }
+    pq->size = 0;
+}
+
+////////////////////////////////////////////////////////////////////////
+// 基数堆
+
+static int radixBucketIndex(uint64_t last, uint64_t key)
+{
+    return key == last ? 0 : 64 - __builtin_clzll(key ^ last);
+}
+
+// 内存不足时返回false，桶保持不变
+static bool radixAppend(PQueue *pq, int b, uint64_t key, int item)
+{
+    RadixBucket *bucket = &pq->buckets[b];
+    if (bucket->len == bucket->cap)
+    {
+        int cap = bucket->cap ? bucket->cap * 2 : 16;
+        uint64_t *keys = (uint64_t *)realloc(bucket->keys, cap * sizeof(uint64_t));
+        if (!keys)
+            return false;
+        bucket->keys = keys;
+        int *items = (int *)realloc(bucket->items, cap * sizeof(int));
+        if (!items)
+            return false;
+        bucket->items = items;
+        bucket->cap = cap;
+    }
+    bucket->keys[bucket->len] = key;
+    bucket->items[bucket->len] = item;
+    bucket->len++;
+    return true;
+}
+
+static bool radixPush(PQueue *pq, int item, uint64_t key)
+{
+    uint64_t cur = pq->curKey[item];
+    if (cur != KEY_NONE && cur <= key)
+        return true;
+
+    if (!radixAppend(pq, radixBucketIndex(pq->last, key), key, item))
+        return false;
+
+    // decrease-key时旧条目留在原来的桶里，出队时发现键不匹配再丢弃
+    if (cur == KEY_NONE)
+        pq->size++;
+    pq->curKey[item] = key;
+    return true;
+}
+
+static int radixPopMin(PQueue *pq, uint64_t *key)
+{
+    for (;;)
+    {
+        RadixBucket *zero = &pq->buckets[0];
+        while (zero->len > 0)
+        {
+            zero->len--;
+            uint64_t k = zero->keys[zero->len];
+            int item = zero->items[zero->len];
+            if (pq->curKey[item] != k)
+                continue; // 过期条目
+
+            pq->curKey[item] = KEY_NONE;
+            pq->size--;
+            if (key)
+                *key = k;
+            return item;
+        }
+
+        // 桶0为空：找到第一个非空的桶，以其中最小的有效键为新的last重新分桶
+        int b = 1;
+        while (pq->buckets[b].len == 0)
+            b++;
+
+        RadixBucket *bucket = &pq->buckets[b];
+        uint64_t minKey = KEY_NONE;
+        for (int i = 0; i < bucket->len; i++)
+        {
+            uint64_t k = bucket->keys[i];
+            if (k < minKey && pq->curKey[bucket->items[i]] == k)
+                minKey = k;
+        }
+
+        int len = bucket->len;
+        bucket->len = 0;
+        if (minKey == KEY_NONE)
+            continue; // 整个桶都是过期条目
+
+        // 条目只会移到比b小的桶，这些桶原先都是空的，桶b中的条目在移动时也不会被改写，
+        // 所以内存不足时把它们清空、恢复桶b的长度与last，队列就回到了重新分桶之前
+        uint64_t last = pq->last;
+        pq->last = minKey;
+        for (int i = 0; i < len; i++)
+        {
+            uint64_t k = bucket->keys[i];
+            int item = bucket->items[i];
+            if (pq->curKey[item] == k && !radixAppend(pq, radixBucketIndex(minKey, k), k, item))
+            {
+                for (int t = 0; t < b; t++)
+                    pq->buckets[t].len = 0;
+                bucket->len = len;
+                pq->last = last;
+                return -1;
+            }
+        }
+    }
+}
+
+static void radixClear(PQueue *pq)
+{
+    for (int b = 0; b < RADIX_BUCKETS; b++)
+    {
+        RadixBucket *bucket = &pq->buckets[b];
+        for (int i = 0; i < bucket->len; i++)
+        {
+            pq->curKey[bucket->items[i]] = KEY_NONE;
+        }
+        bucket->len = 0;
+    }
+    pq->size = 0;
+    pq->last = 0;
+}
+
+////////////////////////////////////////////////////////////////////////
+
+bool pqPush(PQueue *pq, int item, uint64_t key)
+{
+    if (pq->kind == PQ_RADIX_HEAP)
+        return radixPush(pq, item, key);
+    return heapPush(pq, item, key);
+}
+
+int pqPopMin(PQueue *pq, uint64_t *key)
+{
+    if (pq->kind == PQ_RADIX_HEAP)
+        return radixPopMin(pq, key);
+    return heapPopMin(pq, key);
+}
+
+void pqClear(PQueue *pq)
+{
+    if (pq->kind == PQ_RADIX_HEAP)
+        radixClear(pq);
+    else
+        heapClear(pq);
+}
@@ -0,0 +1,48 @@
+#ifndef PQUEUE_H
+#define PQUEUE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// 可替换实现的索引优先队列(最小堆)
+// 元素是[0, capacity)内的整数编号，每个元素在队列中最多出现一次，
+// 支持decrease-key。键是64位无符号整数，键相同的元素出队顺序不确定，
+// 因此需要确定性顺序的调用者应把平局规则编码进键里(见PQ_KEY)。
+typedef enum PQueueKind
+{
+    PQ_BINARY_HEAP, // 二叉堆
+    PQ_QUAD_HEAP,   // 4叉堆：更浅，sift-down时一次比较的孩子在同一缓存行内
+    PQ_RADIX_HEAP,  // 基数堆：要求键单调(入队的键不小于最近一次出队的键)
+} PQueueKind;
+
+typedef struct PQueue PQueue;
+
+// 把入侵时间和平局编号组合成一个键：先比较时间，时间相同时编号小的优先。
+// Dijkstra中边权和点权都为正，新入队的时间严格大于当前出队的时间，
+// 所以组合键同样满足基数堆的单调性要求。
+#define PQ_KEY(time, tie) (((uint64_t)(uint32_t)(time) << 32) | (uint32_t)(tie))
+#define PQ_KEY_TIME(key) ((int)((key) >> 32))
+
+// 创建容量为capacity的队列，内存不足时返回NULL
+PQueue *createPQueue(PQueueKind kind, int capacity);
+
+// 释放队列(NULL安全)
+void freePQueue(PQueue *pq);
+
+PQueueKind pqKind(PQueue *pq);
+int pqCapacity(PQueue *pq);
+
+bool pqIsEmpty(PQueue *pq);
+
+// 若item不在队列中则以key入队；若已在队列中且key更小则降低其键，否则不做任何事。
+// 基数堆的桶需要扩容而内存不足时返回false，队列保持不变；d叉堆的空间在创建时已分配好，总是返回true
+bool pqPush(PQueue *pq, int item, uint64_t key);
+
+// 弹出键最小的元素，若key不为NULL则写入其键。队列不能为空。
+// 基数堆重新分桶时内存不足返回-1，队列保持不变；d叉堆不会失败
+int pqPopMin(PQueue *pq, uint64_t *key);
+
+// 清空队列，代价与队列中剩余元素数量成正比
+void pqClear(PQueue *pq);
+
+#endif // PQUEUE_H
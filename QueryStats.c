@@ -0,0 +1,53 @@
+#include "QueryStats.h"
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+const char *statsPhaseName(StatsPhase phase)
+{
+    switch (phase)
+    {
+    case PHASE_BUILD:
+        return "build";
+    case PHASE_SEARCH:
+        return "search";
+    case PHASE_RESULT:
+        return "result";
+    default:
+        return "unknown";
+    }
+}
+
+long long statsNowNs(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+void resetQueryStats(QueryStats *stats, const char *query)
+{
+    memset(stats, 0, sizeof(QueryStats));
+    stats->query = query;
+}
+
+// 查询与引擎名称都是库内部的常量字符串，不含需要转义的字符
+int formatQueryStatsJson(const QueryStats *stats, char buffer[], size_t size)
+{
+    char engine[64];
+    if (stats->engine)
+        snprintf(engine, sizeof(engine), "\"%s\"", stats->engine);
+    else
+        snprintf(engine, sizeof(engine), "null");
+
+    return snprintf(buffer, size,
+                    "{\"query\":\"%s\",\"engine\":%s,\"settled\":%lld,\"edgesScanned\":%lld,"
+                    "\"permissionRejections\":%lld,\"pushes\":%lld,\"pops\":%lld,\"decreaseKeys\":%lld,"
+                    "\"levelUpgrades\":%lld,\"allocatedBytes\":%lld,"
+                    "\"phaseNs\":{\"%s\":%lld,\"%s\":%lld,\"%s\":%lld},\"totalNs\":%lld}",
+                    stats->query ? stats->query : "", engine, stats->settled, stats->edgesScanned,
+                    stats->permissionRejections, stats->pushes, stats->pops, stats->decreaseKeys,
+                    stats->levelUpgrades, stats->allocatedBytes, statsPhaseName(PHASE_BUILD),
+                    stats->phaseNs[PHASE_BUILD], statsPhaseName(PHASE_SEARCH), stats->phaseNs[PHASE_SEARCH],
+                    statsPhaseName(PHASE_RESULT), stats->phaseNs[PHASE_RESULT], stats->totalNs);
+}
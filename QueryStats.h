@@ -0,0 +1,52 @@
+#ifndef QUERY_STATS_H
+#define QUERY_STATS_H
+
+#include <stddef.h>
+
+// 查询的计数器与分阶段计时(见Network.h中的setQueryStats)
+// 用于回答"这一次查询的时间花在哪里"：建图、队列操作、松弛、按更高等级重新展开，还是构建结果。
+// 统计默认关闭；关闭时热循环中没有任何计数代码(搜索函数按"统计/不统计"各编译出一份)。
+
+// 查询的阶段
+typedef enum StatsPhase
+{
+    PHASE_BUILD,  // 按需构建句柄缓存的结构：攻击图、边权矩阵、凝聚图、边索引、复用的缓冲区与队列(已构建过时为0)
+    PHASE_SEARCH, // 搜索本身
+    PHASE_RESULT, // 换回调用者的编号并构建结果(poodleResult、入侵树、路径等)
+    NUM_PHASES,
+} StatsPhase;
+
+// 一次查询的统计。每个查询入口开始时清零，所以内容总是描述句柄上最近的一次查询。
+// 不适用于某个查询或引擎的计数保持为0。
+typedef struct QueryStats
+{
+    const char *query;  // 查询入口，例如"poodle"、"advancedPoodle"、"infectionPath"
+    const char *engine; // 实际执行搜索的引擎(退回时为退回后的引擎)，没有搜索时为NULL
+
+    long long settled;              // 确定了入侵时间的计算机数量(infectionPath中两侧分别计数)
+    long long edgesScanned;         // 从已确定的计算机出发检查过的可入侵的边
+    long long permissionRejections; // 因安全等级不足而跳过的边
+    long long pushes;               // 入队(元素原先不在队列中)，只统计使用优先队列的搜索
+    long long pops;                 // 出队，含advancedPoodle中被支配而丢弃的状态
+    long long decreaseKeys;         // 降低队列中已有元素的键
+    long long levelUpgrades;        // advancedPoodle：已被入侵的计算机以更高等级再次展开的次数
+    long long allocatedBytes;       // 查询直接分配的工作数组与返回结果的字节数
+                                    // (不含句柄中复用的缓冲区、按需构建的结构、入侵树与引擎内部的数组)
+
+    long long phaseNs[NUM_PHASES]; // 各阶段的耗时(纳秒)
+    long long totalNs;             // 整个查询的耗时，不小于各阶段之和
+} QueryStats;
+
+const char *statsPhaseName(StatsPhase phase);
+
+// 单调时钟，单位为纳秒
+long long statsNowNs(void);
+
+// 清零并记录查询名称
+void resetQueryStats(QueryStats *stats, const char *query);
+
+// 把stats写成一行JSON(不含换行)，语义与snprintf相同：最多写入size - 1个字符并以'\0'结尾，
+// 返回完整输出所需的长度(不含'\0')，buffer可以为NULL(此时size必须为0)
+int formatQueryStatsJson(const QueryStats *stats, char buffer[], size_t size);
+
+#endif // QUERY_STATS_H
@@ -0,0 +1,323 @@
+#include "Reach.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+// 迭代版Tarjan算法，每台计算机所属SCC的编号写入component[]，返回SCC数量；内存不足返回-1
+static int tarjan(Graph *graph, int component[])
+{
+    int n = graph->numComputers;
+    int *index = (int *)malloc(n * sizeof(int));
+    int *low = (int *)malloc(n * sizeof(int));
+    bool *onStack = (bool *)calloc(n, sizeof(bool));
+    int *sccStack = (int *)malloc(n * sizeof(int));
+    int *callVertex = (int *)malloc(n * sizeof(int)); // 显式调用栈：当前节点
+    int *callEdge = (int *)malloc(n * sizeof(int));   // 显式调用栈：下一条待检查的边
+    if (!index || !low || !onStack || !sccStack || !callVertex || !callEdge)
+    {
+        free(index);
+        free(low);
+        free(onStack);
+        free(sccStack);
+        free(callVertex);
+        free(callEdge);
+        return -1;
+    }
+
+    for (int v = 0; v < n; v++)
+    {
+        index[v] = -1;
+    }
+
+    int counter = 0;
+    int sccTop = 0;
+    int numComponents = 0;
+
+    for (int root = 0; root < n; root++)
+    {
+        if (index[root] != -1)
+            continue;
+
+        int top = 0;
+        index[root] = low[root] = counter++;
+        sccStack[sccTop++] = root;
+        onStack[root] = true;
+        callVertex[0] = root;
+        callEdge[0] = graph->offsets[root];
+
+        while (top >= 0)
+        {
+            int u = callVertex[top];
+            int e = callEdge[top];
+
+            if (e < graph->offsets[u + 1])
+            {
+                callEdge[top]++;
+                int v = graph->dest[e];
+                if (index[v] == -1)
+                {
+                    // "递归"访问v
+                    index[v] = low[v] = counter++;
+                    sccStack[sccTop++] = v;
+                    onStack[v] = true;
+                    top++;
+                    callVertex[top] = v;
+                    callEdge[top] = graph->offsets[v];
+                }
+                else if (onStack[v] && index[v] < low[u])
+                {
+                    low[u] = index[v];
+                }
+                continue;
+            }
+
+            // u的所有边都已检查完毕
+            if (low[u] == index[u])
+            {
+                int w;
+                do
+                {
+                    w = sccStack[--sccTop];
+                    onStack[w] = false;
+                    component[w] = numComponents;
+                } while (w != u);
+                numComponents++;
+            }
+
+            top--;
+            if (top >= 0)
+            {
+                int p = callVertex[top];
+                if (low[u] < low[p])
+                    low[p] = low[u];
+            }
+        }
+    }
+
+    free(index);
+    free(low);
+    free(onStack);
+    free(sccStack);
+    free(callVertex);
+    free(callEdge);
+    return numComponents;
+}
+
+Condensation *buildCondensation(Graph *graph)
+{
+    int n = graph->numComputers;
+    Condensation *cond = (Condensation *)calloc(1, sizeof(Condensation));
+    if (!cond)
+        return NULL;
+
+    cond->numComputers = n;
+    cond->component = (int *)malloc(n * sizeof(int));
+    if (!cond->component)
+    {
+        freeCondensation(cond);
+        return NULL;
+    }
+
+    int c = tarjan(graph, cond->component);
+    if (c < 0)
+    {
+        freeCondensation(cond);
+        return NULL;
+    }
+    cond->numComponents = c;
+
+    cond->size = (int *)calloc(c, sizeof(int));
+    cond->minComputer = (int *)malloc(c * sizeof(int));
+    cond->offsets = (int *)calloc(c + 1, sizeof(int));
+    cond->inDegree = (int *)calloc(c, sizeof(int));
+    int *start = (int *)calloc(c + 1, sizeof(int)); // 按SCC分组后的计算机
+    int *members = (int *)malloc(n * sizeof(int));
+    int *stamp = (int *)malloc(c * sizeof(int)); // 去重：stamp[d] == c 表示边c -> d已记录
+    if (!cond->size || !cond->minComputer || !cond->offsets || !cond->inDegree ||
+        !start || !members || !stamp)
+    {
+        free(start);
+        free(members);
+        free(stamp);
+        freeCondensation(cond);
+        return NULL;
+    }
+
+    // 计数排序：按SCC对计算机分组，同时得到每个SCC的大小与最小(原)编号
+    for (int v = n - 1; v >= 0; v--)
+    {
+        int k = cond->component[v];
+        int label = GRAPH_LABEL(graph, v);
+        if (cond->size[k]++ == 0 || label < cond->minComputer[k])
+            cond->minComputer[k] = label;
+    }
+    for (int k = 0; k < c; k++)
+    {
+        start[k + 1] = start[k] + cond->size[k];
+        stamp[k] = -1;
+    }
+    int *fill = cond->offsets; // 暂时借用offsets作为填充位置
+    for (int k = 0; k < c; k++)
+    {
+        fill[k] = start[k];
+    }
+    for (int v = 0; v < n; v++)
+    {
+        members[fill[cond->component[v]]++] = v;
+    }
+
+    // 两遍扫描构建去重后的凝聚图：第一遍计数，第二遍填充
+    for (int pass = 0; pass < 2; pass++)
+    {
+        if (pass == 1)
+        {
+            cond->offsets[0] = 0;
+            for (int k = 0; k < c; k++)
+            {
+                cond->offsets[k + 1] += cond->offsets[k];
+                stamp[k] = -1;
+            }
+            cond->numEdges = cond->offsets[c];
+            cond->dest = (int *)malloc((cond->numEdges + 1) * sizeof(int));
+            if (!cond->dest)
+            {
+                free(start);
+                free(members);
+                free(stamp);
+                freeCondensation(cond);
+                return NULL;
+            }
+        }
+        else
+        {
+            for (int k = 0; k <= c; k++)
+            {
+                cond->offsets[k] = 0;
+            }
+        }
+
+        for (int k = 0; k < c; k++)
+        {
+            int pos = pass == 1 ? cond->offsets[k] : 0;
+            for (int i = start[k]; i < start[k + 1]; i++)
+            {
+                int u = members[i];
+                for (int e = graph->offsets[u]; e < graph->offsets[u + 1]; e++)
+                {
+                    int v = graph->dest[e];
+                    int d = cond->component[v];
+                    if (d == k || stamp[d] == k)
+                        continue;
+
+                    stamp[d] = k;
+                    if (pass == 0)
+                    {
+                        cond->offsets[k + 1]++;
+                    }
+                    else
+                    {
+                        cond->dest[pos++] = d;
+                        cond->inDegree[d]++;
+                    }
+                }
+            }
+        }
+    }
+
+    free(start);
+    free(members);
+    free(stamp);
+    return cond;
+}
+
+void freeCondensation(Condensation *cond)
+{
+    if (cond)
+    {
+        free(cond->component);
+        free(cond->size);
+        free(cond->minComputer);
+        free(cond->offsets);
+        free(cond->dest);
+        free(cond->inDegree);
+        free(cond);
+    }
+}
+
+bool condensationReachCounts(Condensation *cond, int componentReach[])
+{
+    int n = cond->numComputers;
+    int c = cond->numComponents;
+
+    uint64_t (*mask)[REACH_WORDS] = malloc((c + 1) * sizeof(*mask));
+    int *members = (int *)malloc(n * sizeof(int));
+    int *fill = (int *)malloc((c + 1) * sizeof(int));
+    if (!mask || !members || !fill)
+    {
+        free(mask);
+        free(members);
+        free(fill);
+        return false;
+    }
+
+    // 按SCC编号对计算机分组，使每一批目标只落在编号连续的少数几个SCC里
+    fill[0] = 0;
+    for (int k = 0; k < c; k++)
+    {
+        fill[k + 1] = fill[k] + cond->size[k];
+        componentReach[k] = 0;
+    }
+    for (int v = 0; v < n; v++)
+    {
+        members[fill[cond->component[v]]++] = v;
+    }
+
+    for (int batchStart = 0; batchStart < n; batchStart += REACH_BITS)
+    {
+        int batchEnd = batchStart + REACH_BITS < n ? batchStart + REACH_BITS : n;
+        int lo = cond->component[members[batchStart]];
+        int hi = cond->component[members[batchEnd - 1]];
+
+        // 本批目标所在的SCC先写入自身的位
+        memset(mask[lo], 0, (hi - lo + 1) * sizeof(*mask));
+        for (int i = batchStart; i < batchEnd; i++)
+        {
+            int bit = i - batchStart;
+            mask[cond->component[members[i]]][bit / 64] |= (uint64_t)1 << (bit % 64);
+        }
+
+        // 编号小于lo的SCC到达不了本批任何目标(边总是指向更小的编号)，所以从lo开始扫描
+        for (int k = lo; k < c; k++)
+        {
+            uint64_t *m = mask[k];
+            if (k > hi)
+            {
+                memset(m, 0, sizeof(*mask));
+            }
+
+            for (int e = cond->offsets[k]; e < cond->offsets[k + 1]; e++)
+            {
+                int d = cond->dest[e];
+                if (d < lo)
+                    continue;
+                for (int w = 0; w < REACH_WORDS; w++)
+                {
+                    m[w] |= mask[d][w];
+                }
+            }
+
+            int count = 0;
+            for (int w = 0; w < REACH_WORDS; w++)
+            {
+                count += __builtin_popcountll(m[w]);
+            }
+            componentReach[k] += count;
+        }
+    }
+
+    free(mask);
+    free(members);
+    free(fill);
+    return true;
+}
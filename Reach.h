@@ -0,0 +1,50 @@
+#ifndef REACH_H
+#define REACH_H
+
+#include "Graph.h"
+
+// 可入侵关系的强连通分量与凝聚图
+// 安全等级固定时，"u可以入侵v"(存在连接且level(u) + 1 >= level(v))是一张固定的有向图。
+// 同一个强连通分量(SCC)里的计算机能入侵的集合完全相同，
+// 把每个SCC缩成一个点后得到一张有向无环图(凝聚图)。
+typedef struct Condensation
+{
+    int numComputers;
+    int numComponents;
+    int *component;   // component[v]为v所属SCC的编号
+    int *size;        // 每个SCC中计算机的数量
+    int *minComputer; // 每个SCC中编号最小的计算机，图重排过时为原编号(见GRAPH_LABEL)
+
+    // 凝聚图(已去重)的CSR，边c -> d表示SCC c中的某台计算机能入侵SCC d中的某台计算机。
+    // SCC按Tarjan算法完成的先后编号，所以总有 d < c，即编号顺序是一个逆拓扑序。
+    int numEdges;
+    int *offsets;
+    int *dest;
+    int *inDegree;
+} Condensation;
+
+// 用迭代版Tarjan算法计算SCC与凝聚图，不使用递归，可以处理任意深的链。
+// graph必须是攻击图(见buildAttackGraph)，其中的每条边都是一条可入侵关系。内存不足时返回NULL。
+Condensation *buildCondensation(Graph *graph);
+
+void freeCondensation(Condensation *cond);
+
+// 一次扫描同时推进的源数量为REACH_BITS(REACH_WORDS个64位字)。
+// 默认4个字，用AVX2编译时恰好是一个256位向量；用AVX-512编译时取8个字(512位)。
+// 没有SIMD时按字的或运算同样正确，只是每次扫描分摊的开销稍高。
+#if defined(__AVX512F__)
+#define REACH_WORDS 8
+#else
+#define REACH_WORDS 4
+#endif
+#define REACH_BITS (64 * REACH_WORDS)
+
+// 位并行的多源BFS：计算每个SCC能入侵的计算机数量(含自身)，写入componentReach[]。
+// 每次扫描取REACH_BITS台计算机作为目标，在反向图上同时做REACH_BITS个BFS：
+// mask[c]的第i位表示SCC c能到达本批第i台计算机。因为SCC编号是逆拓扑序，
+// 按编号递增扫描一遍凝聚图即可得到所有mask[c]，然后componentReach[c] += popcount(mask[c])。
+// 总代价为O(V / REACH_BITS · (C + E'))，C、E'为凝聚图的点数与边数。
+// 内存不足时返回false。
+bool condensationReachCounts(Condensation *cond, int componentReach[]);
+
+#endif // REACH_H
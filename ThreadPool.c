@@ -0,0 +1,189 @@
+#include "ThreadPool.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+struct ThreadPool
+{
+    int numThreads;
+    pthread_t *threads;
+
+    pthread_mutex_t lock;
+    pthread_cond_t start; // 有新任务或需要退出
+    pthread_cond_t done;  // 最后一个工作线程完成了当前任务
+    int generation;       // 每提交一次任务加一，工作线程据此判断是否有新任务
+    int running;          // 仍在处理当前任务的工作线程数量
+    bool shutdown;
+
+    // 当前任务
+    PoolTask task;
+    void *context;
+    int count;
+    int chunk;
+    atomic_llong next; // 下一个待领取的块的起点(用64位避免count接近INT_MAX时溢出)
+};
+
+// 领取并处理任务块，直到区间被领完
+static void runChunks(ThreadPool *pool, int worker)
+{
+    for (;;)
+    {
+        long long begin = atomic_fetch_add(&pool->next, pool->chunk);
+        if (begin >= pool->count)
+            break;
+        long long end = begin + pool->chunk < pool->count ? begin + pool->chunk : pool->count;
+        pool->task(pool->context, worker, (int)begin, (int)end);
+    }
+}
+
+typedef struct WorkerArg
+{
+    ThreadPool *pool;
+    int worker;
+} WorkerArg;
+
+static void *workerMain(void *arg)
+{
+    ThreadPool *pool = ((WorkerArg *)arg)->pool;
+    int worker = ((WorkerArg *)arg)->worker;
+    free(arg);
+
+    int seen = 0;
+    pthread_mutex_lock(&pool->lock);
+    for (;;)
+    {
+        while (pool->generation == seen && !pool->shutdown)
+        {
+            pthread_cond_wait(&pool->start, &pool->lock);
+        }
+        if (pool->shutdown)
+            break;
+        seen = pool->generation;
+        pthread_mutex_unlock(&pool->lock);
+
+        runChunks(pool, worker);
+
+        pthread_mutex_lock(&pool->lock);
+        if (--pool->running == 0)
+        {
+            pthread_cond_signal(&pool->done);
+        }
+    }
+    pthread_mutex_unlock(&pool->lock);
+    return NULL;
+}
+
+int onlineCpuCount(void)
+{
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    return cpus > 0 ? (int)cpus : 1;
+}
+
+ThreadPool *createThreadPool(int numThreads)
+{
+    if (numThreads <= 0)
+    {
+        numThreads = onlineCpuCount();
+    }
+
+    ThreadPool *pool = (ThreadPool *)calloc(1, sizeof(ThreadPool));
+    if (!pool)
+        return NULL;
+    pool->threads = (pthread_t *)malloc(numThreads * sizeof(pthread_t));
+    if (!pool->threads)
+    {
+        free(pool);
+        return NULL;
+    }
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->start, NULL);
+    pthread_cond_init(&pool->done, NULL);
+    atomic_init(&pool->next, 0);
+
+    // 第0号工作者是调用threadPoolRun的线程，只需创建其余的线程
+    pool->numThreads = 1;
+    for (int i = 1; i < numThreads; i++)
+    {
+        WorkerArg *arg = (WorkerArg *)malloc(sizeof(WorkerArg));
+        if (!arg)
+        {
+            freeThreadPool(pool);
+            return NULL;
+        }
+        arg->pool = pool;
+        arg->worker = i;
+        if (pthread_create(&pool->threads[i], NULL, workerMain, arg) != 0)
+        {
+            free(arg);
+            freeThreadPool(pool);
+            return NULL;
+        }
+        pool->numThreads++;
+    }
+    return pool;
+}
+
+void freeThreadPool(ThreadPool *pool)
+{
+    if (pool)
+    {
+        pthread_mutex_lock(&pool->lock);
+        pool->shutdown = true;
+        pthread_cond_broadcast(&pool->start);
+        pthread_mutex_unlock(&pool->lock);
+
+        for (int i = 1; i < pool->numThreads; i++)
+        {
+            pthread_join(pool->threads[i], NULL);
+        }
+
+        pthread_mutex_destroy(&pool->lock);
+        pthread_cond_destroy(&pool->start);
+        pthread_cond_destroy(&pool->done);
+        free(pool->threads);
+        free(pool);
+    }
+}
+
+int threadPoolSize(ThreadPool *pool)
+{
+    return pool->numThreads;
+}
+
+void threadPoolRun(ThreadPool *pool, int count, int chunk, PoolTask task, void *context)
+{
+    if (count <= 0)
+        return;
+    if (chunk < 1)
+        chunk = 1;
+
+    pool->task = task;
+    pool->context = context;
+    pool->count = count;
+    pool->chunk = chunk;
+    atomic_store(&pool->next, 0);
+
+    if (pool->numThreads > 1)
+    {
+        pthread_mutex_lock(&pool->lock);
+        pool->running = pool->numThreads - 1;
+        pool->generation++;
+        pthread_cond_broadcast(&pool->start);
+        pthread_mutex_unlock(&pool->lock);
+    }
+
+    runChunks(pool, 0);
+
+    if (pool->numThreads > 1)
+    {
+        pthread_mutex_lock(&pool->lock);
+        while (pool->running > 0)
+        {
+            pthread_cond_wait(&pool->done, &pool->lock);
+        }
+        pthread_mutex_unlock(&pool->lock);
+    }
+}
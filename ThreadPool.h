@@ -0,0 +1,27 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+// 固定大小的线程池，用于把一批相互独立的查询分给多个线程
+// 池中有numThreads - 1个常驻工作线程，调用threadPoolRun的线程本身作为第0号工作者参与计算。
+// 任务区间[0, count)被切成大小为chunk的块，各工作者用原子计数器动态领取，
+// 所以单个查询耗时不均匀时负载依然均衡。
+typedef struct ThreadPool ThreadPool;
+
+// 处理区间[begin, end)，worker为工作者编号(0到numThreads - 1)，可用来索引每线程的临时缓冲区
+typedef void (*PoolTask)(void *context, int worker, int begin, int end);
+
+// 在线CPU核数(至少为1)
+int onlineCpuCount(void);
+
+// 创建线程池，numThreads <= 0 时使用在线CPU核数；失败时返回NULL
+ThreadPool *createThreadPool(int numThreads);
+
+// 释放线程池并等待全部工作线程退出(NULL安全)
+void freeThreadPool(ThreadPool *pool);
+
+int threadPoolSize(ThreadPool *pool);
+
+// 在池中执行task，直到区间[0, count)全部处理完毕才返回。同一个线程池不能被并发调用。
+void threadPoolRun(ThreadPool *pool, int count, int chunk, PoolTask task, void *context);
+
+#endif // THREAD_POOL_H
@@ -0,0 +1,265 @@
+// 验证与基准测试：advancedPoodle的(计算机, 安全等级)状态空间引擎 vs 原来按sourceQueue逐轮重跑的实现
+//
+// 用法: ./benchAdvanced [dataDir]   (默认 ../data)
+//
+// 1. 对dataDir下每个network-*.txt、从每台计算机出发，比较两种实现；
+// 2. 在随机网络上比较；
+// 3. 在较大的随机网络上比较运行时间(原实现为O(V^3)，只在小规模上运行)。
+//
+// 原实现在while循环结束后没有把最后一轮的time[]合并进minTime[]，因此最后一轮才首次到达的
+// 计算机(例如网络中没有更高等级的计算机时，除起点外的全部计算机)会被漏掉。
+// 这里的对照实现补上了这次合并；同时检查原实现给出的每个时间都与新引擎一致。
+
+#include <dirent.h>
+#include <limits.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../Graph.h"
+#include "../Network.h"
+#include "benchUtil.h"
+
+// 原advancedPoodle的计算部分(改为遍历CSR)，结果写入minTime[]
+static void legacyAdvanced(Graph *graph, int sourceComputer, int minTime[], bool mergeLastRound)
+{
+	int numComputers = graph->numComputers;
+	const int *poodleTime = graph->poodleTime;
+	int *time = malloc(numComputers * sizeof(int));
+	int *currentSecurity = malloc(numComputers * sizeof(int));
+	int *sourceQueue = malloc(numComputers * sizeof(int));
+	int sourceFront = 0, sourceRear = 0;
+
+	for (int i = 0; i < numComputers; i++)
+	{
+		time[i] = INT_MAX;
+		minTime[i] = INT_MAX;
+		currentSecurity[i] = GRAPH_LEVEL(graph, i);
+	}
+	minTime[sourceComputer] = poodleTime[sourceComputer];
+	sourceQueue[sourceRear++] = sourceComputer;
+
+	while (sourceFront < sourceRear)
+	{
+		int currentSource = sourceQueue[sourceFront++];
+		int sourceSecLevel = currentSecurity[currentSource];
+
+		for (int i = 0; i < numComputers; i++)
+		{
+			if (minTime[i] > time[i])
+				minTime[i] = time[i];
+			time[i] = INT_MAX;
+		}
+		time[currentSource] = minTime[currentSource];
+
+		bool *inDijkstra = calloc(numComputers, sizeof(bool));
+		int u = currentSource;
+		for (int i = 0; i < numComputers; i++)
+		{
+			inDijkstra[u] = true;
+			for (int e = graph->offsets[u]; e < graph->offsets[u + 1]; e++)
+			{
+				int v = graph->dest[e];
+				int newTime = time[u] + graph->transmissionTime[e] + poodleTime[v];
+				if (!inDijkstra[v])
+				{
+					if (currentSecurity[v] <= sourceSecLevel && newTime < time[v])
+					{
+						time[v] = newTime;
+						currentSecurity[v] = sourceSecLevel;
+					}
+					if (currentSecurity[v] == sourceSecLevel + 1 && newTime < time[v])
+					{
+						time[v] = newTime;
+						bool alreadyInQueue = false;
+						for (int j = 0; j < sourceRear; j++)
+						{
+							if (sourceQueue[j] == v)
+							{
+								alreadyInQueue = true;
+								break;
+							}
+						}
+						if (!alreadyInQueue)
+							sourceQueue[sourceRear++] = v;
+					}
+				}
+			}
+
+			u = -1;
+			int best = INT_MAX;
+			for (int v = 0; v < numComputers; v++)
+			{
+				if (!inDijkstra[v] && time[v] < best)
+				{
+					best = time[v];
+					u = v;
+				}
+			}
+			if (u == -1)
+				break;
+		}
+		free(inDijkstra);
+	}
+
+	if (mergeLastRound)
+	{
+		for (int i = 0; i < numComputers; i++)
+		{
+			if (minTime[i] > time[i])
+				minTime[i] = time[i];
+		}
+	}
+
+	free(time);
+	free(currentSecurity);
+	free(sourceQueue);
+}
+
+// 比较一次查询，返回是否一致
+static bool checkOne(struct network *net, Graph *graph, Network *handle, int source)
+{
+	int n = net->numComputers;
+	int *fixed = malloc(n * sizeof(int));
+	int *original = malloc(n * sizeof(int));
+	int *engine = malloc(n * sizeof(int));
+	bool ok = true;
+
+	legacyAdvanced(graph, source, fixed, true);
+	legacyAdvanced(graph, source, original, false);
+
+	struct poodleResult res = networkAdvancedPoodle(handle, source);
+	for (int i = 0; i < n; i++)
+		engine[i] = INT_MAX;
+	for (int i = 0; i < res.numSteps; i++)
+	{
+		engine[res.steps[i].computer] = res.steps[i].time;
+
+		// 输出必须按(时间, 计算机编号)升序
+		if (i > 0 && (res.steps[i - 1].time > res.steps[i].time ||
+					  (res.steps[i - 1].time == res.steps[i].time &&
+					   res.steps[i - 1].computer > res.steps[i].computer)))
+			ok = false;
+	}
+
+	for (int i = 0; i < n; i++)
+	{
+		if (engine[i] != fixed[i])
+			ok = false;
+		if (original[i] != INT_MAX && original[i] != engine[i])
+			ok = false;
+	}
+
+	free(res.steps);
+	free(fixed);
+	free(original);
+	free(engine);
+	return ok;
+}
+
+static int checkNetwork(struct network *net, const char *name)
+{
+	Graph *graph = buildGraph(net->computers, net->numComputers, net->connections, net->numConnections);
+	Network *handle = openNetwork(net->computers, net->numComputers, net->connections, net->numConnections);
+	int failures = 0;
+
+	for (int s = 0; s < net->numComputers; s++)
+	{
+		if (!checkOne(net, graph, handle, s))
+		{
+			fprintf(stderr, "benchAdvanced: mismatch on %s from computer %d\n", name, s);
+			failures++;
+		}
+	}
+
+	closeNetwork(handle);
+	freeGraph(graph);
+	return failures;
+}
+
+int main(int argc, char *argv[])
+{
+	const char *dataDir = argc > 1 ? argv[1] : "../data";
+	int failures = 0;
+	int checked = 0;
+
+	// 1. 数据文件
+	DIR *dir = opendir(dataDir);
+	if (dir)
+	{
+		struct dirent *entry;
+		while ((entry = readdir(dir)))
+		{
+			if (strncmp(entry->d_name, "network-", 8) != 0)
+				continue;
+			char path[1024];
+			snprintf(path, sizeof(path), "%s/%s", dataDir, entry->d_name);
+			struct network net = readNetwork(path);
+			if (net.numComputers == 0)
+				continue;
+			failures += checkNetwork(&net, entry->d_name);
+			checked++;
+			freeNetwork(&net);
+		}
+		closedir(dir);
+	}
+	printf("data files checked: %d\n", checked);
+
+	// 2. 随机网络
+	int randomChecked = 0;
+	for (int seed = 1; seed <= 2000; seed++)
+	{
+		uint64_t state = seed;
+		int n = randRange(&state, 1, 40);
+		struct network net = randomNetwork(n, randRange(&state, 1, 6), seed);
+		char name[64];
+		snprintf(name, sizeof(name), "random seed %d", seed);
+		failures += checkNetwork(&net, name);
+		randomChecked++;
+		freeNetwork(&net);
+	}
+	printf("random networks checked: %d\n", randomChecked);
+
+	// 3. 运行时间
+	printf("%10s %10s %14s %14s\n", "computers", "conns", "legacy ms", "state-space ms");
+	int sizes[] = {500, 2000, 10000, 100000, 1000000};
+	for (int k = 0; k < (int)(sizeof(sizes) / sizeof(sizes[0])); k++)
+	{
+		int n = sizes[k];
+		struct network net = randomNetwork(n, 4, 2521);
+		Network *handle = openNetwork(net.computers, net.numComputers, net.connections, net.numConnections);
+
+		printf("%10d %10d", n, net.numConnections);
+		if (n <= 2000)
+		{
+			Graph *graph = buildGraph(net.computers, net.numComputers, net.connections, net.numConnections);
+			int *minTime = malloc(n * sizeof(int));
+			int64_t t0 = nowNs();
+			legacyAdvanced(graph, 0, minTime, true);
+			printf(" %14.3f", (nowNs() - t0) / 1e6);
+			free(minTime);
+			freeGraph(graph);
+		}
+		else
+		{
+			printf(" %14s", "-");
+		}
+
+		int64_t t0 = nowNs();
+		struct poodleResult res = networkAdvancedPoodle(handle, 0);
+		printf(" %14.3f\n", (nowNs() - t0) / 1e6);
+
+		free(res.steps);
+		closeNetwork(handle);
+		freeNetwork(&net);
+	}
+
+	if (failures > 0)
+	{
+		fprintf(stderr, "benchAdvanced: %d mismatches\n", failures);
+		return EXIT_FAILURE;
+	}
+	printf("all results match\n");
+	return 0;
+}
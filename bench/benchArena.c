@@ -0,0 +1,213 @@
+// 验证与基准测试：区域分配器与poodle结果的三种分配方式
+//
+// 用法: ./benchArena [numComputers] [numQueries]   (默认 10^5 台计算机、200次查询)
+//
+// 1. 区域分配器的基本性质：对齐、超大分配单独成块、arenaReset后复用保留的块；
+// 2. 模拟一次请求：从numQueries个随机源各做一次poodle，保留全部结果，最后整体释放，比较
+//      - 逐个节点malloc(poodle.h的约定，调用者逐个free)；
+//      - networkPoodle：每个结果一块内存，freePoodleResult逐个结果释放；
+//      - networkPoodleInArena：全部结果在同一个区域中，一次arenaReset释放。
+//    报告malloc次数、构建结果(含搜索)与释放的耗时；三种方式的结果必须相同。
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../Arena.h"
+#include "../Graph.h"
+#include "../Network.h"
+#include "benchUtil.h"
+
+static int checkArena(void)
+{
+	int failures = 0;
+	Arena *arena = createArena(1024);
+
+	for (int i = 1; i <= 100; i++)
+	{
+		char *p = arenaAlloc(arena, i);
+		if ((uintptr_t)p % _Alignof(max_align_t) != 0)
+			failures++;
+		for (int k = 0; k < i; k++)
+			p[k] = (char)k;
+	}
+	char *big = arenaAlloc(arena, 10000); // 单独成块
+	big[9999] = 1;
+	ArenaStats stats = arenaStats(arena);
+	if (stats.allocations != 101 || stats.bytesReserved < 10000)
+		failures++;
+
+	arenaReset(arena);
+	stats = arenaStats(arena);
+	if (stats.bytesUsed != 0 || stats.bytesReserved != 1024)
+		failures++;
+	long long mallocs = stats.mallocs;
+	arenaAlloc(arena, 512);
+	if (arenaStats(arena).mallocs != mallocs) // 复用保留的块
+		failures++;
+
+	freeArena(arena);
+	return failures;
+}
+
+// poodle.h约定的形式：每个接收者节点单独malloc(与poodle.c的包装函数相同)
+static struct poodleResult perNodeResult(Network *handle, int start, long long *mallocs)
+{
+	struct poodleResult block = networkPoodle(handle, start);
+	struct poodleResult res = {block.numSteps, malloc(block.numSteps * sizeof(struct step))};
+	(*mallocs)++;
+	for (int i = 0; i < block.numSteps; i++)
+	{
+		res.steps[i] = block.steps[i];
+		struct computerList **tail = &res.steps[i].recipients;
+		for (struct computerList *curr = block.steps[i].recipients; curr; curr = curr->next)
+		{
+			struct computerList *node = malloc(sizeof(struct computerList));
+			node->computer = curr->computer;
+			node->next = NULL;
+			*tail = node;
+			tail = &node->next;
+			(*mallocs)++;
+		}
+	}
+	freePoodleResult(block);
+	return res;
+}
+
+static void freePerNode(struct poodleResult res)
+{
+	for (int i = 0; i < res.numSteps; i++)
+	{
+		struct computerList *curr = res.steps[i].recipients;
+		while (curr)
+		{
+			struct computerList *temp = curr;
+			curr = curr->next;
+			free(temp);
+		}
+	}
+	free(res.steps);
+}
+
+static bool sameResult(struct poodleResult a, struct poodleResult b)
+{
+	if (a.numSteps != b.numSteps)
+		return false;
+	for (int i = 0; i < a.numSteps; i++)
+	{
+		if (a.steps[i].computer != b.steps[i].computer || a.steps[i].time != b.steps[i].time)
+			return false;
+		struct computerList *x = a.steps[i].recipients;
+		struct computerList *y = b.steps[i].recipients;
+		for (; x && y; x = x->next, y = y->next)
+		{
+			if (x->computer != y->computer)
+				return false;
+		}
+		if (x || y)
+			return false;
+	}
+	return true;
+}
+
+int main(int argc, char *argv[])
+{
+	int numComputers = argc > 1 ? atoi(argv[1]) : 100000;
+	int numQueries = argc > 2 ? atoi(argv[2]) : 200;
+	int failures = checkArena();
+	printf("arena checks done\n");
+
+	struct network net = randomNetwork(numComputers, 4, 2521);
+	Graph *graph = buildGraph(net.computers, numComputers, net.connections, net.numConnections);
+	printf("computers=%d connections=%d queries=%d\n", numComputers, net.numConnections, numQueries);
+	printf("buildGraph: %lld malloc(s) for the whole graph (previously 4)\n", arenaStats(graph->arena).mallocs);
+	freeGraph(graph);
+
+	Network *handle = openNetwork(net.computers, numComputers, net.connections, net.numConnections);
+	int *sources = malloc(numQueries * sizeof(int));
+	uint64_t state = 42;
+	for (int q = 0; q < numQueries; q++)
+		sources[q] = randRange(&state, 0, numComputers - 1);
+
+	struct poodleResult *perNode = malloc(numQueries * sizeof(struct poodleResult));
+	struct poodleResult *blocks = malloc(numQueries * sizeof(struct poodleResult));
+	struct poodleResult *inArena = malloc(numQueries * sizeof(struct poodleResult));
+	freePoodleResult(networkPoodle(handle, 0)); // 预热：创建优先队列
+	printf("%-22s %14s %14s %14s\n", "method", "mallocs", "build ms", "release ms");
+
+	// 逐个节点
+	long long mallocs = 0;
+	int64_t t0 = nowNs();
+	for (int q = 0; q < numQueries; q++)
+		perNode[q] = perNodeResult(handle, sources[q], &mallocs);
+	int64_t build = nowNs() - t0;
+
+	// 每个结果一块
+	t0 = nowNs();
+	for (int q = 0; q < numQueries; q++)
+		blocks[q] = networkPoodle(handle, sources[q]);
+	int64_t blockBuild = nowNs() - t0;
+
+	// 区域：运行两次请求，第二次复用第一次保留下来的块
+	Arena *arena = createArena(0);
+	for (int round = 0; round < 2; round++)
+	{
+		long long before = arenaStats(arena).mallocs;
+		t0 = nowNs();
+		for (int q = 0; q < numQueries; q++)
+			inArena[q] = networkPoodleInArena(handle, sources[q], arena);
+		int64_t arenaBuild = nowNs() - t0;
+
+		bool same = true;
+		for (int q = 0; q < numQueries; q++)
+			same = same && sameResult(perNode[q], inArena[q]) && sameResult(blocks[q], inArena[q]);
+		if (!same)
+		{
+			fprintf(stderr, "benchArena: arena results differ\n");
+			failures++;
+		}
+
+		if (round == 1)
+		{
+			// 先输出前两种方式：释放时间在这里测，结果在比较之后才能释放
+			t0 = nowNs();
+			for (int q = 0; q < numQueries; q++)
+				freePerNode(perNode[q]);
+			int64_t perNodeFree = nowNs() - t0;
+			printf("%-22s %14lld %14.3f %14.3f\n", "per-node malloc", mallocs, build / 1e6, perNodeFree / 1e6);
+
+			t0 = nowNs();
+			for (int q = 0; q < numQueries; q++)
+				freePoodleResult(blocks[q]);
+			int64_t blockFree = nowNs() - t0;
+			printf("%-22s %14d %14.3f %14.3f\n", "one block per result", numQueries, blockBuild / 1e6,
+				   blockFree / 1e6);
+		}
+
+		long long arenaMallocs = arenaStats(arena).mallocs - before;
+		size_t reserved = arenaStats(arena).bytesReserved;
+		t0 = nowNs();
+		arenaReset(arena);
+		int64_t arenaFree = nowNs() - t0;
+		if (round == 1)
+			printf("%-22s %14lld %14.3f %14.3f   (%.1f MB reserved, second request)\n", "arena, one reset",
+				   arenaMallocs, arenaBuild / 1e6, arenaFree / 1e6, reserved / 1048576.0);
+	}
+
+	freeArena(arena);
+	free(perNode);
+	free(blocks);
+	free(inArena);
+	free(sources);
+	closeNetwork(handle);
+	freeNetwork(&net);
+
+	if (failures > 0)
+	{
+		fprintf(stderr, "benchArena: %d failures\n", failures);
+		return EXIT_FAILURE;
+	}
+	printf("all results match\n");
+	return 0;
+}
@@ -0,0 +1,212 @@
+// 验证与基准测试：攻击图(预先按安全等级过滤的有向邻接)
+//
+// 用法: ./benchAttackGraph [numComputers]   (默认 10^6 台计算机)
+//
+// 1. 在随机小网络上，buildAttackGraph的每一行必须恰好是原图这一行中权限合法的边，并保持原来的顺序；
+//    networkInfectionTimes(在攻击图上搜索)必须与"在无向图上逐边检查权限"的Dijkstra结果相同；
+// 2. 在大网络上，对几种安全等级分布报告保留下来的边数、内存与构建时间，
+//    并用同一种优先队列比较两种Dijkstra的耗时，以及句柄上的networkInfectionTimes与chooseSource。
+
+#include <limits.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../Graph.h"
+#include "../Network.h"
+#include "../PQueue.h"
+#include "benchUtil.h"
+#include "netgen.h"
+
+// 引入攻击图之前的做法：在无向图上遍历，逐边读取两端的安全等级。
+// check为false时graph应为攻击图，不再检查。调用前time[]必须全为INT_MAX
+static int dijkstra(Graph *graph, PQueue *pq, bool check, int source, int time[])
+{
+	const int *poodleTime = graph->poodleTime;
+	int reached = 0;
+	time[source] = poodleTime[source];
+	pqPush(pq, source, PQ_KEY(time[source], source));
+	while (!pqIsEmpty(pq))
+	{
+		int u = pqPopMin(pq, NULL);
+		reached++;
+		for (int e = graph->offsets[u]; e < graph->offsets[u + 1]; e++)
+		{
+			int v = graph->dest[e];
+			int newTime = time[u] + graph->transmissionTime[e] + poodleTime[v];
+			if (check && GRAPH_LEVEL(graph, u) + 1 < GRAPH_LEVEL(graph, v))
+				continue;
+			if (newTime < time[v])
+			{
+				time[v] = newTime;
+				pqPush(pq, v, PQ_KEY(newTime, v));
+			}
+		}
+	}
+	return reached;
+}
+
+static void resetTimes(int time[], int n)
+{
+	for (int v = 0; v < n; v++)
+		time[v] = INT_MAX;
+}
+
+static int checkRandom(int seed)
+{
+	uint64_t state = seed;
+	int n = randRange(&state, 1, 300);
+	struct network net = randomNetwork(n, randRange(&state, 0, 8), seed);
+	for (int v = 0; v < n; v++)
+		net.computers[v].securityLevel = randRange(&state, 1, 10);
+
+	Graph *graph = buildGraph(net.computers, n, net.connections, net.numConnections);
+	Graph *attack = buildAttackGraph(graph);
+	int failures = 0;
+
+	// 每一行必须是原图这一行中权限合法的边，顺序不变
+	int kept = 0;
+	for (int u = 0; u < n; u++)
+	{
+		int pos = attack->offsets[u];
+		for (int e = graph->offsets[u]; e < graph->offsets[u + 1]; e++)
+		{
+			int v = graph->dest[e];
+			if (net.computers[u].securityLevel + 1 < net.computers[v].securityLevel)
+				continue;
+			if (pos >= attack->offsets[u + 1] || attack->dest[pos] != v ||
+				attack->transmissionTime[pos] != graph->transmissionTime[e])
+				failures++;
+			pos++;
+			kept++;
+		}
+		if (pos != attack->offsets[u + 1])
+			failures++;
+	}
+	if (kept != attack->numEdges || attack->offsets[n] != kept)
+		failures++;
+
+	// 句柄上的搜索与逐边检查的Dijkstra相同
+	Network *handle = openNetwork(net.computers, n, net.connections, net.numConnections);
+	PQueue *pq = createPQueue(PQ_BINARY_HEAP, n);
+	int *expected = malloc(n * sizeof(int));
+	int *time = malloc(n * sizeof(int));
+	int source = randRange(&state, 0, n - 1);
+	resetTimes(expected, n);
+	dijkstra(graph, pq, true, source, expected);
+	networkInfectionTimes(handle, source, time);
+	if (memcmp(expected, time, n * sizeof(int)) != 0)
+		failures++;
+
+	if (failures > 0)
+		fprintf(stderr, "benchAttackGraph: seed %d has %d mismatches\n", seed, failures);
+	free(expected);
+	free(time);
+	freePQueue(pq);
+	closeNetwork(handle);
+	freeGraph(attack);
+	freeGraph(graph);
+	freeNetwork(&net);
+	return failures;
+}
+
+static int runLevels(LevelDistribution levels, const char *name, int numComputers)
+{
+	GenParams params = defaultGenParams(numComputers);
+	params.topology = TOPO_ERDOS_RENYI;
+	params.avgDegree = 8;
+	params.levels = levels;
+	struct network net = generateNetwork(&params);
+	int n = net.numComputers;
+	int failures = 0;
+
+	Graph *graph = buildGraph(net.computers, n, net.connections, net.numConnections);
+	int64_t t0 = nowNs();
+	Graph *attack = buildAttackGraph(graph);
+	int64_t build = nowNs() - t0;
+
+	// CSR占用：offsets加上每条边的dest与transmissionTime
+	double graphMb = ((n + 1) + 2.0 * graph->numEdges) * sizeof(int) / 1e6;
+	double attackMb = ((n + 1) + 2.0 * attack->numEdges) * sizeof(int) / 1e6;
+	printf("%-10s computers=%d connections=%d\n", name, n, net.numConnections);
+	printf("  %-32s %12d (%.1f MB)\n", "undirected edges", graph->numEdges, graphMb);
+	printf("  %-32s %12d (%.1f MB, %.1f%% kept)\n", "attack edges", attack->numEdges, attackMb,
+		   100.0 * attack->numEdges / (graph->numEdges > 0 ? graph->numEdges : 1));
+	printf("  %-32s %12.3f ms\n", "buildAttackGraph", build / 1e6);
+
+	// 同一种优先队列上的两种Dijkstra，各取三次中最快的一次
+	PQueue *pq = createPQueue(PQ_RADIX_HEAP, n);
+	int *expected = malloc(n * sizeof(int));
+	int *time = malloc(n * sizeof(int));
+	int64_t checked = INT64_MAX, filtered = INT64_MAX;
+	int reached = 0;
+	for (int round = 0; round < 3; round++)
+	{
+		resetTimes(expected, n);
+		pqClear(pq);
+		t0 = nowNs();
+		reached = dijkstra(graph, pq, true, 0, expected);
+		int64_t elapsed = nowNs() - t0;
+		checked = elapsed < checked ? elapsed : checked;
+
+		resetTimes(time, n);
+		pqClear(pq);
+		t0 = nowNs();
+		dijkstra(attack, pq, false, 0, time);
+		elapsed = nowNs() - t0;
+		filtered = elapsed < filtered ? elapsed : filtered;
+	}
+	printf("  %-32s %12.3f ms (reached %d)\n", "dijkstra, per-edge check", checked / 1e6, reached);
+	printf("  %-32s %12.3f ms %8.2fx\n", "dijkstra, attack graph", filtered / 1e6, (double)checked / filtered);
+	if (memcmp(expected, time, n * sizeof(int)) != 0)
+		failures++;
+
+	// 句柄：第一次调用构建攻击图，之后的调用直接使用
+	Network *handle = openNetwork(net.computers, n, net.connections, net.numConnections);
+	t0 = nowNs();
+	networkInfectionTimes(handle, 0, time);
+	int64_t first = nowNs() - t0;
+	t0 = nowNs();
+	networkInfectionTimes(handle, 0, time);
+	int64_t again = nowNs() - t0;
+	printf("  %-32s %12.3f ms (first call %.3f ms)\n", "networkInfectionTimes", again / 1e6, first / 1e6);
+	if (memcmp(expected, time, n * sizeof(int)) != 0)
+		failures++;
+
+	t0 = nowNs();
+	struct chooseSourceResult choice = networkChooseSource(handle);
+	printf("  %-32s %12.3f ms\n", "networkChooseSource", (nowNs() - t0) / 1e6);
+	free(choice.computers);
+
+	if (failures > 0)
+		fprintf(stderr, "benchAttackGraph: %s results differ\n", name);
+	free(expected);
+	free(time);
+	freePQueue(pq);
+	closeNetwork(handle);
+	freeGraph(attack);
+	freeGraph(graph);
+	freeNetwork(&net);
+	return failures;
+}
+
+int main(int argc, char *argv[])
+{
+	int numComputers = argc > 1 ? atoi(argv[1]) : 1000000;
+	int failures = 0;
+
+	for (int seed = 1; seed <= 2000; seed++)
+		failures += checkRandom(seed);
+	printf("random networks checked: 2000\n");
+
+	failures += runLevels(LEVELS_UNIFORM, "uniform", numComputers);
+	failures += runLevels(LEVELS_LOW, "low", numComputers);
+	failures += runLevels(LEVELS_GRADIENT, "gradient", numComputers);
+	failures += runLevels(LEVELS_CONSTANT, "constant", numComputers);
+
+	if (failures > 0)
+		return EXIT_FAILURE;
+	printf("all results match\n");
+	return 0;
+}
@@ -0,0 +1,177 @@
+// 验证与基准测试：提前终止的poodle查询(时间上限 / 前K台)
+//
+// 用法: ./benchBounded [numComputers] [numQueries]   (默认 10^6 台计算机、100次查询)
+//
+// 1. 在随机小网络(含大量平局)上，networkPoodleBounded / networkAdvancedPoodleBounded的结果
+//    必须等于完整结果中入侵时间不超过deadline的前maxSteps步，接收者只保留结果之内的计算机；
+//    同一个句柄上连续执行多次不同限制的查询，检查缓冲区在查询之间被正确恢复；
+// 2. 在大网络上比较前K台查询与完整查询的平均耗时，K从10增长到10^5，
+//    以及计算机0在不同时间上限下的耗时。
+
+#include <limits.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../Network.h"
+#include "benchUtil.h"
+
+// actual是否等于full的前缀(时间不超过deadline的前maxSteps步，接收者限制在前缀之内)
+static bool isPrefix(struct poodleResult full, struct poodleResult actual, int deadline, int maxSteps,
+					 bool *inPrefix, int numComputers)
+{
+	int expected = 0;
+	while (expected < full.numSteps && expected < maxSteps && full.steps[expected].time <= deadline)
+		expected++;
+	if (actual.numSteps != expected)
+		return false;
+
+	memset(inPrefix, 0, numComputers * sizeof(bool));
+	for (int i = 0; i < expected; i++)
+		inPrefix[full.steps[i].computer] = true;
+
+	for (int i = 0; i < expected; i++)
+	{
+		if (actual.steps[i].computer != full.steps[i].computer || actual.steps[i].time != full.steps[i].time)
+			return false;
+		struct computerList *y = actual.steps[i].recipients;
+		for (struct computerList *x = full.steps[i].recipients; x; x = x->next)
+		{
+			if (!inPrefix[x->computer])
+				continue;
+			if (!y || y->computer != x->computer)
+				return false;
+			y = y->next;
+		}
+		if (y)
+			return false;
+	}
+	return true;
+}
+
+static int checkRandom(int seed)
+{
+	uint64_t state = seed;
+	int n = randRange(&state, 1, 300);
+	struct network net = randomNetwork(n, randRange(&state, 0, 8), seed);
+	int maxTime = randRange(&state, 1, 6); // 时间范围小时平局多
+	for (int v = 0; v < n; v++)
+	{
+		net.computers[v].poodleTime = randRange(&state, 1, maxTime);
+		net.computers[v].securityLevel = randRange(&state, 1, 10);
+	}
+	for (int i = 0; i < net.numConnections; i++)
+		net.connections[i].transmissionTime = randRange(&state, 1, maxTime);
+
+	Network *handle = openNetwork(net.computers, n, net.connections, net.numConnections);
+	bool *inPrefix = malloc(n * sizeof(bool));
+	int failures = 0;
+
+	for (int query = 0; query < 5; query++)
+	{
+		int start = randRange(&state, 0, n - 1);
+		struct poodleResult full = networkPoodle(handle, start);
+		struct poodleResult fullAdvanced = networkAdvancedPoodle(handle, start);
+		int lastTime = full.steps[full.numSteps - 1].time;
+
+		int deadline = randRange(&state, 0, 3) == 0 ? INT_MAX : randRange(&state, 0, lastTime + 1);
+		int maxSteps = randRange(&state, 0, 3) == 0 ? INT_MAX : randRange(&state, 0, n + 1);
+
+		struct poodleResult bounded = networkPoodleBounded(handle, start, deadline, maxSteps);
+		if (!isPrefix(full, bounded, deadline, maxSteps, inPrefix, n))
+		{
+			fprintf(stderr, "benchBounded: seed %d poodle differs (deadline %d, maxSteps %d)\n", seed,
+					deadline, maxSteps);
+			failures++;
+		}
+		struct poodleResult advanced = networkAdvancedPoodleBounded(handle, start, deadline, maxSteps);
+		if (!isPrefix(fullAdvanced, advanced, deadline, maxSteps, inPrefix, n))
+		{
+			fprintf(stderr, "benchBounded: seed %d advancedPoodle differs (deadline %d, maxSteps %d)\n", seed,
+					deadline, maxSteps);
+			failures++;
+		}
+
+		freePoodleResult(full);
+		freePoodleResult(fullAdvanced);
+		freePoodleResult(bounded);
+		freePoodleResult(advanced);
+	}
+
+	free(inPrefix);
+	closeNetwork(handle);
+	freeNetwork(&net);
+	return failures;
+}
+
+int main(int argc, char *argv[])
+{
+	int numComputers = argc > 1 ? atoi(argv[1]) : 1000000;
+	int numQueries = argc > 2 ? atoi(argv[2]) : 100;
+	int failures = 0;
+
+	for (int seed = 1; seed <= 2000; seed++)
+		failures += checkRandom(seed);
+	printf("random networks checked: 2000\n");
+
+	struct network net = randomNetwork(numComputers, 4, 2521);
+	Network *handle = openNetwork(net.computers, numComputers, net.connections, net.numConnections);
+	int *sources = malloc(numQueries * sizeof(int));
+	uint64_t state = 42;
+	for (int q = 0; q < numQueries; q++)
+		sources[q] = randRange(&state, 0, numComputers - 1);
+	printf("computers=%d connections=%d queries=%d\n", numComputers, net.numConnections, numQueries);
+
+	// 完整查询作为参照，先跑一次使优先队列与缓冲区就位
+	freePoodleResult(networkPoodle(handle, 0));
+	freePoodleResult(networkPoodleBounded(handle, 0, INT_MAX, 1));
+	freePoodleResult(networkAdvancedPoodleBounded(handle, 0, INT_MAX, 1));
+	int64_t t0 = nowNs();
+	for (int q = 0; q < numQueries; q++)
+		freePoodleResult(networkPoodle(handle, sources[q]));
+	double fullMs = (nowNs() - t0) / 1e6 / numQueries;
+	printf("%-26s %12.3f ms/query\n", "full poodle", fullMs);
+
+	for (int k = 10; k <= 100000 && k <= numComputers; k *= 10)
+	{
+		t0 = nowNs();
+		for (int q = 0; q < numQueries; q++)
+			freePoodleResult(networkPoodleBounded(handle, sources[q], INT_MAX, k));
+		double ms = (nowNs() - t0) / 1e6 / numQueries;
+
+		t0 = nowNs();
+		for (int q = 0; q < numQueries; q++)
+			freePoodleResult(networkAdvancedPoodleBounded(handle, sources[q], INT_MAX, k));
+		double advancedMs = (nowNs() - t0) / 1e6 / numQueries;
+
+		char name[64];
+		snprintf(name, sizeof(name), "first %d", k);
+		printf("%-26s %12.3f ms/query %8.1fx   advanced %10.3f ms/query\n", name, ms, fullMs / ms, advancedMs);
+	}
+
+	// 计算机0在不同时间上限下的耗时：上限取完整结果中第10、10^3、10^5步的时间
+	struct poodleResult full = networkPoodle(handle, 0);
+	for (int k = 10; k <= 100000 && k <= full.numSteps; k *= 100)
+	{
+		int deadline = full.steps[k - 1].time;
+		t0 = nowNs();
+		struct poodleResult bounded = networkPoodleBounded(handle, 0, deadline, INT_MAX);
+		double ms = (nowNs() - t0) / 1e6;
+
+		char name[64];
+		snprintf(name, sizeof(name), "within %d (%d steps)", deadline, bounded.numSteps);
+		printf("%-26s %12.3f ms/query %8.1fx\n", name, ms, fullMs / ms);
+		freePoodleResult(bounded);
+	}
+	freePoodleResult(full);
+
+	free(sources);
+	closeNetwork(handle);
+	freeNetwork(&net);
+
+	if (failures > 0)
+		return EXIT_FAILURE;
+	printf("all results match\n");
+	return 0;
+}
@@ -0,0 +1,173 @@
+// 验证与基准测试：桶队列/BFS引擎与ENGINE_AUTO的选择
+//
+// 用法: ./benchBucket [numComputers]   (默认 10^6 台计算机)
+//
+// 1. 在随机小网络(边权相同、种类少、范围大，含大量平局)上，ENGINE_BUCKET与ENGINE_AUTO的
+//    networkPoodle结果必须与ENGINE_RADIX_HEAP完全相同(时间、入侵顺序、接收者)；
+// 2. 在ER网络与链上，对边权相同、种类少与范围大的几种网络比较基数堆与桶引擎单次networkInfectionTimes的耗时，
+//    并报告桶数量与ENGINE_AUTO的选择(以及它的耗时)。
+
+#include <limits.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../BucketSearch.h"
+#include "../Graph.h"
+#include "../Network.h"
+#include "benchUtil.h"
+#include "netgen.h"
+
+static bool sameResult(struct poodleResult a, struct poodleResult b)
+{
+	if (a.numSteps != b.numSteps)
+		return false;
+	for (int i = 0; i < a.numSteps; i++)
+	{
+		if (a.steps[i].computer != b.steps[i].computer || a.steps[i].time != b.steps[i].time)
+			return false;
+		struct computerList *x = a.steps[i].recipients;
+		struct computerList *y = b.steps[i].recipients;
+		for (; x && y; x = x->next, y = y->next)
+		{
+			if (x->computer != y->computer)
+				return false;
+		}
+		if (x || y)
+			return false;
+	}
+	return true;
+}
+
+static int checkRandom(int seed)
+{
+	uint64_t state = seed;
+	int n = randRange(&state, 1, 300);
+	struct network net = randomNetwork(n, randRange(&state, 0, 8), seed);
+	// 三种边权：全部相同、种类少(大量平局)、范围大(桶多)
+	int kind = seed % 3;
+	int maxTime = kind == 0 ? 1 : kind == 1 ? randRange(&state, 1, 4) : 1000;
+	int base = randRange(&state, 1, 5);
+	for (int v = 0; v < n; v++)
+	{
+		net.computers[v].poodleTime = base * randRange(&state, 1, maxTime);
+		net.computers[v].securityLevel = randRange(&state, 1, 10);
+	}
+	for (int i = 0; i < net.numConnections; i++)
+		net.connections[i].transmissionTime = base * randRange(&state, 1, maxTime);
+
+	Network *handle = openNetwork(net.computers, n, net.connections, net.numConnections);
+	int failures = 0;
+	for (int query = 0; query < 3; query++)
+	{
+		int start = randRange(&state, 0, n - 1);
+		setPoodleEngine(handle, ENGINE_RADIX_HEAP);
+		struct poodleResult expected = networkPoodle(handle, start);
+
+		PoodleEngine engines[] = {ENGINE_BUCKET, ENGINE_AUTO};
+		for (int k = 0; k < 2; k++)
+		{
+			setPoodleEngine(handle, engines[k]);
+			struct poodleResult actual = networkPoodle(handle, start);
+			if (!sameResult(expected, actual))
+			{
+				fprintf(stderr, "benchBucket: seed %d differs (%s)\n", seed, k == 0 ? "bucket" : "auto");
+				failures++;
+			}
+			freePoodleResult(actual);
+		}
+		freePoodleResult(expected);
+	}
+
+	closeNetwork(handle);
+	freeNetwork(&net);
+	return failures;
+}
+
+// 一次networkInfectionTimes的耗时(先跑一次使缓冲区就位)，结果写入time[]
+static int64_t timeEngine(Network *handle, PoodleEngine engine, int time[])
+{
+	setPoodleEngine(handle, engine);
+	networkInfectionTimes(handle, 0, time);
+	int64_t t0 = nowNs();
+	networkInfectionTimes(handle, 0, time);
+	return nowNs() - t0;
+}
+
+static int runWeights(const char *name, Topology topology, TimeDistribution times, int minTime, int maxTime,
+					  int numComputers)
+{
+	GenParams params = defaultGenParams(numComputers);
+	params.topology = topology;
+	params.avgDegree = 8;
+	params.levels = topology == TOPO_CHAIN ? LEVELS_CONSTANT : LEVELS_LOW; // 整条链都能入侵
+	params.poodleTimes = times;
+	params.minPoodleTime = minTime;
+	params.maxPoodleTime = maxTime;
+	params.transmissionTimes = times;
+	params.minTransmissionTime = minTime;
+	params.maxTransmissionTime = maxTime;
+	struct network net = generateNetwork(&params);
+	int n = net.numComputers;
+
+	Graph *graph = buildGraph(net.computers, n, net.connections, net.numConnections);
+	Graph *attack = buildAttackGraph(graph);
+	int buckets = bucketCount(attack);
+	bool suits = bucketSearchSuits(attack);
+	printf("%-16s computers=%d connections=%d weights=[%d, %d] gcd=%d buckets=%d auto=%s\n", name, n,
+		   net.numConnections, attack->minWeight, attack->maxWeight, attack->weightGcd, buckets,
+		   suits ? "bucket" : "radix heap");
+	freeGraph(attack);
+	freeGraph(graph);
+
+	Network *handle = openNetwork(net.computers, n, net.connections, net.numConnections);
+	int *expected = malloc(n * sizeof(int));
+	int *time = malloc(n * sizeof(int));
+	int failures = 0;
+
+	int64_t radix = timeEngine(handle, ENGINE_RADIX_HEAP, expected);
+	printf("  %-12s %12.3f ms\n", "radix heap", radix / 1e6);
+
+	PoodleEngine engines[] = {ENGINE_BUCKET, ENGINE_AUTO};
+	const char *names[] = {"bucket", "auto"};
+	for (int k = 0; k < 2; k++)
+	{
+		int64_t elapsed = timeEngine(handle, engines[k], time);
+		printf("  %-12s %12.3f ms %8.2fx\n", names[k], elapsed / 1e6, (double)radix / elapsed);
+		if (memcmp(expected, time, n * sizeof(int)) != 0)
+		{
+			fprintf(stderr, "benchBucket: %s differs (%s)\n", name, names[k]);
+			failures++;
+		}
+	}
+
+	free(expected);
+	free(time);
+	closeNetwork(handle);
+	freeNetwork(&net);
+	return failures;
+}
+
+int main(int argc, char *argv[])
+{
+	int numComputers = argc > 1 ? atoi(argv[1]) : 1000000;
+	int failures = 0;
+
+	for (int seed = 1; seed <= 3000; seed++)
+		failures += checkRandom(seed);
+	printf("random networks checked: 3000\n");
+
+	failures += runWeights("ER, uniform", TOPO_ERDOS_RENYI, TIMES_CONSTANT, 3, 3, numComputers);
+	failures += runWeights("ER, few", TOPO_ERDOS_RENYI, TIMES_UNIFORM, 1, 10, numComputers);
+	failures += runWeights("ER, range 2000", TOPO_ERDOS_RENYI, TIMES_UNIFORM, 1, 1000, numComputers);
+	failures += runWeights("ER, range 2*10^5", TOPO_ERDOS_RENYI, TIMES_UNIFORM, 1, 100000, numComputers);
+	// 链最深，不同的入侵时间最多，是跳过空桶代价最高的情况
+	failures += runWeights("chain, few", TOPO_CHAIN, TIMES_UNIFORM, 1, 10, numComputers);
+	failures += runWeights("chain, range 2000", TOPO_CHAIN, TIMES_UNIFORM, 1, 1000, numComputers);
+
+	if (failures > 0)
+		return EXIT_FAILURE;
+	printf("all results match\n");
+	return 0;
+}
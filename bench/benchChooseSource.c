@@ -0,0 +1,208 @@
+// 验证与基准测试：基于SCC凝聚图的chooseSource vs 原来从每台计算机分别dfs的实现
+//
+// 用法: ./benchChooseSource [dataDir]   (默认 ../data)
+// 原实现为O(V·(V+E))且递归深度可达V，只在小规模上运行。
+
+#include <dirent.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../Graph.h"
+#include "../Network.h"
+#include "benchUtil.h"
+
+#define LEGACY_LIMIT 5000
+
+////////////////////////////////////////////////////////////////////////
+// 原实现，仅作为对照
+
+static void legacyDfs(Graph *graph, int u, bool visited[], int *count)
+{
+	visited[u] = true;
+	(*count)++;
+	for (int e = graph->offsets[u]; e < graph->offsets[u + 1]; e++)
+	{
+		int v = graph->dest[e];
+		if (!visited[v] &&
+			GRAPH_LEVEL(graph, u) + 1 >= GRAPH_LEVEL(graph, v))
+		{
+			legacyDfs(graph, v, visited, count);
+		}
+	}
+}
+
+static struct chooseSourceResult legacyChooseSource(Graph *graph)
+{
+	struct chooseSourceResult res = {0, 0, NULL};
+	int n = graph->numComputers;
+	for (int src = 0; src < n; src++)
+	{
+		bool *visited = calloc(n, sizeof(bool));
+		int count = 0;
+		legacyDfs(graph, src, visited, &count);
+		if (count > res.numComputers)
+		{
+			res.numComputers = count;
+			res.sourceComputer = src;
+			free(res.computers);
+			res.computers = malloc(count * sizeof(int));
+			int index = 0;
+			for (int i = 0; i < n; i++)
+			{
+				if (visited[i])
+					res.computers[index++] = i;
+			}
+		}
+		free(visited);
+	}
+	return res;
+}
+
+////////////////////////////////////////////////////////////////////////
+
+static bool sameResult(struct chooseSourceResult a, struct chooseSourceResult b)
+{
+	if (a.sourceComputer != b.sourceComputer || a.numComputers != b.numComputers)
+		return false;
+	return memcmp(a.computers, b.computers, a.numComputers * sizeof(int)) == 0;
+}
+
+static bool checkNetwork(struct network *net)
+{
+	Graph *graph = buildGraph(net->computers, net->numComputers, net->connections, net->numConnections);
+	Network *handle = openNetwork(net->computers, net->numComputers, net->connections, net->numConnections);
+
+	struct chooseSourceResult expected = legacyChooseSource(graph);
+	struct chooseSourceResult actual = networkChooseSource(handle);
+	bool ok = sameResult(expected, actual);
+
+	free(expected.computers);
+	free(actual.computers);
+	closeNetwork(handle);
+	freeGraph(graph);
+	return ok;
+}
+
+// 一条长链：安全等级沿链分5段、每段降低2级，只能从高往低入侵，从0出发可以入侵整条链
+static struct network chainNetwork(int n)
+{
+	struct network net = randomNetwork(n, 0, 1);
+	for (int i = 0; i < n; i++)
+		net.computers[i].securityLevel = MAX_SECURITY_LEVEL - 2 * (int)((int64_t)i * 5 / n);
+	for (int i = 1; i < n; i++)
+		net.connections[i - 1] = (struct connection){i - 1, i, 1};
+	return net;
+}
+
+static void timeOne(const char *kind, struct network *net)
+{
+	int n = net->numComputers;
+	printf("%-8s %10d %10d", kind, n, net->numConnections);
+
+	if (n <= LEGACY_LIMIT)
+	{
+		Graph *graph = buildGraph(net->computers, n, net->connections, net->numConnections);
+		int64_t t0 = nowNs();
+		struct chooseSourceResult res = legacyChooseSource(graph);
+		printf(" %12.3f", (nowNs() - t0) / 1e6);
+		free(res.computers);
+		freeGraph(graph);
+	}
+	else
+	{
+		printf(" %12s", "-");
+	}
+
+	// 计时包括第一次查询时构建凝聚图的开销
+	Network *handle = openNetwork(net->computers, n, net->connections, net->numConnections);
+	int64_t t0 = nowNs();
+	struct chooseSourceResult res = networkChooseSource(handle);
+	int64_t t1 = nowNs();
+	struct chooseSourceResult again = networkChooseSource(handle);
+	int64_t t2 = nowNs();
+	printf(" %12.3f %12.3f   source=%d reach=%d\n", (t1 - t0) / 1e6, (t2 - t1) / 1e6,
+		   res.sourceComputer, res.numComputers);
+
+	free(res.computers);
+	free(again.computers);
+	closeNetwork(handle);
+}
+
+int main(int argc, char *argv[])
+{
+	const char *dataDir = argc > 1 ? argv[1] : "../data";
+	int failures = 0;
+	int checked = 0;
+
+	DIR *dir = opendir(dataDir);
+	if (dir)
+	{
+		struct dirent *entry;
+		while ((entry = readdir(dir)))
+		{
+			if (strncmp(entry->d_name, "network-", 8) != 0)
+				continue;
+			char path[1024];
+			snprintf(path, sizeof(path), "%s/%s", dataDir, entry->d_name);
+			struct network net = readNetwork(path);
+			if (net.numComputers == 0)
+				continue;
+			if (!checkNetwork(&net))
+			{
+				fprintf(stderr, "benchChooseSource: mismatch on %s\n", entry->d_name);
+				failures++;
+			}
+			checked++;
+			freeNetwork(&net);
+		}
+		closedir(dir);
+	}
+	printf("data files checked: %d\n", checked);
+
+	for (int seed = 1; seed <= 3000; seed++)
+	{
+		uint64_t state = seed;
+		int n = randRange(&state, 1, 200);
+		struct network net = randomNetwork(n, randRange(&state, 1, 5), seed);
+		if (!checkNetwork(&net))
+		{
+			fprintf(stderr, "benchChooseSource: mismatch on random seed %d\n", seed);
+			failures++;
+		}
+		freeNetwork(&net);
+	}
+	printf("random networks checked: 3000\n");
+
+	// 没有计算机的网络：没有可选的源
+	Network *empty = openNetwork(NULL, 0, NULL, 0);
+	struct chooseSourceResult none = empty ? networkChooseSource(empty) : (struct chooseSourceResult){0, 0, NULL};
+	if (!empty || none.sourceComputer != 0 || none.numComputers != 0 || none.computers)
+	{
+		fprintf(stderr, "benchChooseSource: wrong result on an empty network\n");
+		failures++;
+	}
+	closeNetwork(empty);
+
+	printf("%-8s %10s %10s %12s %12s %12s\n", "network", "computers", "conns",
+		   "legacy ms", "scc ms", "cached ms");
+	int sizes[] = {1000, 5000, 100000, 1000000};
+	for (int k = 0; k < (int)(sizeof(sizes) / sizeof(sizes[0])); k++)
+	{
+		struct network net = randomNetwork(sizes[k], 4, 2521);
+		timeOne("random", &net);
+		freeNetwork(&net);
+	}
+	struct network chain = chainNetwork(1000000);
+	timeOne("chain", &chain);
+	freeNetwork(&chain);
+
+	if (failures > 0)
+	{
+		fprintf(stderr, "benchChooseSource: %d mismatches\n", failures);
+		return EXIT_FAILURE;
+	}
+	printf("all results match\n");
+	return 0;
+}
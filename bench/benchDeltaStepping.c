@@ -0,0 +1,146 @@
+// 验证与基准测试：并行delta-stepping引擎 vs 顺序Dijkstra(基数堆)
+//
+// 用法: ./benchDeltaStepping [numComputers] [maxThreads]   (默认 10^6 台计算机、8个线程)
+//
+// 1. 在随机小网络(含大量平局)上，ENGINE_DELTA_STEPPING的networkPoodle结果必须与
+//    ENGINE_RADIX_HEAP完全相同(时间、入侵顺序、接收者)，线程数为1与3；
+// 2. 在ER、幂律、网格三种大网络上比较单次networkInfectionTimes的耗时，
+//    线程数从1翻倍到maxThreads，报告相对顺序引擎的加速比。
+
+#include <limits.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../Network.h"
+#include "../ThreadPool.h"
+#include "benchUtil.h"
+#include "netgen.h"
+
+static bool sameResult(struct poodleResult a, struct poodleResult b)
+{
+	if (a.numSteps != b.numSteps)
+		return false;
+	for (int i = 0; i < a.numSteps; i++)
+	{
+		if (a.steps[i].computer != b.steps[i].computer || a.steps[i].time != b.steps[i].time)
+			return false;
+		struct computerList *x = a.steps[i].recipients;
+		struct computerList *y = b.steps[i].recipients;
+		for (; x && y; x = x->next, y = y->next)
+		{
+			if (x->computer != y->computer)
+				return false;
+		}
+		if (x || y)
+			return false;
+	}
+	return true;
+}
+
+static int checkRandom(int seed)
+{
+	uint64_t state = seed;
+	int n = randRange(&state, 1, 300);
+	struct network net = randomNetwork(n, randRange(&state, 0, 8), seed);
+	int maxTime = randRange(&state, 1, 6); // 时间范围小时平局多
+	for (int v = 0; v < n; v++)
+		net.computers[v].poodleTime = randRange(&state, 1, maxTime);
+	for (int i = 0; i < net.numConnections; i++)
+		net.connections[i].transmissionTime = randRange(&state, 1, maxTime);
+
+	Network *handle = openNetwork(net.computers, n, net.connections, net.numConnections);
+	int start = randRange(&state, 0, n - 1);
+	struct poodleResult expected = networkPoodle(handle, start);
+
+	int failures = 0;
+	setPoodleEngine(handle, ENGINE_DELTA_STEPPING);
+	int threads[] = {1, 3};
+	for (int t = 0; t < 2; t++)
+	{
+		setPoodleThreads(handle, threads[t]);
+		struct poodleResult actual = networkPoodle(handle, start);
+		if (!sameResult(expected, actual))
+		{
+			fprintf(stderr, "benchDeltaStepping: seed %d differs with %d threads\n", seed, threads[t]);
+			failures++;
+		}
+		freePoodleResult(actual);
+	}
+
+	freePoodleResult(expected);
+	closeNetwork(handle);
+	freeNetwork(&net);
+	return failures;
+}
+
+static int runTopology(Topology topology, int numComputers, int maxThreads)
+{
+	GenParams params = defaultGenParams(numComputers);
+	params.topology = topology;
+	params.avgDegree = 8;
+	params.levels = LEVELS_LOW;
+	struct network net = generateNetwork(&params);
+	Network *handle = openNetwork(net.computers, net.numComputers, net.connections, net.numConnections);
+
+	int n = net.numComputers;
+	int *expected = malloc(n * sizeof(int));
+	int *time = malloc(n * sizeof(int));
+	int failures = 0;
+
+	// 顺序引擎，先跑一次使优先队列就位
+	networkInfectionTimes(handle, 0, expected);
+	int64_t t0 = nowNs();
+	int reached = networkInfectionTimes(handle, 0, expected);
+	int64_t sequential = nowNs() - t0;
+	printf("%-12s computers=%d connections=%d reached=%d\n", topologyName(topology), n,
+		   net.numConnections, reached);
+	printf("  %-24s %12.3f ms\n", "sequential (radix heap)", sequential / 1e6);
+
+	setPoodleEngine(handle, ENGINE_DELTA_STEPPING);
+	for (int threads = 1; threads <= maxThreads; threads *= 2)
+	{
+		setPoodleThreads(handle, threads);
+		networkInfectionTimes(handle, 0, time); // 线程池就位
+		t0 = nowNs();
+		networkInfectionTimes(handle, 0, time);
+		int64_t elapsed = nowNs() - t0;
+
+		char name[64];
+		snprintf(name, sizeof(name), "delta-stepping, %d thread%s", threads, threads > 1 ? "s" : "");
+		printf("  %-24s %12.3f ms %8.2fx\n", name, elapsed / 1e6, (double)sequential / elapsed);
+		if (memcmp(expected, time, n * sizeof(int)) != 0)
+		{
+			fprintf(stderr, "benchDeltaStepping: %s differs with %d threads\n", topologyName(topology), threads);
+			failures++;
+		}
+	}
+
+	free(expected);
+	free(time);
+	closeNetwork(handle);
+	freeNetwork(&net);
+	return failures;
+}
+
+int main(int argc, char *argv[])
+{
+	int numComputers = argc > 1 ? atoi(argv[1]) : 1000000;
+	int maxThreads = argc > 2 ? atoi(argv[2]) : 8;
+	int failures = 0;
+
+	for (int seed = 1; seed <= 2000; seed++)
+		failures += checkRandom(seed);
+	printf("random networks checked: 2000\n");
+	printf("cpus=%d\n", onlineCpuCount());
+
+	Topology topologies[] = {TOPO_ERDOS_RENYI, TOPO_POWER_LAW, TOPO_GRID};
+	for (int k = 0; k < 3; k++)
+		failures += runTopology(topologies[k], numComputers, maxThreads);
+
+	if (failures > 0)
+		return EXIT_FAILURE;
+	printf("all results match\n");
+	return 0;
+}
@@ -0,0 +1,222 @@
+// 验证与基准测试：稠密网络的SIMD数组扫描引擎(ENGINE_DENSE)
+//
+// 用法: ./benchDense [numComputers]   (默认 4000 台计算机)
+//
+// 1. 在随机小网络(稀疏到完全图、含大量平局)上，每一种CPU支持的核(标量/AVX2/AVX-512)的
+//    time/parent/order都必须相同，ENGINE_DENSE与ENGINE_AUTO的networkPoodle结果必须与ENGINE_RADIX_HEAP
+//    完全相同，重排过的句柄也一样；
+// 2. 在不同密度(E / V²)的随机网络上比较基数堆、桶引擎与各个核单次查询的耗时，
+//    并报告矩阵的构建时间与ENGINE_AUTO的选择。
+
+#include <limits.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../BucketSearch.h"
+#include "../DenseSearch.h"
+#include "../Graph.h"
+#include "../Network.h"
+#include "benchUtil.h"
+#include "netgen.h"
+
+static bool sameResult(struct poodleResult a, struct poodleResult b)
+{
+	if (a.numSteps != b.numSteps)
+		return false;
+	for (int i = 0; i < a.numSteps; i++)
+	{
+		if (a.steps[i].computer != b.steps[i].computer || a.steps[i].time != b.steps[i].time)
+			return false;
+		struct computerList *x = a.steps[i].recipients;
+		struct computerList *y = b.steps[i].recipients;
+		for (; x && y; x = x->next, y = y->next)
+		{
+			if (x->computer != y->computer)
+				return false;
+		}
+		if (x || y)
+			return false;
+	}
+	return true;
+}
+
+// 比较两个句柄上同一起点的poodle结果
+static int comparePoodle(Network *expected, PoodleEngine expectedEngine, Network *actual, PoodleEngine engine,
+						 int start)
+{
+	setPoodleEngine(expected, expectedEngine);
+	setPoodleEngine(actual, engine);
+	struct poodleResult a = networkPoodle(expected, start);
+	struct poodleResult b = networkPoodle(actual, start);
+	int failures = !sameResult(a, b);
+	freePoodleResult(a);
+	freePoodleResult(b);
+	return failures;
+}
+
+// 每一种可用的核与标量核的time/parent/order相同
+static int compareKernels(Graph *attack, int start)
+{
+	int n = attack->numComputers;
+	DenseMatrix *matrix = buildDenseMatrix(attack);
+	int *time = malloc(2 * n * sizeof(int));
+	int *parent = malloc(2 * n * sizeof(int));
+	int *order = malloc(2 * n * sizeof(int));
+	int failures = 0;
+
+	int expected = denseSearch(matrix, attack, DENSE_KERNEL_SCALAR, start, time, parent, order);
+	for (DenseKernel kernel = DENSE_KERNEL_AVX2; kernel <= denseBestKernel(); kernel++)
+	{
+		int count = denseSearch(matrix, attack, kernel, start, time + n, parent + n, order + n);
+		failures += count != expected || memcmp(time, time + n, n * sizeof(int)) != 0 ||
+					memcmp(parent, parent + n, n * sizeof(int)) != 0 ||
+					memcmp(order, order + n, count * sizeof(int)) != 0;
+	}
+
+	free(time);
+	free(parent);
+	free(order);
+	freeDenseMatrix(matrix);
+	return failures;
+}
+
+static int checkRandom(int seed)
+{
+	uint64_t state = seed;
+	int n = randRange(&state, 1, 120);
+	// 平均度数从稀疏到接近完全图
+	struct network net = randomNetwork(n, randRange(&state, 0, n), seed);
+	int maxTime = randRange(&state, 1, 4) == 1 ? 1000 : randRange(&state, 1, 4);
+	for (int v = 0; v < n; v++)
+	{
+		net.computers[v].poodleTime = randRange(&state, 1, maxTime);
+		net.computers[v].securityLevel = randRange(&state, 1, 10);
+	}
+	for (int i = 0; i < net.numConnections; i++)
+		net.connections[i].transmissionTime = randRange(&state, 1, maxTime);
+
+	int failures = 0;
+	Graph *graph = buildGraph(net.computers, n, net.connections, net.numConnections);
+	Graph *attack = buildAttackGraph(graph);
+	Network *handle = openNetwork(net.computers, n, net.connections, net.numConnections);
+	Network *ordered = openNetworkOrdered(net.computers, n, net.connections, net.numConnections, ORDER_RCM);
+	for (int query = 0; query < 3; query++)
+	{
+		int start = randRange(&state, 0, n - 1);
+		failures += compareKernels(attack, start);
+		failures += comparePoodle(handle, ENGINE_RADIX_HEAP, handle, ENGINE_DENSE, start);
+		failures += comparePoodle(handle, ENGINE_RADIX_HEAP, handle, ENGINE_AUTO, start);
+		failures += comparePoodle(handle, ENGINE_RADIX_HEAP, ordered, ENGINE_DENSE, start);
+	}
+
+	if (failures > 0)
+		fprintf(stderr, "benchDense: seed %d has %d mismatches\n", seed, failures);
+	closeNetwork(ordered);
+	closeNetwork(handle);
+	freeGraph(attack);
+	freeGraph(graph);
+	freeNetwork(&net);
+	return failures;
+}
+
+#define QUERIES 3
+
+// QUERIES次networkInfectionTimes的平均耗时(先跑一次使缓冲区与矩阵就位)，最后一次的结果写入time[]
+static double timeEngine(Network *handle, PoodleEngine engine, int time[])
+{
+	setPoodleEngine(handle, engine);
+	networkInfectionTimes(handle, 0, time);
+	int64_t t0 = nowNs();
+	for (int q = 0; q < QUERIES; q++)
+		networkInfectionTimes(handle, q, time);
+	return (nowNs() - t0) / 1e6 / QUERIES;
+}
+
+static int runDensity(int numComputers, int divisor)
+{
+	GenParams params = defaultGenParams(numComputers);
+	params.avgDegree = numComputers / divisor; // E / V² 约为 1 / divisor
+	params.levels = LEVELS_CONSTANT;           // 攻击图与原图一样稠密
+	struct network net = generateNetwork(&params);
+	int n = net.numComputers;
+
+	Graph *graph = buildGraph(net.computers, n, net.connections, net.numConnections);
+	Graph *attack = buildAttackGraph(graph);
+	int64_t t0 = nowNs();
+	DenseMatrix *matrix = buildDenseMatrix(attack);
+	double build = (nowNs() - t0) / 1e6;
+	double density = (double)attack->numEdges / ((double)n * n);
+	const char *choice = denseSearchSuits(attack) ? "dense" : bucketSearchSuits(attack) ? "bucket" : "radix heap";
+
+	Network *handle = openNetwork(net.computers, n, net.connections, net.numConnections);
+	int *expected = malloc(n * sizeof(int));
+	int *time = malloc(n * sizeof(int));
+	int *parent = malloc(n * sizeof(int));
+	int *order = malloc(n * sizeof(int));
+	int failures = 0;
+
+	double radix = timeEngine(handle, ENGINE_RADIX_HEAP, expected);
+	double bucket = timeEngine(handle, ENGINE_BUCKET, time);
+	failures += memcmp(expected, time, n * sizeof(int)) != 0;
+
+	// 三种核直接在矩阵上计时(含parent[]，与poodle相同)
+	double kernels[3] = {-1, -1, -1};
+	for (DenseKernel kernel = DENSE_KERNEL_SCALAR; kernel <= denseBestKernel(); kernel++)
+	{
+		t0 = nowNs();
+		for (int q = 0; q < QUERIES; q++)
+			denseSearch(matrix, attack, kernel, q, time, parent, order);
+		kernels[kernel] = (nowNs() - t0) / 1e6 / QUERIES;
+		failures += memcmp(expected, time, n * sizeof(int)) != 0;
+	}
+	double automatic = timeEngine(handle, ENGINE_AUTO, time);
+	failures += memcmp(expected, time, n * sizeof(int)) != 0;
+
+	printf("  %7.4f %10d %9.1f %9.3f %9.3f", density, attack->numEdges, build, radix, bucket);
+	for (int k = 0; k < 3; k++)
+	{
+		if (kernels[k] >= 0)
+			printf(" %9.3f", kernels[k]);
+		else
+			printf(" %9s", "-");
+	}
+	printf(" %9.3f  %s\n", automatic, choice);
+	if (failures > 0)
+		fprintf(stderr, "benchDense: density 1/%d results differ\n", divisor);
+
+	free(expected);
+	free(time);
+	free(parent);
+	free(order);
+	closeNetwork(handle);
+	freeDenseMatrix(matrix);
+	freeGraph(attack);
+	freeGraph(graph);
+	freeNetwork(&net);
+	return failures;
+}
+
+int main(int argc, char *argv[])
+{
+	int numComputers = argc > 1 ? atoi(argv[1]) : 4000;
+	int failures = 0;
+
+	printf("best kernel: %s\n", denseKernelName(denseBestKernel()));
+	for (int seed = 1; seed <= 2000; seed++)
+		failures += checkRandom(seed);
+	printf("random networks checked: 2000\n");
+
+	printf("computers=%d, ms per query\n", numComputers);
+	printf("  %7s %10s %9s %9s %9s %9s %9s %9s %9s  %s\n", "E/V^2", "edges", "build", "radix", "bucket", "scalar",
+		   "avx2", "avx512", "auto", "auto choice");
+	int divisors[] = {1, 2, 4, 8, 16, 32, 64};
+	for (int k = 0; k < 7; k++)
+		failures += runDensity(numComputers, divisors[k]);
+
+	if (failures > 0)
+		return EXIT_FAILURE;
+	printf("all results match\n");
+	return 0;
+}
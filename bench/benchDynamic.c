@@ -0,0 +1,262 @@
+// 验证与基准测试：动态poodle的增量修复 vs 每次更新后完整重算
+//
+// 用法: ./benchDynamic [numComputers] [numUpdates]   (默认 10^6 台计算机、2000次更新)
+//
+// 1. 在大量随机小网络上施加随机的更新流(新增/删除连接、修改传输时间、修改安全等级)，
+//    每次更新后dynamicPoodleResult必须与在当前网络上重新打开句柄调用networkPoodle的结果完全相同；
+// 2. 在大网络上比较每次更新的增量修复耗时与完整重算(建图 + 一次poodle搜索)的耗时，
+//    报告每类更新的平均耗时与平均受影响的计算机数量，最后再与完整重算的结果比较一次。
+
+#include <limits.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../Dynamic.h"
+#include "../Network.h"
+#include "benchUtil.h"
+
+#define NUM_KINDS 4
+static const char *kindNames[NUM_KINDS] = {"add connection", "remove connection", "set time", "set level"};
+
+// 与DynamicPoodle同步维护的网络，用于完整重算
+typedef struct Mirror
+{
+	struct network net; // connections[i]即编号为i的连接
+	bool *alive;
+	int cap;
+} Mirror;
+
+static Mirror makeMirror(struct network net)
+{
+	Mirror m = {net, malloc((net.numConnections + 1) * sizeof(bool)), net.numConnections + 1};
+	m.net.connections = realloc(m.net.connections, m.cap * sizeof(struct connection));
+	for (int i = 0; i < net.numConnections; i++)
+		m.alive[i] = true;
+	return m;
+}
+
+static void freeMirror(Mirror *m)
+{
+	free(m->alive);
+	freeNetwork(&m->net);
+}
+
+// 对两边施加同一个随机更新，返回更新的种类；参数不合法时两边都应拒绝
+static int randomUpdate(DynamicPoodle *dp, Mirror *m, uint64_t *state, int maxTime, int *failures)
+{
+	int n = m->net.numComputers;
+	int kind = randRange(state, 0, NUM_KINDS - 1);
+	int c = m->net.numConnections > 0 ? randRange(state, 0, m->net.numConnections - 1) : -1;
+
+	if (kind == 0 || c == -1 || !m->alive[c])
+	{
+		kind = 0;
+		int a = randRange(state, 0, n - 1);
+		int b = randRange(state, 0, n - 1);
+		int t = randRange(state, 1, maxTime);
+		int id = dynamicAddConnection(dp, a, b, t);
+		if (a == b)
+		{
+			*failures += id != -1;
+			return kind;
+		}
+		if (id != m->net.numConnections)
+		{
+			(*failures)++;
+			return kind;
+		}
+		if (m->net.numConnections == m->cap)
+		{
+			m->cap *= 2;
+			m->net.connections = realloc(m->net.connections, m->cap * sizeof(struct connection));
+			m->alive = realloc(m->alive, m->cap * sizeof(bool));
+		}
+		m->net.connections[id] = (struct connection){a, b, t};
+		m->alive[id] = true;
+		m->net.numConnections++;
+	}
+	else if (kind == 1)
+	{
+		*failures += !dynamicRemoveConnection(dp, c);
+		*failures += dynamicRemoveConnection(dp, c); // 已删除的连接必须被拒绝
+		m->alive[c] = false;
+	}
+	else if (kind == 2)
+	{
+		int t = randRange(state, 1, maxTime);
+		*failures += !dynamicSetTransmissionTime(dp, c, t);
+		m->net.connections[c].transmissionTime = t;
+	}
+	else
+	{
+		int v = randRange(state, 0, n - 1);
+		int level = randRange(state, 1, MAX_SECURITY_LEVEL);
+		*failures += !dynamicSetSecurityLevel(dp, v, level);
+		m->net.computers[v].securityLevel = level;
+	}
+	return kind;
+}
+
+// 在镜像的当前网络上完整重算：打开句柄(建图)后做一次poodle
+static struct poodleResult recompute(Mirror *m, int start)
+{
+	struct connection *live = malloc((m->net.numConnections + 1) * sizeof(struct connection));
+	int k = 0;
+	for (int i = 0; i < m->net.numConnections; i++)
+	{
+		if (m->alive[i])
+			live[k++] = m->net.connections[i];
+	}
+	Network *handle = openNetwork(m->net.computers, m->net.numComputers, live, k);
+	struct poodleResult res = networkPoodle(handle, start);
+	closeNetwork(handle);
+	free(live);
+	return res;
+}
+
+static bool sameResult(struct poodleResult a, struct poodleResult b)
+{
+	if (a.numSteps != b.numSteps)
+		return false;
+	for (int i = 0; i < a.numSteps; i++)
+	{
+		if (a.steps[i].computer != b.steps[i].computer || a.steps[i].time != b.steps[i].time)
+			return false;
+		struct computerList *x = a.steps[i].recipients;
+		struct computerList *y = b.steps[i].recipients;
+		for (; x && y; x = x->next, y = y->next)
+		{
+			if (x->computer != y->computer)
+				return false;
+		}
+		if (x || y)
+			return false;
+	}
+	return true;
+}
+
+static bool checkAgainstRecompute(DynamicPoodle *dp, Mirror *m, int start)
+{
+	struct poodleResult expected = recompute(m, start);
+	struct poodleResult actual = dynamicPoodleResult(dp);
+	bool ok = sameResult(expected, actual) && dynamicNumInfected(dp) == expected.numSteps;
+	freePoodleResult(expected);
+	freePoodleResult(actual);
+	return ok;
+}
+
+static int checkRandom(int seed)
+{
+	uint64_t state = seed;
+	int n = randRange(&state, 2, 40);
+	Mirror m = makeMirror(randomNetwork(n, randRange(&state, 1, 6), seed));
+	int maxTime = randRange(&state, 1, 8); // 传输时间范围小时平局多，检验parent的选择规则
+	for (int v = 0; v < n; v++)
+		m.net.computers[v].poodleTime = randRange(&state, 1, maxTime);
+
+	int start = randRange(&state, 0, n - 1);
+	DynamicPoodle *dp = createDynamicPoodle(m.net.computers, n, m.net.connections, m.net.numConnections, start);
+	int failures = !checkAgainstRecompute(dp, &m, start);
+
+	for (int u = 0; u < 60 && failures == 0; u++)
+	{
+		randomUpdate(dp, &m, &state, maxTime, &failures);
+		if (!checkAgainstRecompute(dp, &m, start))
+		{
+			fprintf(stderr, "benchDynamic: seed %d differs after update %d\n", seed, u);
+			failures++;
+		}
+	}
+
+	// 非法参数
+	failures += dynamicAddConnection(dp, 0, n, 1) != -1;
+	failures += dynamicAddConnection(dp, 0, 1, 0) != -1;
+	failures += dynamicSetTransmissionTime(dp, -1, 1);
+	failures += dynamicSetSecurityLevel(dp, 0, MAX_SECURITY_LEVEL + 1);
+
+	freeDynamicPoodle(dp);
+	freeMirror(&m);
+	return failures;
+}
+
+int main(int argc, char *argv[])
+{
+	int numComputers = argc > 1 ? atoi(argv[1]) : 1000000;
+	int numUpdates = argc > 2 ? atoi(argv[2]) : 2000;
+	int failures = 0;
+
+	for (int seed = 1; seed <= 2000; seed++)
+		failures += checkRandom(seed);
+	printf("random update streams checked: 2000\n");
+
+	Mirror m = makeMirror(randomNetwork(numComputers, 4, 2521));
+	int start = 0;
+	printf("computers=%d connections=%d updates=%d\n", numComputers, m.net.numConnections, numUpdates);
+
+	int64_t t0 = nowNs();
+	DynamicPoodle *dp = createDynamicPoodle(m.net.computers, numComputers, m.net.connections,
+											m.net.numConnections, start);
+	printf("create (full search)  : %10.3f ms, %d infected\n", (nowNs() - t0) / 1e6, dynamicNumInfected(dp));
+
+	// 完整重算的代价：在当前网络上建图并搜索，取几次的平均
+	int *time = malloc(numComputers * sizeof(int));
+	int64_t fullNs = 0;
+	int fullRuns = 3;
+	for (int r = 0; r < fullRuns; r++)
+	{
+		t0 = nowNs();
+		Network *handle = openNetwork(m.net.computers, numComputers, m.net.connections, m.net.numConnections);
+		networkInfectionTimes(handle, start, time);
+		closeNetwork(handle);
+		fullNs += nowNs() - t0;
+	}
+	fullNs /= fullRuns;
+	free(time);
+
+	int64_t kindNs[NUM_KINDS] = {0};
+	long long kindAffected[NUM_KINDS] = {0};
+	int kindCount[NUM_KINDS] = {0};
+	uint64_t state = 42;
+	for (int u = 0; u < numUpdates; u++)
+	{
+		t0 = nowNs();
+		int kind = randomUpdate(dp, &m, &state, 100, &failures);
+		kindNs[kind] += nowNs() - t0;
+		kindAffected[kind] += dynamicLastAffected(dp);
+		kindCount[kind]++;
+	}
+
+	printf("%-20s %8s %14s %14s %10s\n", "update", "count", "avg us", "avg affected", "speedup");
+	int64_t totalNs = 0;
+	for (int k = 0; k < NUM_KINDS; k++)
+	{
+		totalNs += kindNs[k];
+		if (kindCount[k] == 0)
+			continue;
+		double avgNs = (double)kindNs[k] / kindCount[k];
+		printf("%-20s %8d %14.3f %14.1f %9.0fx\n", kindNames[k], kindCount[k], avgNs / 1e3,
+			   (double)kindAffected[k] / kindCount[k], fullNs / avgNs);
+	}
+	printf("full recompute        : %10.3f ms per update\n", fullNs / 1e6);
+	printf("incremental, all      : %10.3f ms for %d updates (%.0fx)\n", totalNs / 1e6, numUpdates,
+		   (double)fullNs * numUpdates / totalNs);
+
+	if (!checkAgainstRecompute(dp, &m, start))
+	{
+		fprintf(stderr, "benchDynamic: large network differs from full recompute\n");
+		failures++;
+	}
+
+	freeDynamicPoodle(dp);
+	freeMirror(&m);
+
+	if (failures > 0)
+	{
+		fprintf(stderr, "benchDynamic: %d failures\n", failures);
+		return EXIT_FAILURE;
+	}
+	printf("all results match\n");
+	return 0;
+}
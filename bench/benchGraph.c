@@ -0,0 +1,215 @@
+// 基准测试：CSR图 vs 旧的逐边malloc链表图
+//
+// 用法: ./benchGraph [numComputers ...]
+// 对每个规模分别测量建图时间、全图邻居遍历时间，以及一次按安全等级
+// 过滤的BFS(即dfs/poodle中的访问模式)的时间。
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../Graph.h"
+#include "benchUtil.h"
+
+////////////////////////////////////////////////////////////////////////
+// 旧实现(链表邻接表)，仅作为对照
+
+typedef struct ListEdge
+{
+	int dest;
+	int transmissionTime;
+	struct ListEdge *next;
+} ListEdge;
+
+typedef struct ListGraph
+{
+	int numComputers;
+	ListEdge **headEdge;
+} ListGraph;
+
+static ListGraph *buildListGraph(int numComputers, struct connection connections[], int numConnections)
+{
+	ListGraph *graph = malloc(sizeof(ListGraph));
+	graph->numComputers = numComputers;
+	graph->headEdge = calloc(numComputers, sizeof(ListEdge *));
+
+	for (int i = 0; i < numConnections; i++)
+	{
+		int src = connections[i].computerA;
+		int dest = connections[i].computerB;
+
+		ListEdge *edge = malloc(sizeof(ListEdge));
+		edge->dest = dest;
+		edge->transmissionTime = connections[i].transmissionTime;
+		edge->next = graph->headEdge[src];
+		graph->headEdge[src] = edge;
+
+		edge = malloc(sizeof(ListEdge));
+		edge->dest = src;
+		edge->transmissionTime = connections[i].transmissionTime;
+		edge->next = graph->headEdge[dest];
+		graph->headEdge[dest] = edge;
+	}
+	return graph;
+}
+
+static void freeListGraph(ListGraph *graph)
+{
+	for (int i = 0; i < graph->numComputers; i++)
+	{
+		ListEdge *edge = graph->headEdge[i];
+		while (edge)
+		{
+			ListEdge *next = edge->next;
+			free(edge);
+			edge = next;
+		}
+	}
+	free(graph->headEdge);
+	free(graph);
+}
+
+////////////////////////////////////////////////////////////////////////
+// 遍历
+
+static long long sweepList(ListGraph *graph)
+{
+	long long sum = 0;
+	for (int u = 0; u < graph->numComputers; u++)
+	{
+		for (ListEdge *edge = graph->headEdge[u]; edge; edge = edge->next)
+		{
+			sum += edge->dest + edge->transmissionTime;
+		}
+	}
+	return sum;
+}
+
+static long long sweepCsr(Graph *graph)
+{
+	long long sum = 0;
+	for (int u = 0; u < graph->numComputers; u++)
+	{
+		for (int e = graph->offsets[u]; e < graph->offsets[u + 1]; e++)
+		{
+			sum += graph->dest[e] + graph->transmissionTime[e];
+		}
+	}
+	return sum;
+}
+
+static int bfsList(ListGraph *graph, struct computer computers[], int *queue, bool *visited)
+{
+	int head = 0, tail = 0;
+	queue[tail++] = 0;
+	visited[0] = true;
+	while (head < tail)
+	{
+		int u = queue[head++];
+		for (ListEdge *edge = graph->headEdge[u]; edge; edge = edge->next)
+		{
+			int v = edge->dest;
+			if (!visited[v] && computers[u].securityLevel + 1 >= computers[v].securityLevel)
+			{
+				visited[v] = true;
+				queue[tail++] = v;
+			}
+		}
+	}
+	return tail;
+}
+
+static int bfsCsr(Graph *graph, int *queue, bool *visited)
+{
+	int head = 0, tail = 0;
+	queue[tail++] = 0;
+	visited[0] = true;
+	while (head < tail)
+	{
+		int u = queue[head++];
+		for (int e = graph->offsets[u]; e < graph->offsets[u + 1]; e++)
+		{
+			int v = graph->dest[e];
+			if (!visited[v] &&
+				GRAPH_LEVEL(graph, u) + 1 >= GRAPH_LEVEL(graph, v))
+			{
+				visited[v] = true;
+				queue[tail++] = v;
+			}
+		}
+	}
+	return tail;
+}
+
+////////////////////////////////////////////////////////////////////////
+
+static double ms(int64_t ns)
+{
+	return ns / 1e6;
+}
+
+static void runOne(int numComputers)
+{
+	struct network net = randomNetwork(numComputers, 8, 2521);
+	int *queue = malloc(numComputers * sizeof(int));
+	bool *visited = malloc(numComputers * sizeof(bool));
+
+	int64_t t0 = nowNs();
+	ListGraph *list = buildListGraph(net.numComputers, net.connections, net.numConnections);
+	int64_t t1 = nowNs();
+	Graph *csr = buildGraph(net.computers, net.numComputers, net.connections, net.numConnections);
+	int64_t t2 = nowNs();
+
+	long long sumList = sweepList(list);
+	int64_t t3 = nowNs();
+	long long sumCsr = sweepCsr(csr);
+	int64_t t4 = nowNs();
+
+	for (int i = 0; i < numComputers; i++)
+		visited[i] = false;
+	int64_t t5 = nowNs();
+	int reachList = bfsList(list, net.computers, queue, visited);
+	int64_t t6 = nowNs();
+	for (int i = 0; i < numComputers; i++)
+		visited[i] = false;
+	int64_t t7 = nowNs();
+	int reachCsr = bfsCsr(csr, queue, visited);
+	int64_t t8 = nowNs();
+
+	if (sumList != sumCsr || reachList != reachCsr)
+	{
+		fprintf(stderr, "benchGraph: CSR and list graphs disagree (n=%d)\n", numComputers);
+		exit(EXIT_FAILURE);
+	}
+
+	printf("%10d %10d | build %9.2f %9.2f (x%5.2f) | sweep %8.2f %8.2f (x%5.2f) | bfs %8.2f %8.2f (x%5.2f)\n",
+		   numComputers, net.numConnections,
+		   ms(t1 - t0), ms(t2 - t1), (double)(t1 - t0) / (t2 - t1),
+		   ms(t3 - t2), ms(t4 - t3), (double)(t3 - t2) / (t4 - t3),
+		   ms(t6 - t5), ms(t8 - t7), (double)(t6 - t5) / (t8 - t7));
+
+	freeListGraph(list);
+	freeGraph(csr);
+	free(queue);
+	free(visited);
+	freeNetwork(&net);
+}
+
+int main(int argc, char *argv[])
+{
+	printf("%10s %10s | %-34s | %-32s | %-30s\n", "computers", "conns",
+		   "build ms: list csr (speedup)", "sweep ms: list csr (speedup)", "bfs ms: list csr (speedup)");
+
+	if (argc > 1)
+	{
+		for (int i = 1; i < argc; i++)
+			runOne(atoi(argv[i]));
+	}
+	else
+	{
+		runOne(10000);
+		runOne(100000);
+		runOne(1000000);
+	}
+	return 0;
+}
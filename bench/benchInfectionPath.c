@@ -0,0 +1,161 @@
+// 验证与基准测试：点到点查询(双向Dijkstra)
+//
+// 用法: ./benchInfectionPath [numComputers] [numQueries]   (默认 10^6 台计算机、1000次查询)
+//
+// 1. 在随机小网络(含大量平局与安全等级限制)上，networkInfectionPath的时间必须等于
+//    networkInfectionTimes中目标的时间，路径必须从源开始、到目标结束，每一步都有连接且权限合法，
+//    并且路径的总时间等于返回的时间；
+// 2. 在大网络上测量随机源到随机目标的查询延迟(平均、p50、p99)，与一次完整搜索比较。
+
+#include <limits.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../Network.h"
+#include "benchUtil.h"
+
+// u与v之间最短的连接时间，没有连接时为INT_MAX
+static int connectionTime(struct network *net, int u, int v)
+{
+	int best = INT_MAX;
+	for (int i = 0; i < net->numConnections; i++)
+	{
+		struct connection c = net->connections[i];
+		if (((c.computerA == u && c.computerB == v) || (c.computerA == v && c.computerB == u)) &&
+			c.transmissionTime < best)
+			best = c.transmissionTime;
+	}
+	return best;
+}
+
+static bool validPath(struct network *net, InfectionPath path, int source, int target)
+{
+	if (path.length == 0 || path.computers[0] != source || path.computers[path.length - 1] != target)
+		return false;
+
+	long long total = net->computers[source].poodleTime;
+	for (int i = 1; i < path.length; i++)
+	{
+		int u = path.computers[i - 1];
+		int v = path.computers[i];
+		int t = connectionTime(net, u, v);
+		if (t == INT_MAX || net->computers[u].securityLevel + 1 < net->computers[v].securityLevel)
+			return false;
+		total += t + net->computers[v].poodleTime;
+	}
+	return total == path.time;
+}
+
+static int checkRandom(int seed)
+{
+	uint64_t state = seed;
+	int n = randRange(&state, 1, 200);
+	struct network net = randomNetwork(n, randRange(&state, 0, 6), seed);
+	int maxTime = randRange(&state, 1, 6); // 时间范围小时平局多
+	for (int v = 0; v < n; v++)
+	{
+		net.computers[v].poodleTime = randRange(&state, 1, maxTime);
+		net.computers[v].securityLevel = randRange(&state, 1, 10);
+	}
+	for (int i = 0; i < net.numConnections; i++)
+		net.connections[i].transmissionTime = randRange(&state, 1, maxTime);
+
+	Network *handle = openNetwork(net.computers, n, net.connections, net.numConnections);
+	int *time = malloc(n * sizeof(int));
+	int failures = 0;
+
+	for (int query = 0; query < 5; query++)
+	{
+		int source = randRange(&state, 0, n - 1);
+		networkInfectionTimes(handle, source, time);
+		for (int k = 0; k < 5; k++)
+		{
+			int target = randRange(&state, 0, n - 1);
+			InfectionPath path = networkInfectionPath(handle, source, target);
+			bool ok = path.time == time[target] &&
+					  (time[target] == INT_MAX ? path.length == 0 : validPath(&net, path, source, target));
+			if (!ok)
+			{
+				fprintf(stderr, "benchInfectionPath: seed %d, %d -> %d: time %d, expected %d\n", seed, source,
+						target, path.time, time[target]);
+				failures++;
+			}
+			freeInfectionPath(path);
+		}
+	}
+
+	free(time);
+	closeNetwork(handle);
+	freeNetwork(&net);
+	return failures;
+}
+
+static int compareLong(const void *a, const void *b)
+{
+	int64_t x = *(const int64_t *)a;
+	int64_t y = *(const int64_t *)b;
+	return (x > y) - (x < y);
+}
+
+int main(int argc, char *argv[])
+{
+	int numComputers = argc > 1 ? atoi(argv[1]) : 1000000;
+	int numQueries = argc > 2 ? atoi(argv[2]) : 1000;
+	int failures = 0;
+
+	for (int seed = 1; seed <= 2000; seed++)
+		failures += checkRandom(seed);
+	printf("random networks checked: 2000\n");
+
+	struct network net = randomNetwork(numComputers, 4, 2521);
+	Network *handle = openNetwork(net.computers, numComputers, net.connections, net.numConnections);
+	printf("computers=%d connections=%d queries=%d\n", numComputers, net.numConnections, numQueries);
+
+	// 完整搜索作为参照
+	int *time = malloc(numComputers * sizeof(int));
+	networkInfectionTimes(handle, 0, time);
+	int64_t t0 = nowNs();
+	networkInfectionTimes(handle, 0, time);
+	int64_t full = nowNs() - t0;
+	printf("%-24s %12.3f ms\n", "full search", full / 1e6);
+	free(time);
+
+	freeInfectionPath(networkInfectionPath(handle, 0, 1)); // 缓冲区就位
+	int64_t *latency = malloc((numQueries + 1) * sizeof(int64_t));
+	uint64_t state = 42;
+	long long totalLength = 0;
+	int reachable = 0;
+	int64_t total = 0;
+	for (int q = 0; q < numQueries; q++)
+	{
+		int source = randRange(&state, 0, numComputers - 1);
+		int target = randRange(&state, 0, numComputers - 1);
+		t0 = nowNs();
+		InfectionPath path = networkInfectionPath(handle, source, target);
+		latency[q] = nowNs() - t0;
+		total += latency[q];
+		totalLength += path.length;
+		reachable += path.length > 0;
+		freeInfectionPath(path);
+	}
+	qsort(latency, numQueries, sizeof(int64_t), compareLong);
+	if (numQueries > 0)
+	{
+		printf("%-24s %12.3f ms %8.1fx\n", "point-to-point, mean", total / 1e6 / numQueries,
+			   (double)full * numQueries / total);
+		printf("%-24s %12.3f ms\n", "point-to-point, p50", latency[numQueries / 2] / 1e6);
+		printf("%-24s %12.3f ms\n", "point-to-point, p99", latency[(int)(numQueries * 0.99)] / 1e6);
+		printf("%-24s %12d\n", "reachable targets", reachable);
+		printf("%-24s %12.1f\n", "mean path length", reachable > 0 ? (double)totalLength / reachable : 0.0);
+	}
+
+	free(latency);
+	closeNetwork(handle);
+	freeNetwork(&net);
+
+	if (failures > 0)
+		return EXIT_FAILURE;
+	printf("all results match\n");
+	return 0;
+}
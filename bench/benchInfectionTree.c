@@ -0,0 +1,254 @@
+// 验证与基准测试：入侵树(路径、子树大小、批量路径)
+//
+// 用法: ./benchInfectionTree [numComputers] [numTargets]   (默认 10^6 台计算机、10^5个目标)
+//
+// 1. 在随机小网络上，networkPoodleWithTree得到的入侵树必须与同一次的poodle结果一致：
+//    入侵者与接收者链表对应、时间相同，深度与路径沿入侵者回溯得到，子树大小与逐个统计的结果相同，
+//    批量路径与逐个infectionTreePathTo相同；动态poodle更新之后的dynamicInfectionTree同样检查；
+// 2. 在大网络上测量：一次搜索 + 结果，额外构建入侵树的代价，单条路径的延迟，
+//    以及numTargets个目标的批量路径与"由poodle结果重建parent[]再逐个回溯"的对比。
+
+#include <limits.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../Dynamic.h"
+#include "../InfectionTree.h"
+#include "../Network.h"
+#include "benchUtil.h"
+
+// 由poodle结果重建time[]与parent[](调用者在没有入侵树时只能这样做)
+static void resultParents(struct poodleResult res, int numComputers, int time[], int parent[])
+{
+	for (int v = 0; v < numComputers; v++)
+	{
+		time[v] = INT_MAX;
+		parent[v] = -1;
+	}
+	for (int i = 0; i < res.numSteps; i++)
+	{
+		time[res.steps[i].computer] = res.steps[i].time;
+		for (struct computerList *curr = res.steps[i].recipients; curr; curr = curr->next)
+			parent[curr->computer] = res.steps[i].computer;
+	}
+}
+
+// 检查入侵树与time[]/parent[]一致
+static int checkTree(InfectionTree *tree, const int time[], const int parent[], int n, int source)
+{
+	int failures = 0;
+	int *path = malloc((n + 1) * sizeof(int));
+	int *size = calloc(n, sizeof(int));
+	int *targets = malloc(n * sizeof(int));
+	int *offsets = malloc((n + 1) * sizeof(int));
+
+	int infected = 0;
+	for (int v = 0; v < n; v++)
+	{
+		targets[v] = v;
+		if (time[v] == INT_MAX)
+			continue;
+		infected++;
+
+		// 沿parent[]回溯，子树大小为所有以v为祖先(含自身)的计算机数量
+		int depth = 0;
+		for (int u = v; u != -1; u = parent[u])
+		{
+			size[u]++;
+			if (u != v)
+				depth++;
+		}
+		if (infectionTreeTime(tree, v) != time[v] || infectionTreeParent(tree, v) != parent[v] ||
+			infectionTreeDepth(tree, v) != depth)
+			failures++;
+
+		int length = infectionTreePathTo(tree, v, path);
+		if (length != depth + 1 || path[0] != source || path[length - 1] != v)
+			failures++;
+		for (int i = 1; i < length; i++)
+		{
+			if (parent[path[i]] != path[i - 1])
+				failures++;
+		}
+	}
+	if (infectionTreeNumInfected(tree) != infected || infectionTreeSource(tree) != source)
+		failures++;
+
+	int *nodes = infectionTreePaths(tree, targets, n, offsets);
+	for (int v = 0; v < n; v++)
+	{
+		if (infectionTreeSubtreeSize(tree, v) != size[v])
+			failures++;
+		int length = infectionTreePathTo(tree, v, path);
+		if (offsets[v + 1] - offsets[v] != length ||
+			memcmp(nodes + offsets[v], path, length * sizeof(int)) != 0)
+			failures++;
+	}
+
+	free(nodes);
+	free(path);
+	free(size);
+	free(targets);
+	free(offsets);
+	return failures;
+}
+
+static int checkRandom(int seed)
+{
+	uint64_t state = seed;
+	int n = randRange(&state, 1, 200);
+	struct network net = randomNetwork(n, randRange(&state, 0, 6), seed);
+	int maxTime = randRange(&state, 1, 6); // 时间范围小时平局多
+	for (int v = 0; v < n; v++)
+	{
+		net.computers[v].poodleTime = randRange(&state, 1, maxTime);
+		net.computers[v].securityLevel = randRange(&state, 1, 10);
+	}
+	for (int i = 0; i < net.numConnections; i++)
+		net.connections[i].transmissionTime = randRange(&state, 1, maxTime);
+
+	int *time = malloc(n * sizeof(int));
+	int *parent = malloc(n * sizeof(int));
+	int source = randRange(&state, 0, n - 1);
+	int failures = 0;
+
+	Network *handle = openNetwork(net.computers, n, net.connections, net.numConnections);
+	InfectionTree *tree;
+	struct poodleResult res = networkPoodleWithTree(handle, source, &tree);
+	resultParents(res, n, time, parent);
+	failures += checkTree(tree, time, parent, n, source);
+	freeInfectionTree(tree);
+	freePoodleResult(res);
+	closeNetwork(handle);
+
+	// 动态poodle：几次更新之后与它自己的time[]/parent[]对照
+	DynamicPoodle *dp = createDynamicPoodle(net.computers, n, net.connections, net.numConnections, source);
+	for (int k = 0; k < 5; k++)
+	{
+		if (n > 1)
+			dynamicAddConnection(dp, randRange(&state, 0, n - 1), randRange(&state, 0, n - 1),
+								 randRange(&state, 1, maxTime));
+		if (net.numConnections > 0)
+			dynamicRemoveConnection(dp, randRange(&state, 0, net.numConnections - 1));
+		dynamicSetSecurityLevel(dp, randRange(&state, 0, n - 1), randRange(&state, 1, 10));
+	}
+	tree = dynamicInfectionTree(dp);
+	failures += checkTree(tree, dynamicTimes(dp), dynamicParents(dp), n, source);
+	freeInfectionTree(tree);
+	freeDynamicPoodle(dp);
+
+	if (failures > 0)
+		fprintf(stderr, "benchInfectionTree: seed %d has %d mismatches\n", seed, failures);
+	free(time);
+	free(parent);
+	freeNetwork(&net);
+	return failures;
+}
+
+int main(int argc, char *argv[])
+{
+	int numComputers = argc > 1 ? atoi(argv[1]) : 1000000;
+	int numTargets = argc > 2 ? atoi(argv[2]) : 100000;
+	int failures = 0;
+
+	for (int seed = 1; seed <= 1000; seed++)
+		failures += checkRandom(seed);
+	printf("random networks checked: 1000\n");
+
+	struct network net = randomNetwork(numComputers, 4, 2521);
+	for (int v = 0; v < numComputers; v++)
+		net.computers[v].securityLevel = 1; // 全部可达
+	Network *handle = openNetwork(net.computers, numComputers, net.connections, net.numConnections);
+	printf("computers=%d connections=%d targets=%d\n", numComputers, net.numConnections, numTargets);
+
+	// 各取三次中最快的一次
+	freePoodleResult(networkPoodle(handle, 0)); // 优先队列就位
+	int64_t plain = INT64_MAX, both = INT64_MAX;
+	InfectionTree *tree = NULL;
+	for (int round = 0; round < 3; round++)
+	{
+		int64_t t0 = nowNs();
+		freePoodleResult(networkPoodle(handle, 0));
+		int64_t elapsed = nowNs() - t0;
+		plain = elapsed < plain ? elapsed : plain;
+
+		freeInfectionTree(tree);
+		t0 = nowNs();
+		freePoodleResult(networkPoodleWithTree(handle, 0, &tree));
+		elapsed = nowNs() - t0;
+		both = elapsed < both ? elapsed : both;
+	}
+	printf("%-36s %12.3f ms\n", "networkPoodle", plain / 1e6);
+	printf("%-36s %12.3f ms (+%.3f ms)\n", "networkPoodleWithTree", both / 1e6, (both - plain) / 1e6);
+	struct poodleResult res = networkPoodle(handle, 0);
+
+	int *targets = malloc((numTargets + 1) * sizeof(int));
+	uint64_t state = 42;
+	for (int t = 0; t < numTargets; t++)
+		targets[t] = randRange(&state, 0, numComputers - 1);
+
+	// 单条路径
+	int *path = malloc((numComputers + 1) * sizeof(int));
+	long long totalLength = 0;
+	int64_t t0 = nowNs();
+	for (int t = 0; t < numTargets; t++)
+		totalLength += infectionTreePathTo(tree, targets[t], path);
+	int64_t single = nowNs() - t0;
+	if (numTargets > 0)
+		printf("%-36s %12.3f us (mean length %.1f)\n", "infectionTreePathTo", single / 1e3 / numTargets,
+			   (double)totalLength / numTargets);
+
+	// 批量路径
+	int *offsets = malloc((numTargets + 1) * sizeof(int));
+	t0 = nowNs();
+	int *nodes = infectionTreePaths(tree, targets, numTargets, offsets);
+	int64_t batch = nowNs() - t0;
+	printf("%-36s %12.3f ms\n", "infectionTreePaths", batch / 1e6);
+
+	// 对照：由poodle结果重建parent[]，再逐个回溯并反转
+	int *time = malloc(numComputers * sizeof(int));
+	int *parent = malloc(numComputers * sizeof(int));
+	int *rebuilt = malloc((offsets[numTargets] + 1) * sizeof(int));
+	t0 = nowNs();
+	resultParents(res, numComputers, time, parent);
+	int k = 0;
+	for (int t = 0; t < numTargets; t++)
+	{
+		int begin = k;
+		for (int v = targets[t]; v != -1 && time[v] != INT_MAX; v = parent[v])
+			rebuilt[k++] = v;
+		for (int a = begin, b = k - 1; a < b; a++, b--)
+		{
+			int temp = rebuilt[a];
+			rebuilt[a] = rebuilt[b];
+			rebuilt[b] = temp;
+		}
+	}
+	int64_t manual = nowNs() - t0;
+	printf("%-36s %12.3f ms %8.1fx\n", "rebuild parent[] from result + walk", manual / 1e6,
+		   (double)manual / batch);
+	if (k != offsets[numTargets] || memcmp(rebuilt, nodes, k * sizeof(int)) != 0)
+	{
+		fprintf(stderr, "benchInfectionTree: batch paths differ\n");
+		failures++;
+	}
+
+	free(time);
+	free(parent);
+	free(rebuilt);
+	free(nodes);
+	free(offsets);
+	free(path);
+	free(targets);
+	freeInfectionTree(tree);
+	freePoodleResult(res);
+	closeNetwork(handle);
+	freeNetwork(&net);
+
+	if (failures > 0)
+		return EXIT_FAILURE;
+	printf("all results match\n");
+	return 0;
+}
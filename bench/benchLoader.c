@@ -0,0 +1,299 @@
+// 验证与基准测试：网络加载
+//
+// 用法: ./benchLoader [numComputers] [tmpDir]   (默认 10^6 台计算机、平均度数8，/tmp)
+//
+// 1. data/下的每个网络文件，mmap文本解析的结果必须与fscanf逐个读取的结果相同；
+//    一组非法输入必须被拒绝，快照被截断或版本不符时必须被拒绝，文件头中的边权统计必须与建图时相同，
+//    与边不一致时完整校验必须拒绝；
+// 2. 生成一个大网络，写成文本文件与快照，比较从文件到"句柄可以查询"的启动时间：
+//      fscanf + openNetwork(与testPoodle.c相同的读取方式)
+//      mmap文本解析 + openNetwork
+//      openNetworkSnapshot(不校验 / 完整校验)
+//    并比较每种方式下第一次poodle查询的结果与耗时(快照的页面在第一次查询时才真正读入)；
+//    另外单独计时不校验的mapSnapshot本身，它只读文件头，耗时不应随网络规模增长。
+
+#include <limits.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../Graph.h"
+#include "../Loader.h"
+#include "../Network.h"
+#include "benchUtil.h"
+#include "netgen.h"
+
+static bool writeText(const char *path, const char *text)
+{
+	FILE *fp = fopen(path, "w");
+	if (!fp)
+		return false;
+	fputs(text, fp);
+	return fclose(fp) == 0;
+}
+
+static int checkDataFiles(void)
+{
+	static const char *names[] = {"1a", "2a", "2b", "2c", "2d", "2e", "3a", "3b", "3c", "3d",
+								  "3e", "3f", "3g", "4a", "4b", "4c", "4d"};
+	int failures = 0;
+	for (int i = 0; i < (int)(sizeof(names) / sizeof(names[0])); i++)
+	{
+		char path[256];
+		snprintf(path, sizeof(path), "../data/network-%s.txt", names[i]);
+		struct network expected = readNetwork(path);
+		NetworkData actual;
+		LoadStatus status = loadNetworkText(path, &actual);
+		if (expected.numComputers == 0 || status != LOAD_OK ||
+			expected.numComputers != actual.numComputers ||
+			expected.numConnections != actual.numConnections ||
+			memcmp(expected.computers, actual.computers, expected.numComputers * sizeof(struct computer)) != 0 ||
+			memcmp(expected.connections, actual.connections,
+				   expected.numConnections * sizeof(struct connection)) != 0)
+		{
+			fprintf(stderr, "benchLoader: %s parsed differently\n", path);
+			failures++;
+		}
+		freeNetwork(&expected);
+		if (status == LOAD_OK)
+			freeNetworkData(&actual);
+	}
+	return failures;
+}
+
+static int checkInvalid(const char *tmpDir)
+{
+	static const struct
+	{
+		const char *text;
+		LoadStatus expected;
+	} cases[] = {
+		{"2 1\n1 1\n1 1\n0 1 5\n", LOAD_OK},
+		{"  +2   1 1 1 1 1\n0\n1\n5", LOAD_OK}, // 任意空白与正号
+		{"", LOAD_FORMAT_ERROR},
+		{"0 0\n", LOAD_INVALID_VALUE},
+		{"2 -1\n1 1\n1 1\n", LOAD_INVALID_VALUE},
+		{"2 1\n0 1\n1 1\n0 1 5\n", LOAD_INVALID_VALUE},  // 等级为0
+		{"2 1\n11 1\n1 1\n0 1 5\n", LOAD_INVALID_VALUE}, // 等级超过MAX_SECURITY_LEVEL
+		{"2 1\n1 0\n1 1\n0 1 5\n", LOAD_INVALID_VALUE},  // poodleTime非正
+		{"2 1\n1 1\n1 1\n0 0 5\n", LOAD_INVALID_VALUE},  // 自环
+		{"2 1\n1 1\n1 1\n0 2 5\n", LOAD_INVALID_VALUE},  // 计算机编号越界
+		{"2 1\n1 1\n1 1\n0 1 0\n", LOAD_INVALID_VALUE},  // 传输时间非正
+		{"2 1\n1 1\n1 1\n0 1\n", LOAD_FORMAT_ERROR},     // 截断
+		{"2 1\n1 1\n1 x\n0 1 5\n", LOAD_FORMAT_ERROR},
+		{"2 1\n1 1\n1 99999999999\n0 1 5\n", LOAD_FORMAT_ERROR}, // 溢出int
+	};
+
+	char path[512];
+	snprintf(path, sizeof(path), "%s/benchLoader-invalid.txt", tmpDir);
+	int failures = 0;
+	for (int i = 0; i < (int)(sizeof(cases) / sizeof(cases[0])); i++)
+	{
+		writeText(path, cases[i].text);
+		NetworkData data;
+		LoadStatus status = loadNetworkText(path, &data);
+		if (status != cases[i].expected)
+		{
+			fprintf(stderr, "benchLoader: case %d: got '%s', expected '%s'\n", i,
+					loadStatusMessage(status), loadStatusMessage(cases[i].expected));
+			failures++;
+		}
+		if (status == LOAD_OK)
+			freeNetworkData(&data);
+	}
+
+	// 快照：正常、截断、版本号错误
+	NetworkData data;
+	writeText(path, "3 2\n1 1\n2 2\n3 3\n0 1 5\n1 2 7\n");
+	loadNetworkText(path, &data);
+	Graph *graph = buildGraph(data.computers, data.numComputers, data.connections, data.numConnections);
+	snprintf(path, sizeof(path), "%s/benchLoader-invalid.snap", tmpDir);
+	writeSnapshot(path, graph);
+	freeNetworkData(&data);
+
+	Snapshot *snapshot;
+	for (int verify = 0; verify <= 1; verify++)
+	{
+		if (mapSnapshot(path, verify, &snapshot) != LOAD_OK)
+		{
+			failures++;
+			continue;
+		}
+		Graph *mapped = snapshotGraph(snapshot);
+		failures += mapped->minWeight != graph->minWeight || mapped->maxWeight != graph->maxWeight ||
+					mapped->weightGcd != graph->weightGcd;
+		unmapSnapshot(snapshot);
+	}
+
+	// 边权统计与边不一致：不校验时照常映射(只检查文件头)，完整校验时拒绝
+	FILE *fp = fopen(path, "r+b");
+	int32_t maxWeight = graph->maxWeight + 1;
+	fseek(fp, offsetof(SnapshotHeader, maxWeight), SEEK_SET);
+	fwrite(&maxWeight, sizeof(maxWeight), 1, fp);
+	fclose(fp);
+	if (mapSnapshot(path, false, &snapshot) != LOAD_OK)
+		failures++;
+	else
+		unmapSnapshot(snapshot);
+	if (mapSnapshot(path, true, &snapshot) != LOAD_BAD_SNAPSHOT)
+		failures++;
+
+	// 不能安全使用的统计(weightGcd为0)在不校验时也被拒绝
+	fp = fopen(path, "r+b");
+	int32_t weightGcd = 0;
+	fseek(fp, offsetof(SnapshotHeader, weightGcd), SEEK_SET);
+	fwrite(&weightGcd, sizeof(weightGcd), 1, fp);
+	fclose(fp);
+	if (mapSnapshot(path, false, &snapshot) != LOAD_BAD_SNAPSHOT)
+		failures++;
+	freeGraph(graph);
+
+	fp = fopen(path, "r+b");
+	fseek(fp, 8, SEEK_SET);
+	uint32_t version = SNAPSHOT_VERSION + 1;
+	fwrite(&version, sizeof(version), 1, fp);
+	fclose(fp);
+	if (mapSnapshot(path, false, &snapshot) != LOAD_BAD_SNAPSHOT)
+		failures++;
+
+	writeText(path, "POODLECS");
+	if (mapSnapshot(path, false, &snapshot) != LOAD_BAD_SNAPSHOT)
+		failures++;
+
+	remove(path);
+	snprintf(path, sizeof(path), "%s/benchLoader-invalid.txt", tmpDir);
+	remove(path);
+	return failures;
+}
+
+// 启动一个句柄并完成第一次查询，返回第一次查询得到的时间的校验和
+static uint64_t firstQuery(Network *handle, int numComputers, int64_t *queryNs)
+{
+	int *time = malloc(numComputers * sizeof(int));
+	int64_t t0 = nowNs();
+	networkInfectionTimes(handle, 0, time);
+	*queryNs = nowNs() - t0;
+
+	uint64_t sum = 0;
+	for (int i = 0; i < numComputers; i++)
+		sum = sum * 31 + (uint64_t)(time[i] == INT_MAX ? -1 : time[i]);
+	free(time);
+	return sum;
+}
+
+int main(int argc, char *argv[])
+{
+	int numComputers = argc > 1 ? atoi(argv[1]) : 1000000;
+	const char *tmpDir = argc > 2 ? argv[2] : "/tmp";
+
+	int failures = checkDataFiles();
+	failures += checkInvalid(tmpDir);
+	printf("validation checks done\n");
+
+	char textPath[512], snapPath[512];
+	snprintf(textPath, sizeof(textPath), "%s/benchLoader-%d.txt", tmpDir, numComputers);
+	snprintf(snapPath, sizeof(snapPath), "%s/benchLoader-%d.snap", tmpDir, numComputers);
+
+	GenParams params = defaultGenParams(numComputers);
+	params.avgDegree = 8;
+	struct network generated = generateNetwork(&params);
+	writeNetwork(textPath, &generated);
+	Graph *graph = buildGraph(generated.computers, generated.numComputers, generated.connections,
+							  generated.numConnections);
+	writeSnapshot(snapPath, graph);
+	freeGraph(graph);
+	printf("computers=%d connections=%d\n", generated.numComputers, generated.numConnections);
+	freeNetwork(&generated);
+
+	printf("%-26s %12s %14s %14s\n", "method", "load ms", "open ms", "1st query ms");
+	uint64_t expectedSum = 0;
+
+	// fscanf + openNetwork
+	{
+		int64_t t0 = nowNs();
+		struct network net = readNetwork(textPath);
+		int64_t t1 = nowNs();
+		Network *handle = openNetwork(net.computers, net.numComputers, net.connections, net.numConnections);
+		int64_t t2 = nowNs();
+		int64_t queryNs;
+		expectedSum = firstQuery(handle, net.numComputers, &queryNs);
+		printf("%-26s %12.3f %14.3f %14.3f\n", "fscanf + openNetwork", (t1 - t0) / 1e6, (t2 - t1) / 1e6,
+			   queryNs / 1e6);
+		closeNetwork(handle);
+		freeNetwork(&net);
+	}
+
+	// mmap文本解析 + openNetwork
+	{
+		int64_t t0 = nowNs();
+		NetworkData data;
+		LoadStatus status = loadNetworkText(textPath, &data);
+		int64_t t1 = nowNs();
+		if (status != LOAD_OK)
+		{
+			fprintf(stderr, "benchLoader: %s\n", loadStatusMessage(status));
+			return EXIT_FAILURE;
+		}
+		Network *handle = openNetwork(data.computers, data.numComputers, data.connections, data.numConnections);
+		int64_t t2 = nowNs();
+		int64_t queryNs;
+		if (firstQuery(handle, data.numComputers, &queryNs) != expectedSum)
+			failures++;
+		printf("%-26s %12.3f %14.3f %14.3f\n", "mmap text + openNetwork", (t1 - t0) / 1e6, (t2 - t1) / 1e6,
+			   queryNs / 1e6);
+		closeNetwork(handle);
+		freeNetworkData(&data);
+	}
+
+	// 不校验的mapSnapshot本身(不建句柄、不查询)，取5次中最快的一次
+	{
+		int64_t best = INT64_MAX;
+		for (int round = 0; round < 5; round++)
+		{
+			Snapshot *snapshot;
+			int64_t t0 = nowNs();
+			LoadStatus status = mapSnapshot(snapPath, false, &snapshot);
+			int64_t elapsed = nowNs() - t0;
+			if (status != LOAD_OK)
+			{
+				fprintf(stderr, "benchLoader: %s\n", loadStatusMessage(status));
+				return EXIT_FAILURE;
+			}
+			unmapSnapshot(snapshot);
+			best = elapsed < best ? elapsed : best;
+		}
+		printf("%-26s %12s %14.3f %14s\n", "mapSnapshot only", "-", best / 1e6, "-");
+	}
+
+	// 快照
+	for (int verify = 0; verify <= 1; verify++)
+	{
+		int64_t t0 = nowNs();
+		Network *handle = openNetworkSnapshot(snapPath, verify);
+		int64_t t1 = nowNs();
+		if (!handle)
+		{
+			fprintf(stderr, "benchLoader: cannot open snapshot\n");
+			return EXIT_FAILURE;
+		}
+		int64_t queryNs;
+		if (firstQuery(handle, numComputers, &queryNs) != expectedSum)
+			failures++;
+		printf("%-26s %12s %14.3f %14.3f\n", verify ? "snapshot (verified)" : "snapshot", "-",
+			   (t1 - t0) / 1e6, queryNs / 1e6);
+		closeNetwork(handle);
+	}
+
+	remove(textPath);
+	remove(snapPath);
+
+	if (failures > 0)
+	{
+		fprintf(stderr, "benchLoader: %d failures\n", failures);
+		return EXIT_FAILURE;
+	}
+	printf("all results match\n");
+	return 0;
+}
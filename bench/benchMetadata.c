@@ -0,0 +1,251 @@
+// 验证与基准测试：按属性分开存放的计算机属性(poodleTime数组 + 每台4位的安全等级)
+//
+// 用法: ./benchMetadata [numComputers] [tmpDir]   (默认 10^6 台计算机，/tmp)
+//
+// 1. 在随机小网络上，buildGraph、buildGraphOrdered(按新编号)、攻击图与快照中每台计算机的
+//    poodleTime与GRAPH_LEVEL必须与调用者的computers[]相同(计算机数量为奇数与偶数的情况都有)；
+// 2. 在大网络上报告每百万台计算机的属性占用，并比较热循环分别读取struct computer数组与
+//    新数组时的耗时：按安全等级过滤全部边(Task 2/3建攻击图，逐边解码4位等级与buildAttackGraph的
+//    先解包再过滤两种写法)、沿攻击图的Dijkstra(Task 3)。
+
+#include <limits.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../Graph.h"
+#include "../Loader.h"
+#include "../PQueue.h"
+#include "benchUtil.h"
+#include "netgen.h"
+
+// graph中每台计算机的属性与computers[GRAPH_LABEL(graph, v)]相同，返回不一致的数量
+static int compareAttributes(const Graph *graph, const struct computer computers[])
+{
+	int failures = 0;
+	for (int v = 0; v < graph->numComputers; v++)
+	{
+		const struct computer *computer = &computers[GRAPH_LABEL(graph, v)];
+		failures += graph->poodleTime[v] != computer->poodleTime ||
+					(int)GRAPH_LEVEL(graph, v) != computer->securityLevel;
+	}
+	return failures;
+}
+
+static int checkRandom(int seed, const char *snapPath)
+{
+	uint64_t state = seed;
+	int n = randRange(&state, 1, 300);
+	struct network net = randomNetwork(n, randRange(&state, 0, 6), seed);
+	for (int v = 0; v < n; v++)
+	{
+		net.computers[v].securityLevel = randRange(&state, 1, MAX_SECURITY_LEVEL);
+		net.computers[v].poodleTime = randRange(&state, 1, 1000);
+	}
+
+	int failures = 0;
+	Graph *graph = buildGraph(net.computers, n, net.connections, net.numConnections);
+	Graph *attack = buildAttackGraph(graph);
+	failures += compareAttributes(graph, net.computers) + compareAttributes(attack, net.computers);
+
+	Graph *ordered = buildGraphOrdered(net.computers, n, net.connections, net.numConnections, ORDER_RCM);
+	failures += compareAttributes(ordered, net.computers);
+
+	Snapshot *snapshot = NULL;
+	if (writeSnapshot(snapPath, graph) != LOAD_OK || mapSnapshot(snapPath, true, &snapshot) != LOAD_OK)
+		failures++;
+	else
+		failures += compareAttributes(snapshotGraph(snapshot), net.computers);
+
+	if (failures > 0)
+		fprintf(stderr, "benchMetadata: seed %d has %d mismatches\n", seed, failures);
+	if (snapshot)
+		unmapSnapshot(snapshot);
+	freeGraph(ordered);
+	freeGraph(attack);
+	freeGraph(graph);
+	freeNetwork(&net);
+	return failures;
+}
+
+// 按安全等级过滤全部边，返回保留下来的边数：读取struct computer数组
+static int filterStruct(const Graph *graph, const struct computer computers[])
+{
+	int kept = 0;
+	for (int u = 0; u < graph->numComputers; u++)
+	{
+		int level = computers[u].securityLevel + 1;
+		for (int e = graph->offsets[u]; e < graph->offsets[u + 1]; e++)
+			kept += level >= computers[graph->dest[e]].securityLevel;
+	}
+	return kept;
+}
+
+// 同上：读取每台4位的安全等级
+static int filterPacked(const Graph *graph)
+{
+	int kept = 0;
+	for (int u = 0; u < graph->numComputers; u++)
+	{
+		int level = GRAPH_LEVEL(graph, u) + 1;
+		for (int e = graph->offsets[u]; e < graph->offsets[u + 1]; e++)
+			kept += level >= (int)GRAPH_LEVEL(graph, graph->dest[e]);
+	}
+	return kept;
+}
+
+// 同上：与buildAttackGraph相同，先把等级解包成每台一个字节再过滤(含解包的耗时)
+static int filterUnpacked(const Graph *graph)
+{
+	int n = graph->numComputers;
+	uint8_t *levels = malloc(n + 1);
+	for (size_t i = 0; i < GRAPH_LEVELS_SIZE(n); i++)
+	{
+		levels[2 * i] = graph->securityLevels[i] & 0xF;
+		levels[2 * i + 1] = graph->securityLevels[i] >> 4;
+	}
+	int kept = 0;
+	for (int u = 0; u < n; u++)
+	{
+		int level = levels[u] + 1;
+		for (int e = graph->offsets[u]; e < graph->offsets[u + 1]; e++)
+			kept += level >= levels[graph->dest[e]];
+	}
+	free(levels);
+	return kept;
+}
+
+// 沿攻击图的Dijkstra；computers不为NULL时从struct computer数组读取poodleTime，否则读取attack->poodleTime
+static int dijkstra(const Graph *attack, const struct computer computers[], PQueue *pq, int time[])
+{
+	for (int v = 0; v < attack->numComputers; v++)
+		time[v] = INT_MAX;
+	pqClear(pq);
+	int reached = 0;
+	time[0] = computers ? computers[0].poodleTime : attack->poodleTime[0];
+	pqPush(pq, 0, PQ_KEY(time[0], 0));
+	while (!pqIsEmpty(pq))
+	{
+		int u = pqPopMin(pq, NULL);
+		reached++;
+		if (computers)
+		{
+			for (int e = attack->offsets[u]; e < attack->offsets[u + 1]; e++)
+			{
+				int v = attack->dest[e];
+				int newTime = time[u] + attack->transmissionTime[e] + computers[v].poodleTime;
+				if (newTime < time[v])
+				{
+					time[v] = newTime;
+					pqPush(pq, v, PQ_KEY(newTime, v));
+				}
+			}
+		}
+		else
+		{
+			const int *poodleTime = attack->poodleTime;
+			for (int e = attack->offsets[u]; e < attack->offsets[u + 1]; e++)
+			{
+				int v = attack->dest[e];
+				int newTime = time[u] + attack->transmissionTime[e] + poodleTime[v];
+				if (newTime < time[v])
+				{
+					time[v] = newTime;
+					pqPush(pq, v, PQ_KEY(newTime, v));
+				}
+			}
+		}
+	}
+	return reached;
+}
+
+static int runLarge(Topology topology, int numComputers)
+{
+	GenParams params = defaultGenParams(numComputers);
+	params.topology = topology;
+	params.avgDegree = 8;
+	params.levels = LEVELS_LOW;
+	struct network net = generateNetwork(&params);
+	int n = net.numComputers;
+	Graph *graph = buildGraph(net.computers, n, net.connections, net.numConnections);
+	Graph *attack = buildAttackGraph(graph);
+	printf("%s computers=%d connections=%d\n", topologyName(topology), n, net.numConnections);
+
+	// 各取三次中最快的一次
+	int64_t best[5] = {INT64_MAX, INT64_MAX, INT64_MAX, INT64_MAX, INT64_MAX};
+	int kept[3] = {0, 0, 0};
+	int reached[2] = {0, 0};
+	PQueue *pq = createPQueue(PQ_RADIX_HEAP, n);
+	int *expected = malloc(n * sizeof(int));
+	int *time = malloc(n * sizeof(int));
+	for (int round = 0; round < 3; round++)
+	{
+		// 三种过滤都先不计时地跑一遍，在缓存状态相同时比较
+		int64_t elapsed[5];
+		for (int k = 0; k < 3; k++)
+		{
+			for (int pass = 0; pass < 2; pass++)
+			{
+				int64_t t0 = nowNs();
+				kept[k] = k == 0 ? filterStruct(graph, net.computers) : k == 1 ? filterPacked(graph)
+																			: filterUnpacked(graph);
+				elapsed[k] = nowNs() - t0;
+			}
+		}
+		int64_t t0 = nowNs();
+		reached[0] = dijkstra(attack, net.computers, pq, expected);
+		int64_t t1 = nowNs();
+		reached[1] = dijkstra(attack, NULL, pq, time);
+		elapsed[3] = t1 - t0;
+		elapsed[4] = nowNs() - t1;
+
+		for (int k = 0; k < 5; k++)
+			best[k] = elapsed[k] < best[k] ? elapsed[k] : best[k];
+	}
+
+	printf("  %-36s %10s %10s %8s\n", "loop", "struct ms", "arrays ms", "speedup");
+	printf("  %-36s %10.3f %10.3f %7.2fx (kept %d)\n", "permission filter, per-edge decode", best[0] / 1e6,
+		   best[1] / 1e6, (double)best[0] / best[1], kept[1]);
+	printf("  %-36s %10.3f %10.3f %7.2fx (kept %d)\n", "permission filter, unpacked levels", best[0] / 1e6,
+		   best[2] / 1e6, (double)best[0] / best[2], kept[2]);
+	printf("  %-36s %10.3f %10.3f %7.2fx (reached %d)\n", "dijkstra on the attack graph", best[3] / 1e6,
+		   best[4] / 1e6, (double)best[3] / best[4], reached[1]);
+
+	int failures = kept[0] != kept[1] || kept[0] != kept[2] || reached[0] != reached[1] || memcmp(expected, time, n * sizeof(int)) != 0;
+	if (failures > 0)
+		fprintf(stderr, "benchMetadata: %s results differ\n", topologyName(topology));
+	free(expected);
+	free(time);
+	freePQueue(pq);
+	freeGraph(attack);
+	freeGraph(graph);
+	freeNetwork(&net);
+	return failures;
+}
+
+int main(int argc, char *argv[])
+{
+	int numComputers = argc > 1 ? atoi(argv[1]) : 1000000;
+	const char *tmpDir = argc > 2 ? argv[2] : "/tmp";
+	char snapPath[4096];
+	snprintf(snapPath, sizeof(snapPath), "%s/benchMetadata.snap", tmpDir);
+	int failures = 0;
+
+	for (int seed = 1; seed <= 1000; seed++)
+		failures += checkRandom(seed, snapPath);
+	remove(snapPath);
+	printf("random networks checked: 1000\n");
+
+	printf("attributes per 10^6 computers: struct computer[] %.1f MB, poodleTime[] %.1f MB + securityLevels[] %.1f MB\n",
+		   1e6 * sizeof(struct computer) / 1e6, 1e6 * sizeof(int) / 1e6, GRAPH_LEVELS_SIZE(1000000) / 1e6);
+
+	failures += runLarge(TOPO_ERDOS_RENYI, numComputers);
+	failures += runLarge(TOPO_POWER_LAW, numComputers);
+	failures += runLarge(TOPO_GRID, numComputers);
+
+	if (failures > 0)
+		return EXIT_FAILURE;
+	printf("all results match\n");
+	return 0;
+}
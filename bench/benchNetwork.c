@@ -0,0 +1,72 @@
+// 基准测试：poodle.h包装函数(每次查询都重新建图) vs 复用同一个Network句柄
+//
+// 用法: ./benchNetwork [numComputers] [numQueries]
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../Graph.h"
+#include "../Network.h"
+#include "benchUtil.h"
+
+#define PATH_LENGTH 16
+
+int main(int argc, char *argv[])
+{
+	int numComputers = argc > 1 ? atoi(argv[1]) : 100000;
+	int numQueries = argc > 2 ? atoi(argv[2]) : 200;
+
+	struct network net = randomNetwork(numComputers, 8, 2521);
+	uint64_t state = 42;
+
+	// 沿随机游走生成探测路径，保证每一跳都有连接
+	int *paths = malloc(numQueries * PATH_LENGTH * sizeof(int));
+	Graph *graph = buildGraph(net.computers, net.numComputers, net.connections, net.numConnections);
+	for (int q = 0; q < numQueries; q++)
+	{
+		int *path = &paths[q * PATH_LENGTH];
+		path[0] = randRange(&state, 0, numComputers - 1);
+		for (int i = 1; i < PATH_LENGTH; i++)
+		{
+			int u = path[i - 1];
+			int e = randRange(&state, graph->offsets[u], graph->offsets[u + 1] - 1);
+			path[i] = graph->dest[e];
+		}
+	}
+	freeGraph(graph);
+
+	Network *handle = openNetwork(net.computers, net.numComputers, net.connections, net.numConnections);
+
+	long long sumWrapper = 0, sumHandle = 0;
+
+	int64_t t0 = nowNs();
+	for (int q = 0; q < numQueries; q++)
+	{
+		struct probePathResult res = probePath(net.computers, net.numComputers,
+											   net.connections, net.numConnections,
+											   &paths[q * PATH_LENGTH], PATH_LENGTH);
+		sumWrapper += res.elapsedTime + res.status;
+	}
+	int64_t t1 = nowNs();
+	for (int q = 0; q < numQueries; q++)
+	{
+		struct probePathResult res = networkProbePath(handle, &paths[q * PATH_LENGTH], PATH_LENGTH);
+		sumHandle += res.elapsedTime + res.status;
+	}
+	int64_t t2 = nowNs();
+
+	if (sumWrapper != sumHandle)
+	{
+		fprintf(stderr, "benchNetwork: wrapper and handle results differ\n");
+		return EXIT_FAILURE;
+	}
+
+	printf("computers=%d connections=%d queries=%d\n", numComputers, net.numConnections, numQueries);
+	printf("probePath wrapper : %10.3f ms total, %10.3f us/query\n", (t1 - t0) / 1e6, (t1 - t0) / 1e3 / numQueries);
+	printf("networkProbePath  : %10.3f ms total, %10.3f us/query\n", (t2 - t1) / 1e6, (t2 - t1) / 1e3 / numQueries);
+
+	closeNetwork(handle);
+	free(paths);
+	freeNetwork(&net);
+	return 0;
+}
@@ -0,0 +1,175 @@
+// 基准测试：poodle的各个优先队列引擎 vs 原来的O(V^2)线性扫描
+//
+// 用法: ./benchPQueue [numComputers ...]
+// 默认规模为10^4、10^5、10^6；10^7需要显式给出(约需2GB内存)。
+// 线性扫描只在规模不超过LINEAR_SCAN_LIMIT时运行。
+
+#include <limits.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../Graph.h"
+#include "../Network.h"
+#include "benchUtil.h"
+
+#define LINEAR_SCAN_LIMIT 20000
+#define NUM_SOURCES 3
+
+// 原poodle()中的线性扫描Dijkstra，仅作为对照
+static void linearScanTimes(Graph *graph, int start, int time[])
+{
+	int n = graph->numComputers;
+	const int *poodleTime = graph->poodleTime;
+	bool *done = calloc(n, sizeof(bool));
+
+	for (int i = 0; i < n; i++)
+		time[i] = INT_MAX;
+	time[start] = poodleTime[start];
+
+	for (int i = 0; i < n; i++)
+	{
+		int u = -1;
+		int minTime = INT_MAX;
+		for (int v = 0; v < n; v++)
+		{
+			if (!done[v] && time[v] < minTime)
+			{
+				minTime = time[v];
+				u = v;
+			}
+		}
+		if (u == -1)
+			break;
+		done[u] = true;
+
+		for (int e = graph->offsets[u]; e < graph->offsets[u + 1]; e++)
+		{
+			int v = graph->dest[e];
+			int newTime = time[u] + graph->transmissionTime[e] + poodleTime[v];
+			if (!done[v] && GRAPH_LEVEL(graph, u) + 1 >= GRAPH_LEVEL(graph, v) &&
+				newTime < time[v])
+			{
+				time[v] = newTime;
+			}
+		}
+	}
+	free(done);
+}
+
+static bool sameTimes(const int a[], const int b[], int n)
+{
+	for (int i = 0; i < n; i++)
+	{
+		if (a[i] != b[i])
+			return false;
+	}
+	return true;
+}
+
+static void runOne(int numComputers)
+{
+	static const struct
+	{
+		const char *name;
+		PoodleEngine engine;
+	} engines[] = {
+		{"binary", ENGINE_BINARY_HEAP},
+		{"quad", ENGINE_QUAD_HEAP},
+		{"radix", ENGINE_RADIX_HEAP},
+	};
+	int numEngines = sizeof(engines) / sizeof(engines[0]);
+
+	struct network net = randomNetwork(numComputers, 4, 2521);
+	Network *handle = openNetwork(net.computers, net.numComputers, net.connections, net.numConnections);
+	int *expected = malloc(numComputers * sizeof(int));
+	int *time = malloc(numComputers * sizeof(int));
+	uint64_t state = 7;
+
+	int sources[NUM_SOURCES];
+	for (int s = 0; s < NUM_SOURCES; s++)
+		sources[s] = randRange(&state, 0, numComputers - 1);
+
+	printf("%10d %10d", numComputers, net.numConnections);
+
+	// 线性扫描
+	if (numComputers <= LINEAR_SCAN_LIMIT)
+	{
+		Graph *graph = buildGraph(net.computers, net.numComputers, net.connections, net.numConnections);
+		int64_t total = 0;
+		for (int s = 0; s < NUM_SOURCES; s++)
+		{
+			int64_t t0 = nowNs();
+			linearScanTimes(graph, sources[s], time);
+			total += nowNs() - t0;
+		}
+		printf(" %10.3f", total / 1e6 / NUM_SOURCES);
+		freeGraph(graph);
+	}
+	else
+	{
+		printf(" %10s", "-");
+	}
+
+	for (int k = 0; k < numEngines; k++)
+	{
+		setPoodleEngine(handle, engines[k].engine);
+		int64_t total = 0;
+		for (int s = 0; s < NUM_SOURCES; s++)
+		{
+			int64_t t0 = nowNs();
+			networkInfectionTimes(handle, sources[s], time);
+			total += nowNs() - t0;
+
+			// 以第一个引擎的结果为基准，检查所有引擎结果一致
+			if (k == 0 && s == NUM_SOURCES - 1)
+			{
+				for (int i = 0; i < numComputers; i++)
+					expected[i] = time[i];
+			}
+		}
+		if (k > 0 && !sameTimes(expected, time, numComputers))
+		{
+			fprintf(stderr, "\nbenchPQueue: engine '%s' disagrees (n=%d)\n", engines[k].name, numComputers);
+			exit(EXIT_FAILURE);
+		}
+		printf(" %10.3f", total / 1e6 / NUM_SOURCES);
+	}
+	printf("\n");
+
+	if (numComputers <= LINEAR_SCAN_LIMIT)
+	{
+		Graph *graph = buildGraph(net.computers, net.numComputers, net.connections, net.numConnections);
+		linearScanTimes(graph, sources[NUM_SOURCES - 1], time);
+		if (!sameTimes(expected, time, numComputers))
+		{
+			fprintf(stderr, "benchPQueue: linear scan disagrees (n=%d)\n", numComputers);
+			exit(EXIT_FAILURE);
+		}
+		freeGraph(graph);
+	}
+
+	closeNetwork(handle);
+	free(expected);
+	free(time);
+	freeNetwork(&net);
+}
+
+int main(int argc, char *argv[])
+{
+	printf("ms per single-source run (avg of %d sources)\n", NUM_SOURCES);
+	printf("%10s %10s %10s %10s %10s %10s\n", "computers", "conns", "linear", "binary", "quad", "radix");
+
+	if (argc > 1)
+	{
+		for (int i = 1; i < argc; i++)
+			runOne(atoi(argv[i]));
+	}
+	else
+	{
+		runOne(10000);
+		runOne(100000);
+		runOne(1000000);
+	}
+	return 0;
+}
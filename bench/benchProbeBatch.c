@@ -0,0 +1,134 @@
+// 验证与基准测试：批量多线程probePath
+//
+// 用法: ./benchProbeBatch [numComputers] [numPaths] [maxThreads]
+//
+// 在随机网络上沿随机游走生成路径(其中一部分插入不存在的连接)，比较：
+//   - poodle.h的probePath包装函数(每次调用都重新建图，只在少量路径上计时后折算)；
+//   - 在同一个句柄上逐条调用networkProbePath；
+//   - networkProbePathBatch，线程数从1翻倍到maxThreads。
+// 所有方式的结果必须完全一致，吞吐量以每秒路径数报告。
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../Graph.h"
+#include "../Network.h"
+#include "benchUtil.h"
+
+#define MIN_PATH_LENGTH 2
+#define MAX_PATH_LENGTH 32
+#define WRAPPER_PATHS 20
+
+static bool sameResults(struct probePathResult a[], struct probePathResult b[], int n)
+{
+	for (int i = 0; i < n; i++)
+	{
+		if (a[i].status != b[i].status || a[i].elapsedTime != b[i].elapsedTime)
+			return false;
+	}
+	return true;
+}
+
+int main(int argc, char *argv[])
+{
+	int numComputers = argc > 1 ? atoi(argv[1]) : 1000000;
+	int numPaths = argc > 2 ? atoi(argv[2]) : 2000000;
+	int maxThreads = argc > 3 ? atoi(argv[3]) : 8;
+
+	struct network net = randomNetwork(numComputers, 8, 2521);
+	uint64_t state = 42;
+
+	// 生成路径：offsets + 扁平节点数组
+	int *pathOffsets = malloc((numPaths + 1) * sizeof(int));
+	int *pathNodes = malloc((int64_t)numPaths * MAX_PATH_LENGTH * sizeof(int));
+	Graph *graph = buildGraph(net.computers, net.numComputers, net.connections, net.numConnections);
+	pathOffsets[0] = 0;
+	for (int p = 0; p < numPaths; p++)
+	{
+		int len = randRange(&state, MIN_PATH_LENGTH, MAX_PATH_LENGTH);
+		int *path = &pathNodes[pathOffsets[p]];
+		path[0] = randRange(&state, 0, numComputers - 1);
+		for (int i = 1; i < len; i++)
+		{
+			int u = path[i - 1];
+			if (randRange(&state, 0, 99) == 0)
+				path[i] = randRange(&state, 0, numComputers - 1);
+			else
+				path[i] = graph->dest[randRange(&state, graph->offsets[u], graph->offsets[u + 1] - 1)];
+		}
+		pathOffsets[p + 1] = pathOffsets[p] + len;
+	}
+	freeGraph(graph);
+
+	struct probePathResult *expected = malloc(numPaths * sizeof(struct probePathResult));
+	struct probePathResult *results = malloc(numPaths * sizeof(struct probePathResult));
+	Network *handle = openNetwork(net.computers, net.numComputers, net.connections, net.numConnections);
+	int failures = 0;
+
+	printf("computers=%d connections=%d paths=%d hops=%d\n", numComputers, net.numConnections,
+		   numPaths, pathOffsets[numPaths] - numPaths);
+	printf("%-28s %12s %14s\n", "method", "ms", "paths/sec");
+
+	// 包装函数：只跑前WRAPPER_PATHS条
+	int wrapperPaths = numPaths < WRAPPER_PATHS ? numPaths : WRAPPER_PATHS;
+	int64_t t0 = nowNs();
+	for (int p = 0; p < wrapperPaths; p++)
+	{
+		struct probePathResult res = probePath(net.computers, net.numComputers, net.connections,
+											   net.numConnections, &pathNodes[pathOffsets[p]],
+											   pathOffsets[p + 1] - pathOffsets[p]);
+		results[p] = res;
+	}
+	int64_t elapsed = nowNs() - t0;
+	printf("%-28s %12.3f %14.0f   (%d paths)\n", "probePath wrapper", elapsed / 1e6,
+		   wrapperPaths / (elapsed / 1e9), wrapperPaths);
+
+	// 逐条调用句柄，先跑一遍使边索引就位，只计时第二遍
+	for (int p = 0; p < numPaths; p++)
+	{
+		expected[p] = networkProbePath(handle, &pathNodes[pathOffsets[p]], pathOffsets[p + 1] - pathOffsets[p]);
+	}
+	t0 = nowNs();
+	for (int p = 0; p < numPaths; p++)
+	{
+		expected[p] = networkProbePath(handle, &pathNodes[pathOffsets[p]], pathOffsets[p + 1] - pathOffsets[p]);
+	}
+	elapsed = nowNs() - t0;
+	printf("%-28s %12.3f %14.0f\n", "networkProbePath loop", elapsed / 1e6, numPaths / (elapsed / 1e9));
+	if (!sameResults(expected, results, wrapperPaths))
+	{
+		fprintf(stderr, "benchProbeBatch: wrapper and handle results differ\n");
+		failures++;
+	}
+
+	for (int threads = 1; threads <= maxThreads; threads *= 2)
+	{
+		// 先跑一次，使线程池与每线程的访问标记就位，只计时第二次
+		networkProbePathBatch(handle, pathOffsets, pathNodes, numPaths, results, threads);
+		t0 = nowNs();
+		bool ok = networkProbePathBatch(handle, pathOffsets, pathNodes, numPaths, results, threads);
+		elapsed = nowNs() - t0;
+
+		char name[64];
+		snprintf(name, sizeof(name), "batch, %d thread%s", threads, threads > 1 ? "s" : "");
+		printf("%-28s %12.3f %14.0f\n", name, elapsed / 1e6, numPaths / (elapsed / 1e9));
+		if (!ok || !sameResults(expected, results, numPaths))
+		{
+			fprintf(stderr, "benchProbeBatch: batch results differ with %d threads\n", threads);
+			failures++;
+		}
+	}
+
+	closeNetwork(handle);
+	free(expected);
+	free(results);
+	free(pathOffsets);
+	free(pathNodes);
+	freeNetwork(&net);
+
+	if (failures > 0)
+		return EXIT_FAILURE;
+	printf("all results match\n");
+	return 0;
+}
@@ -0,0 +1,179 @@
+// 验证与基准测试：probePath用边索引查找连接 vs 原来线性扫描邻接行
+//
+// 用法: ./benchProbeHub [hubDegree] [pathLength]
+//
+// 1. 在带重复连接的随机网络上，比较随机路径(包含不存在的连接与自环)的探测结果；
+// 2. 在星形网络上沿"中心 -> 叶子 -> 中心 -> ..."探测一条长路径，
+//    原实现每一跳都要扫描中心的全部连接。
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../Graph.h"
+#include "../Network.h"
+#include "benchUtil.h"
+
+// 原probePath，连接查找为线性扫描，仅作为对照
+static struct probePathResult legacyProbe(Graph *graph, int path[], int pathLength)
+{
+	struct probePathResult res = {SUCCESS, 0};
+	if (pathLength == 0)
+		return res;
+
+	const int *poodleTime = graph->poodleTime;
+	bool *visited = calloc(graph->numComputers, sizeof(bool));
+	int countTime = poodleTime[path[0]];
+	visited[path[0]] = true;
+
+	for (int i = 1; i < pathLength; i++)
+	{
+		int prev = path[i - 1];
+		int current = path[i];
+		int transmissionTime = -1;
+		if (prev == current)
+		{
+			transmissionTime = 0;
+		}
+		else
+		{
+			for (int e = graph->offsets[prev]; e < graph->offsets[prev + 1]; e++)
+			{
+				if (graph->dest[e] == current)
+				{
+					transmissionTime = graph->transmissionTime[e];
+					break;
+				}
+			}
+		}
+
+		if (transmissionTime == -1)
+		{
+			res.status = NO_CONNECTION;
+			break;
+		}
+		if (GRAPH_LEVEL(graph, prev) + 1 < GRAPH_LEVEL(graph, current))
+		{
+			res.status = NO_PERMISSION;
+			break;
+		}
+		countTime += transmissionTime;
+		if (!visited[current])
+		{
+			countTime += poodleTime[current];
+			visited[current] = true;
+		}
+	}
+
+	res.elapsedTime = countTime;
+	free(visited);
+	return res;
+}
+
+static int checkRandom(int seed)
+{
+	uint64_t state = seed;
+	int n = randRange(&state, 2, 60);
+	struct network net = randomNetwork(n, randRange(&state, 1, 12), seed);
+
+	// 复制一部分连接并改变传输时间，制造重复连接
+	int extra = randRange(&state, 0, net.numConnections);
+	net.connections = realloc(net.connections, (net.numConnections + extra) * sizeof(struct connection));
+	for (int i = 0; i < extra; i++)
+	{
+		struct connection c = net.connections[randRange(&state, 0, net.numConnections - 1)];
+		c.transmissionTime = randRange(&state, 1, 10);
+		net.connections[net.numConnections + i] = c;
+	}
+	net.numConnections += extra;
+
+	Graph *graph = buildGraph(net.computers, n, net.connections, net.numConnections);
+	Network *handle = openNetwork(net.computers, n, net.connections, net.numConnections);
+	int failures = 0;
+	int path[32];
+
+	for (int q = 0; q < 200; q++)
+	{
+		int len = randRange(&state, 0, 32);
+		for (int i = 0; i < len; i++)
+		{
+			int u = i > 0 ? path[i - 1] : randRange(&state, 0, n - 1);
+			int kind = randRange(&state, 0, 9);
+			if (i == 0 || kind == 0)
+				path[i] = randRange(&state, 0, n - 1); // 多半不存在的连接
+			else if (kind == 1)
+				path[i] = u; // 自环
+			else
+				path[i] = graph->offsets[u] == graph->offsets[u + 1]
+							  ? u
+							  : graph->dest[randRange(&state, graph->offsets[u], graph->offsets[u + 1] - 1)];
+		}
+
+		struct probePathResult expected = legacyProbe(graph, path, len);
+		struct probePathResult actual = networkProbePath(handle, path, len);
+		if (expected.status != actual.status || expected.elapsedTime != actual.elapsedTime)
+			failures++;
+	}
+
+	closeNetwork(handle);
+	freeGraph(graph);
+	freeNetwork(&net);
+	return failures;
+}
+
+int main(int argc, char *argv[])
+{
+	int hubDegree = argc > 1 ? atoi(argv[1]) : 50000;
+	int pathLength = argc > 2 ? atoi(argv[2]) : 100000;
+	int failures = 0;
+
+	for (int seed = 1; seed <= 2000; seed++)
+		failures += checkRandom(seed);
+	printf("random networks checked: 2000\n");
+
+	// 星形网络：计算机0连接全部叶子，安全等级相同，路径在中心与随机叶子之间来回
+	struct network net = randomNetwork(hubDegree + 1, 0, 1);
+	for (int i = 0; i <= hubDegree; i++)
+		net.computers[i].securityLevel = 1;
+	for (int i = 0; i < hubDegree; i++)
+		net.connections[i] = (struct connection){0, i + 1, 1 + i % 7};
+
+	uint64_t state = 2521;
+	int *path = malloc(pathLength * sizeof(int));
+	for (int i = 0; i < pathLength; i++)
+		path[i] = i % 2 == 0 ? 0 : randRange(&state, 1, hubDegree);
+
+	Graph *graph = buildGraph(net.computers, net.numComputers, net.connections, net.numConnections);
+	int64_t t0 = nowNs();
+	struct probePathResult expected = legacyProbe(graph, path, pathLength);
+	int64_t t1 = nowNs();
+
+	Network *handle = openNetwork(net.computers, net.numComputers, net.connections, net.numConnections);
+	int64_t t2 = nowNs();
+	struct probePathResult first = networkProbePath(handle, path, pathLength); // 前若干跳线性扫描，累计代价超过建索引的代价后构建边索引
+	int64_t t3 = nowNs();
+	struct probePathResult again = networkProbePath(handle, path, pathLength);
+	int64_t t4 = nowNs();
+
+	if (expected.status != first.status || expected.elapsedTime != first.elapsedTime ||
+		expected.status != again.status || expected.elapsedTime != again.elapsedTime)
+		failures++;
+
+	printf("hub degree=%d path length=%d\n", hubDegree, pathLength);
+	printf("linear scan        : %10.3f ms\n", (t1 - t0) / 1e6);
+	printf("handle (first)     : %10.3f ms\n", (t3 - t2) / 1e6);
+	printf("handle (again)     : %10.3f ms\n", (t4 - t3) / 1e6);
+
+	closeNetwork(handle);
+	freeGraph(graph);
+	free(path);
+	freeNetwork(&net);
+
+	if (failures > 0)
+	{
+		fprintf(stderr, "benchProbeHub: %d mismatches\n", failures);
+		return EXIT_FAILURE;
+	}
+	printf("all results match\n");
+	return 0;
+}
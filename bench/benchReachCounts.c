@@ -0,0 +1,167 @@
+// 验证与基准测试：位并行多源BFS计算所有计算机的入侵数量 vs 从每台计算机分别dfs
+//
+// 用法: ./benchReachCounts [dataDir]   (默认 ../data)
+// 逐源dfs为O(V·(V+E))，只在规模不超过PER_SOURCE_LIMIT时运行。
+
+#include <dirent.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../Graph.h"
+#include "../Network.h"
+#include "../Reach.h"
+#include "benchUtil.h"
+
+#define PER_SOURCE_LIMIT 20000
+
+// 逐源的迭代dfs，对照实现
+static void perSourceCounts(Graph *graph, int reachCount[])
+{
+	int n = graph->numComputers;
+	int *stamp = malloc(n * sizeof(int));
+	int *stack = malloc(n * sizeof(int));
+	for (int i = 0; i < n; i++)
+		stamp[i] = -1;
+
+	for (int src = 0; src < n; src++)
+	{
+		int top = 0;
+		int count = 1;
+		stamp[src] = src;
+		stack[top++] = src;
+		while (top > 0)
+		{
+			int u = stack[--top];
+			for (int e = graph->offsets[u]; e < graph->offsets[u + 1]; e++)
+			{
+				int v = graph->dest[e];
+				if (stamp[v] != src &&
+					GRAPH_LEVEL(graph, u) + 1 >= GRAPH_LEVEL(graph, v))
+				{
+					stamp[v] = src;
+					stack[top++] = v;
+					count++;
+				}
+			}
+		}
+		reachCount[src] = count;
+	}
+
+	free(stamp);
+	free(stack);
+}
+
+static bool checkNetwork(struct network *net)
+{
+	int n = net->numComputers;
+	Graph *graph = buildGraph(net->computers, n, net->connections, net->numConnections);
+	Network *handle = openNetwork(net->computers, n, net->connections, net->numConnections);
+	int *expected = malloc(n * sizeof(int));
+	int *actual = malloc(n * sizeof(int));
+
+	perSourceCounts(graph, expected);
+	bool ok = networkReachCounts(handle, actual) &&
+			  memcmp(expected, actual, n * sizeof(int)) == 0;
+
+	free(expected);
+	free(actual);
+	closeNetwork(handle);
+	freeGraph(graph);
+	return ok;
+}
+
+static void timeOne(int n, int avgDegree)
+{
+	struct network net = randomNetwork(n, avgDegree, 2521);
+	int *reach = malloc(n * sizeof(int));
+	printf("%10d %10d", n, net.numConnections);
+
+	if (n <= PER_SOURCE_LIMIT)
+	{
+		Graph *graph = buildGraph(net.computers, n, net.connections, net.numConnections);
+		int64_t t0 = nowNs();
+		perSourceCounts(graph, reach);
+		printf(" %14.3f", (nowNs() - t0) / 1e6);
+		freeGraph(graph);
+	}
+	else
+	{
+		printf(" %14s", "-");
+	}
+
+	// 第一次调用包括构建凝聚图的开销，第二次只有位并行扫描
+	Network *handle = openNetwork(net.computers, n, net.connections, net.numConnections);
+	int64_t t0 = nowNs();
+	networkReachCounts(handle, reach);
+	int64_t t1 = nowNs();
+	networkReachCounts(handle, reach);
+	int64_t t2 = nowNs();
+	printf(" %14.3f %14.3f\n", (t1 - t0) / 1e6, (t2 - t1) / 1e6);
+
+	closeNetwork(handle);
+	free(reach);
+	freeNetwork(&net);
+}
+
+int main(int argc, char *argv[])
+{
+	const char *dataDir = argc > 1 ? argv[1] : "../data";
+	int failures = 0;
+	int checked = 0;
+
+	DIR *dir = opendir(dataDir);
+	if (dir)
+	{
+		struct dirent *entry;
+		while ((entry = readdir(dir)))
+		{
+			if (strncmp(entry->d_name, "network-", 8) != 0)
+				continue;
+			char path[1024];
+			snprintf(path, sizeof(path), "%s/%s", dataDir, entry->d_name);
+			struct network net = readNetwork(path);
+			if (net.numComputers == 0)
+				continue;
+			if (!checkNetwork(&net))
+			{
+				fprintf(stderr, "benchReachCounts: mismatch on %s\n", entry->d_name);
+				failures++;
+			}
+			checked++;
+			freeNetwork(&net);
+		}
+		closedir(dir);
+	}
+	printf("data files checked: %d\n", checked);
+
+	// 规模跨过若干个REACH_BITS的批次边界
+	for (int seed = 1; seed <= 2000; seed++)
+	{
+		uint64_t state = seed;
+		int n = randRange(&state, 1, 3 * REACH_BITS);
+		struct network net = randomNetwork(n, randRange(&state, 1, 5), seed);
+		if (!checkNetwork(&net))
+		{
+			fprintf(stderr, "benchReachCounts: mismatch on random seed %d\n", seed);
+			failures++;
+		}
+		freeNetwork(&net);
+	}
+	printf("random networks checked: 2000\n");
+
+	printf("%d sources per sweep\n", REACH_BITS);
+	printf("%10s %10s %14s %14s %14s\n", "computers", "conns", "per-source ms", "bitset ms", "cached ms");
+	int sizes[] = {1000, 20000, 100000, 1000000};
+	for (int k = 0; k < (int)(sizeof(sizes) / sizeof(sizes[0])); k++)
+		timeOne(sizes[k], 4);
+
+	if (failures > 0)
+	{
+		fprintf(stderr, "benchReachCounts: %d mismatches\n", failures);
+		return EXIT_FAILURE;
+	}
+	printf("all results match\n");
+	return 0;
+}
@@ -0,0 +1,209 @@
+// 基准测试：poodle结果(接收者链表)的构建
+//
+// 用法: ./benchRecipients
+//
+// 比较在同一棵入侵树上构建poodleResult的两种方式("csr build"为networkPoodle减去只算时间的搜索)：
+//   - 原实现：每个出队的计算机重新扫描自己的邻接行找出parent为自己的邻居，
+//     用冒泡排序排好，再为每个接收者malloc一个节点；
+//   - networkPoodle：对parent[]计数排序得到子节点CSR，所有节点在一次分配中。
+// 入侵树由networkPoodle的结果得到；原实现的构建结果必须与之相同。
+// 星形网络上中心有大量子节点，冒泡排序为O(d^2)。
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../Graph.h"
+#include "../Network.h"
+#include "benchUtil.h"
+
+static void bubbleSort(int arr[], int n)
+{
+	for (int i = 0; i < n - 1; i++)
+	{
+		bool swapped = false;
+		for (int j = 0; j < n - i - 1; j++)
+		{
+			if (arr[j] > arr[j + 1])
+			{
+				int temp = arr[j];
+				arr[j] = arr[j + 1];
+				arr[j + 1] = temp;
+				swapped = true;
+			}
+		}
+		if (!swapped)
+			break;
+	}
+}
+
+// 原networkPoodle中构建结果的部分，仅作为对照
+static struct poodleResult legacyBuild(Graph *graph, int order[], int stepcount, int time[], int parent[])
+{
+	struct poodleResult res = {stepcount, calloc(stepcount, sizeof(struct step))};
+	int maxDegree = 0;
+	for (int u = 0; u < graph->numComputers; u++)
+	{
+		if (graph->offsets[u + 1] - graph->offsets[u] > maxDegree)
+			maxDegree = graph->offsets[u + 1] - graph->offsets[u];
+	}
+	int *sortArray = malloc((maxDegree + 1) * sizeof(int));
+
+	for (int i = 0; i < stepcount; i++)
+	{
+		int cur = order[i];
+		res.steps[i].computer = cur;
+		res.steps[i].time = time[cur];
+
+		int n = 0;
+		for (int e = graph->offsets[cur]; e < graph->offsets[cur + 1]; e++)
+		{
+			if (parent[graph->dest[e]] == cur)
+				sortArray[n++] = graph->dest[e];
+		}
+		bubbleSort(sortArray, n);
+
+		struct computerList **tail = &res.steps[i].recipients;
+		for (int k = 0; k < n; k++)
+		{
+			struct computerList *node = malloc(sizeof(struct computerList));
+			node->computer = sortArray[k];
+			node->next = NULL;
+			*tail = node;
+			tail = &node->next;
+		}
+	}
+
+	free(sortArray);
+	return res;
+}
+
+static void freeLegacy(struct poodleResult res)
+{
+	for (int i = 0; i < res.numSteps; i++)
+	{
+		struct computerList *curr = res.steps[i].recipients;
+		while (curr)
+		{
+			struct computerList *temp = curr;
+			curr = curr->next;
+			free(temp);
+		}
+	}
+	free(res.steps);
+}
+
+static bool sameResult(struct poodleResult a, struct poodleResult b)
+{
+	if (a.numSteps != b.numSteps)
+		return false;
+	for (int i = 0; i < a.numSteps; i++)
+	{
+		if (a.steps[i].computer != b.steps[i].computer || a.steps[i].time != b.steps[i].time)
+			return false;
+		struct computerList *x = a.steps[i].recipients;
+		struct computerList *y = b.steps[i].recipients;
+		for (; x && y; x = x->next, y = y->next)
+		{
+			if (x->computer != y->computer)
+				return false;
+			// 两台计算机之间有多条连接时，原实现会重复列出同一个接收者
+			while (y->next && y->next->computer == y->computer)
+				y = y->next;
+		}
+		if (x || y)
+			return false;
+	}
+	return true;
+}
+
+static bool runOne(const char *name, struct network *net, int start)
+{
+	int n = net->numComputers;
+	Network *handle = openNetwork(net->computers, n, net->connections, net->numConnections);
+	Graph *graph = buildGraph(net->computers, n, net->connections, net->numConnections);
+
+	int *time = malloc(n * sizeof(int));
+	networkInfectionTimes(handle, start, time); // 预热：创建优先队列
+	int64_t t0 = nowNs();
+	networkInfectionTimes(handle, start, time);
+	int64_t search = nowNs() - t0;
+
+	t0 = nowNs();
+	struct poodleResult res = networkPoodle(handle, start);
+	int64_t full = nowNs() - t0;
+
+	// 从结果中还原入侵顺序与parent[]，作为原实现的输入
+	int *order = malloc(n * sizeof(int));
+	int *parent = malloc(n * sizeof(int));
+	for (int v = 0; v < n; v++)
+		parent[v] = -1;
+	for (int i = 0; i < res.numSteps; i++)
+	{
+		order[i] = res.steps[i].computer;
+		for (struct computerList *c = res.steps[i].recipients; c; c = c->next)
+			parent[c->computer] = res.steps[i].computer;
+	}
+
+	t0 = nowNs();
+	struct poodleResult legacy = legacyBuild(graph, order, res.numSteps, time, parent);
+	int64_t legacyTime = nowNs() - t0;
+
+	t0 = nowNs();
+	freeLegacy(legacy);
+	int64_t legacyFree = nowNs() - t0;
+
+	legacy = legacyBuild(graph, order, res.numSteps, time, parent);
+	bool ok = sameResult(res, legacy);
+	freeLegacy(legacy);
+
+	t0 = nowNs();
+	freePoodleResult(res);
+	int64_t newFree = nowNs() - t0;
+
+	printf("%-8s %10d %10d %12.3f %14.3f %12.3f %14.3f %12.3f\n", name, n, net->numConnections,
+		   search / 1e6, (full - search) / 1e6, newFree / 1e6, legacyTime / 1e6, legacyFree / 1e6);
+
+	free(time);
+	free(order);
+	free(parent);
+	freeGraph(graph);
+	closeNetwork(handle);
+	return ok;
+}
+
+int main(void)
+{
+	int failures = 0;
+	printf("%-8s %10s %10s %12s %14s %12s %14s %12s\n", "network", "computers", "conns",
+		   "search ms", "csr build ms", "free ms", "legacy ms", "legacy free");
+
+	int sizes[] = {10000, 100000, 1000000};
+	for (int k = 0; k < (int)(sizeof(sizes) / sizeof(sizes[0])); k++)
+	{
+		struct network net = randomNetwork(sizes[k], 4, 2521);
+		failures += !runOne("random", &net, 0);
+		freeNetwork(&net);
+	}
+
+	// 星形网络：中心连接全部叶子，叶子按编号逆序出队，冒泡排序达到最坏情况
+	int leaves = 50000;
+	struct network star = randomNetwork(leaves + 1, 0, 1);
+	for (int i = 0; i <= leaves; i++)
+	{
+		star.computers[i].securityLevel = 1;
+		star.computers[i].poodleTime = 1;
+	}
+	for (int i = 0; i < leaves; i++)
+		star.connections[i] = (struct connection){0, i + 1, leaves - i};
+	failures += !runOne("star", &star, 0);
+	freeNetwork(&star);
+
+	if (failures > 0)
+	{
+		fprintf(stderr, "benchRecipients: %d mismatches\n", failures);
+		return EXIT_FAILURE;
+	}
+	printf("all results match\n");
+	return 0;
+}
@@ -0,0 +1,345 @@
+// 验证与基准测试：重排计算机编号(BFS / RCM / 度数)以改善缓存局部性
+//
+// 用法: ./benchReorder [numComputers] [numQueries]   (默认 10^6 台计算机、5次查询)
+//
+// 1. 在随机小网络(含大量平局)上，openNetworkOrdered打开的句柄对每一种重排方式、每一个接口
+//    (probePath、chooseSource、reachCounts、poodle的各个引擎、提前终止的poodle、点到点查询、
+//    全源摘要、advancedPoodle)的结果都必须与openNetwork完全相同；
+// 2. 在大网络(网格、打乱编号的网格、ER、打乱编号的幂律网络)上，报告每种重排的构建时间、
+//    边两端编号之差(同一缓存行内的边所占的比例)，以及poodle的耗时与缓存缺失次数(硬件计数器不可用时只报告耗时)。
+
+#include <limits.h>
+#include <linux/perf_event.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "../Graph.h"
+#include "../Network.h"
+#include "benchUtil.h"
+#include "netgen.h"
+
+static const GraphOrder ORDERS[] = {ORDER_BFS, ORDER_RCM, ORDER_DEGREE};
+static const char *ORDER_NAMES[] = {"none", "bfs", "rcm", "degree"};
+#define NUM_ORDERS 3
+
+static bool sameResult(struct poodleResult a, struct poodleResult b)
+{
+	if (a.numSteps != b.numSteps)
+		return false;
+	for (int i = 0; i < a.numSteps; i++)
+	{
+		if (a.steps[i].computer != b.steps[i].computer || a.steps[i].time != b.steps[i].time)
+			return false;
+		struct computerList *x = a.steps[i].recipients;
+		struct computerList *y = b.steps[i].recipients;
+		for (; x && y; x = x->next, y = y->next)
+		{
+			if (x->computer != y->computer)
+				return false;
+		}
+		if (x || y)
+			return false;
+	}
+	return true;
+}
+
+// 对照句柄与重排句柄上的一个poodle查询，返回不一致的数量
+static int comparePoodle(Network *plain, Network *ordered, int start, PoodleEngine engine)
+{
+	setPoodleEngine(plain, engine);
+	setPoodleEngine(ordered, engine);
+	struct poodleResult a = networkPoodle(plain, start);
+	struct poodleResult b = networkPoodle(ordered, start);
+	int failures = !sameResult(a, b);
+	freePoodleResult(a);
+	freePoodleResult(b);
+	return failures;
+}
+
+static int compareHandles(struct network *net, Network *plain, Network *ordered, uint64_t *state)
+{
+	int n = net->numComputers;
+	int failures = 0;
+
+	// Task 1：随机路径(大多数会在中途因为没有连接或权限不足而停止)
+	int path[8];
+	for (int k = 0; k < 20; k++)
+	{
+		int length = randRange(state, 1, 8);
+		path[0] = randRange(state, 0, n - 1);
+		for (int i = 1; i < length; i++)
+		{
+			// 落在某条连接上时沿着它走，否则随机选一台计算机
+			path[i] = randRange(state, 0, n - 1);
+			if (net->numConnections > 0)
+			{
+				struct connection c = net->connections[randRange(state, 0, net->numConnections - 1)];
+				if (c.computerA == path[i - 1])
+					path[i] = c.computerB;
+				else if (c.computerB == path[i - 1])
+					path[i] = c.computerA;
+			}
+		}
+		struct probePathResult a = networkProbePath(plain, path, length);
+		struct probePathResult b = networkProbePath(ordered, path, length);
+		failures += a.status != b.status || a.elapsedTime != b.elapsedTime;
+	}
+
+	// Task 2
+	struct chooseSourceResult a = networkChooseSource(plain);
+	struct chooseSourceResult b = networkChooseSource(ordered);
+	failures += a.sourceComputer != b.sourceComputer || a.numComputers != b.numComputers ||
+				memcmp(a.computers, b.computers, a.numComputers * sizeof(int)) != 0;
+	free(a.computers);
+	free(b.computers);
+
+	int *countA = malloc(n * sizeof(int));
+	int *countB = malloc(n * sizeof(int));
+	networkReachCounts(plain, countA);
+	networkReachCounts(ordered, countB);
+	failures += memcmp(countA, countB, n * sizeof(int)) != 0;
+	free(countA);
+	free(countB);
+
+	// Task 3：各个引擎、提前终止、点到点
+	int start = randRange(state, 0, n - 1);
+	PoodleEngine engines[] = {ENGINE_RADIX_HEAP, ENGINE_BUCKET, ENGINE_DELTA_STEPPING};
+	for (int k = 0; k < 3; k++)
+		failures += comparePoodle(plain, ordered, start, engines[k]);
+
+	int deadline = randRange(state, 1, 40);
+	int maxSteps = randRange(state, 1, n);
+	struct poodleResult pa = networkPoodleBounded(plain, start, deadline, maxSteps);
+	struct poodleResult pb = networkPoodleBounded(ordered, start, deadline, maxSteps);
+	failures += !sameResult(pa, pb);
+	freePoodleResult(pa);
+	freePoodleResult(pb);
+
+	int target = randRange(state, 0, n - 1);
+	InfectionPath ia = networkInfectionPath(plain, start, target);
+	InfectionPath ib = networkInfectionPath(ordered, start, target);
+	failures += ia.time != ib.time || (ib.length > 0 && (ib.computers[0] != start || ib.computers[ib.length - 1] != target));
+	freeInfectionPath(ia);
+	freeInfectionPath(ib);
+
+	SourceSummary *sa = malloc(n * sizeof(SourceSummary));
+	SourceSummary *sb = malloc(n * sizeof(SourceSummary));
+	networkSourceSummaries(plain, sa, 2);
+	networkSourceSummaries(ordered, sb, 2);
+	failures += memcmp(sa, sb, n * sizeof(SourceSummary)) != 0;
+	free(sa);
+	free(sb);
+
+	// Task 4
+	pa = networkAdvancedPoodle(plain, start);
+	pb = networkAdvancedPoodle(ordered, start);
+	failures += !sameResult(pa, pb);
+	freePoodleResult(pa);
+	freePoodleResult(pb);
+
+	return failures;
+}
+
+static int checkRandom(int seed)
+{
+	uint64_t state = seed;
+	int n = randRange(&state, 1, 200);
+	struct network net = randomNetwork(n, randRange(&state, 0, 6), seed);
+	int maxTime = randRange(&state, 1, 4); // 时间范围小时平局多
+	for (int v = 0; v < n; v++)
+	{
+		net.computers[v].poodleTime = randRange(&state, 1, maxTime);
+		net.computers[v].securityLevel = randRange(&state, 1, 10);
+	}
+	for (int i = 0; i < net.numConnections; i++)
+		net.connections[i].transmissionTime = randRange(&state, 1, maxTime);
+
+	int failures = 0;
+	Network *plain = openNetwork(net.computers, n, net.connections, net.numConnections);
+	for (int k = 0; k < NUM_ORDERS; k++)
+	{
+		Network *ordered = openNetworkOrdered(net.computers, n, net.connections, net.numConnections, ORDERS[k]);
+		int mismatches = compareHandles(&net, plain, ordered, &state);
+		if (mismatches > 0)
+			fprintf(stderr, "benchReorder: seed %d, order %s has %d mismatches\n", seed, ORDER_NAMES[k + 1],
+					mismatches);
+		failures += mismatches;
+		closeNetwork(ordered);
+	}
+	closeNetwork(plain);
+	freeNetwork(&net);
+	return failures;
+}
+
+// 本线程(用户态)的硬件缓存缺失计数器，不可用时返回-1
+static int openCacheMisses(void)
+{
+	struct perf_event_attr attr;
+	memset(&attr, 0, sizeof(attr));
+	attr.type = PERF_TYPE_HARDWARE;
+	attr.size = sizeof(attr);
+	attr.config = PERF_COUNT_HW_CACHE_MISSES;
+	attr.disabled = 1;
+	attr.exclude_kernel = 1;
+	attr.exclude_hv = 1;
+	return (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+// 边两端的编号之差：平均值，以及差小于16(time[]中同一个64字节缓存行)的边所占的比例
+static void edgeLocality(const Graph *graph, double *meanGap, double *sameLine)
+{
+	long long total = 0, near = 0;
+	for (int u = 0; u < graph->numComputers; u++)
+	{
+		for (int e = graph->offsets[u]; e < graph->offsets[u + 1]; e++)
+		{
+			int gap = abs(graph->dest[e] - u);
+			total += gap;
+			near += gap < 16;
+		}
+	}
+	*meanGap = graph->numEdges > 0 ? (double)total / graph->numEdges : 0;
+	*sameLine = graph->numEdges > 0 ? (double)near / graph->numEdges : 0;
+}
+
+// 随机打乱计算机编号(生成器按空间位置编号的网格本来就有很好的局部性，真实数据的编号通常没有)
+static void shuffleIds(struct network *net, uint64_t seed)
+{
+	int n = net->numComputers;
+	int *perm = malloc(n * sizeof(int));
+	struct computer *computers = malloc(n * sizeof(struct computer));
+	for (int v = 0; v < n; v++)
+		perm[v] = v;
+	for (int v = n - 1; v > 0; v--)
+	{
+		int w = randRange(&seed, 0, v);
+		int t = perm[v];
+		perm[v] = perm[w];
+		perm[w] = t;
+	}
+	for (int v = 0; v < n; v++)
+		computers[perm[v]] = net->computers[v];
+	memcpy(net->computers, computers, n * sizeof(struct computer));
+	for (int i = 0; i < net->numConnections; i++)
+	{
+		net->connections[i].computerA = perm[net->connections[i].computerA];
+		net->connections[i].computerB = perm[net->connections[i].computerB];
+	}
+	free(computers);
+	free(perm);
+}
+
+static int runLarge(Topology topology, bool shuffle, int numComputers, int numQueries)
+{
+	GenParams params = defaultGenParams(numComputers);
+	params.topology = topology;
+	params.avgDegree = 8;
+	params.levels = LEVELS_LOW;
+	struct network net = generateNetwork(&params);
+	if (shuffle)
+		shuffleIds(&net, 7);
+	int n = net.numComputers;
+	printf("%s%s computers=%d connections=%d queries=%d\n", topologyName(topology), shuffle ? ", shuffled" : "", n,
+		   net.numConnections, numQueries);
+	printf("  %-8s %10s %10s %10s %14s %14s %14s\n", "order", "build ms", "mean gap", "same line", "times ms/query",
+		   "poodle ms/query", "cache misses");
+
+	int *sources = malloc((numQueries + 1) * sizeof(int));
+	uint64_t state = 42;
+	for (int q = 0; q < numQueries; q++)
+		sources[q] = randRange(&state, 0, n - 1);
+
+	int *expected = malloc(n * sizeof(int));
+	int *time = malloc(n * sizeof(int));
+	int counter = openCacheMisses();
+	int failures = 0;
+	for (int k = -1; k < NUM_ORDERS; k++)
+	{
+		GraphOrder order = k < 0 ? ORDER_NONE : ORDERS[k];
+		int64_t t0 = nowNs();
+		Graph *graph = buildGraphOrdered(net.computers, n, net.connections, net.numConnections, order);
+		int64_t build = nowNs() - t0;
+		double meanGap, sameLine;
+		edgeLocality(graph, &meanGap, &sameLine);
+		freeGraph(graph);
+
+		Network *handle = openNetworkOrdered(net.computers, n, net.connections, net.numConnections, order);
+		networkInfectionTimes(handle, sources[0], time); // 攻击图与缓冲区就位
+
+		// 只计时间的查询，以及完整的poodle(含结果的构建与编号的转换)
+		if (counter >= 0)
+		{
+			ioctl(counter, PERF_EVENT_IOC_RESET, 0);
+			ioctl(counter, PERF_EVENT_IOC_ENABLE, 0);
+		}
+		t0 = nowNs();
+		for (int q = 0; q < numQueries; q++)
+			networkInfectionTimes(handle, sources[q], time);
+		double timesMs = (nowNs() - t0) / 1e6 / numQueries;
+		long long misses = -1;
+		if (counter >= 0)
+		{
+			ioctl(counter, PERF_EVENT_IOC_DISABLE, 0);
+			if (read(counter, &misses, sizeof(misses)) != sizeof(misses))
+				misses = -1;
+		}
+
+		t0 = nowNs();
+		for (int q = 0; q < numQueries; q++)
+			freePoodleResult(networkPoodle(handle, sources[q]));
+		double poodleMs = (nowNs() - t0) / 1e6 / numQueries;
+
+		char missText[32];
+		if (misses >= 0)
+			snprintf(missText, sizeof(missText), "%lld", misses / (numQueries > 0 ? numQueries : 1));
+		else
+			snprintf(missText, sizeof(missText), "unavailable");
+		printf("  %-8s %10.1f %10.1f %9.1f%% %14.3f %14.3f %14s\n", ORDER_NAMES[k + 1], build / 1e6, meanGap,
+			   100 * sameLine, timesMs, poodleMs, missText);
+
+		// 最后一次查询的结果与不重排时相同
+		if (k < 0)
+			memcpy(expected, time, n * sizeof(int));
+		else if (memcmp(expected, time, n * sizeof(int)) != 0)
+		{
+			fprintf(stderr, "benchReorder: %s differs with order %s\n", topologyName(topology), ORDER_NAMES[k + 1]);
+			failures++;
+		}
+		closeNetwork(handle);
+	}
+
+	if (counter >= 0)
+		close(counter);
+	free(sources);
+	free(expected);
+	free(time);
+	freeNetwork(&net);
+	return failures;
+}
+
+int main(int argc, char *argv[])
+{
+	int numComputers = argc > 1 ? atoi(argv[1]) : 1000000;
+	int numQueries = argc > 2 ? atoi(argv[2]) : 5;
+	int failures = 0;
+
+	for (int seed = 1; seed <= 500; seed++)
+		failures += checkRandom(seed);
+	printf("random networks checked: 500\n");
+
+	// 网格有空间局部性，打乱编号后正是重排能恢复的情况；ER与幂律网络没有可以恢复的局部性
+	failures += runLarge(TOPO_GRID, false, numComputers, numQueries);
+	failures += runLarge(TOPO_GRID, true, numComputers, numQueries);
+	failures += runLarge(TOPO_ERDOS_RENYI, false, numComputers, numQueries);
+	failures += runLarge(TOPO_POWER_LAW, true, numComputers, numQueries);
+
+	if (failures > 0)
+		return EXIT_FAILURE;
+	printf("all results match\n");
+	return 0;
+}
@@ -0,0 +1,186 @@
+// 验证与基准测试：全源poodle扫描
+//
+// 用法: ./benchSourceSummaries [numComputers] [maxThreads]   (默认 10000 台计算机、8个线程)
+//
+// 1. 在随机小网络上，networkSourceSummaries的摘要必须与逐个源调用networkInfectionTimes、
+//    排序后计算的摘要相同(不同线程数、不同引擎)；
+// 2. 在大网络上比较：
+//      - poodle.h的poodle包装函数逐个源调用(只在少量源上计时后折算)；
+//      - 在同一个句柄上逐个源调用networkInfectionTimes；
+//      - networkSourceSummaries，线程数从1翻倍到maxThreads。
+
+#include <limits.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../Network.h"
+#include "../ThreadPool.h"
+#include "benchUtil.h"
+
+#define WRAPPER_SOURCES 50
+
+static int compareInt(const void *a, const void *b)
+{
+	int x = *(const int *)a;
+	int y = *(const int *)b;
+	return (x > y) - (x < y);
+}
+
+// 参考实现：逐个源搜索，对能入侵的时间排序后取百分位
+static void referenceSummaries(Network *handle, int n, SourceSummary summaries[])
+{
+	int *time = malloc(n * sizeof(int));
+	int *sorted = malloc(n * sizeof(int));
+	for (int s = 0; s < n; s++)
+	{
+		networkInfectionTimes(handle, s, time);
+		int reached = 0;
+		for (int v = 0; v < n; v++)
+		{
+			if (time[v] != INT_MAX)
+				sorted[reached++] = time[v];
+		}
+		qsort(sorted, reached, sizeof(int), compareInt);
+
+		int percentiles[3] = {50, 90, 99};
+		int values[3];
+		for (int k = 0; k < 3; k++)
+		{
+			// 最小的t，使至少p%的计算机在t之前被入侵
+			int rank = 1;
+			while (rank * 100 < percentiles[k] * reached)
+				rank++;
+			values[k] = sorted[rank - 1];
+		}
+		summaries[s] = (SourceSummary){reached, sorted[reached - 1], values[0], values[1], values[2]};
+	}
+	free(time);
+	free(sorted);
+}
+
+static bool sameSummaries(SourceSummary a[], SourceSummary b[], int n)
+{
+	for (int i = 0; i < n; i++)
+	{
+		if (a[i].reached != b[i].reached || a[i].fullSpreadTime != b[i].fullSpreadTime ||
+			a[i].p50 != b[i].p50 || a[i].p90 != b[i].p90 || a[i].p99 != b[i].p99)
+			return false;
+	}
+	return true;
+}
+
+static int checkRandom(int seed)
+{
+	uint64_t state = seed;
+	int n = randRange(&state, 1, 200);
+	struct network net = randomNetwork(n, randRange(&state, 0, 6), seed);
+	Network *handle = openNetwork(net.computers, n, net.connections, net.numConnections);
+
+	SourceSummary *expected = malloc(n * sizeof(SourceSummary));
+	SourceSummary *actual = malloc(n * sizeof(SourceSummary));
+	referenceSummaries(handle, n, expected);
+
+	int failures = 0;
+	int threads[] = {1, 3};
+	PoodleEngine engines[] = {ENGINE_RADIX_HEAP, ENGINE_BINARY_HEAP};
+	for (int e = 0; e < 2; e++)
+	{
+		setPoodleEngine(handle, engines[e]);
+		for (int t = 0; t < 2; t++)
+		{
+			memset(actual, 0, n * sizeof(SourceSummary));
+			if (!networkSourceSummaries(handle, actual, threads[t]) || !sameSummaries(expected, actual, n))
+			{
+				fprintf(stderr, "benchSourceSummaries: seed %d differs (engine %d, %d threads)\n", seed,
+						engines[e], threads[t]);
+				failures++;
+			}
+		}
+	}
+
+	free(expected);
+	free(actual);
+	closeNetwork(handle);
+	freeNetwork(&net);
+	return failures;
+}
+
+int main(int argc, char *argv[])
+{
+	int numComputers = argc > 1 ? atoi(argv[1]) : 10000;
+	int maxThreads = argc > 2 ? atoi(argv[2]) : 8;
+	int failures = 0;
+
+	for (int seed = 1; seed <= 300; seed++)
+		failures += checkRandom(seed);
+	printf("random networks checked: 300\n");
+
+	struct network net = randomNetwork(numComputers, 4, 2521);
+	Network *handle = openNetwork(net.computers, numComputers, net.connections, net.numConnections);
+	SourceSummary *expected = malloc(numComputers * sizeof(SourceSummary));
+	SourceSummary *summaries = malloc(numComputers * sizeof(SourceSummary));
+
+	printf("computers=%d connections=%d cpus=%d\n", numComputers, net.numConnections, onlineCpuCount());
+	printf("%-28s %12s %14s %10s\n", "method", "ms", "sources/sec", "speedup");
+
+	// 包装函数：只跑前WRAPPER_SOURCES个源
+	int wrapperSources = numComputers < WRAPPER_SOURCES ? numComputers : WRAPPER_SOURCES;
+	int64_t t0 = nowNs();
+	for (int s = 0; s < wrapperSources; s++)
+	{
+		struct poodleResult res = poodle(net.computers, numComputers, net.connections, net.numConnections, s);
+		for (int i = 0; i < res.numSteps; i++)
+		{
+			struct computerList *curr = res.steps[i].recipients;
+			while (curr)
+			{
+				struct computerList *temp = curr;
+				curr = curr->next;
+				free(temp);
+			}
+		}
+		free(res.steps);
+	}
+	int64_t elapsed = nowNs() - t0;
+	printf("%-28s %12.3f %14.0f %10s   (%d sources)\n", "poodle wrapper", elapsed / 1e6,
+		   wrapperSources / (elapsed / 1e9), "", wrapperSources);
+
+	t0 = nowNs();
+	referenceSummaries(handle, numComputers, expected);
+	elapsed = nowNs() - t0;
+	printf("%-28s %12.3f %14.0f\n", "infectionTimes loop + sort", elapsed / 1e6, numComputers / (elapsed / 1e9));
+
+	int64_t oneThread = 0;
+	for (int threads = 1; threads <= maxThreads; threads *= 2)
+	{
+		// 先跑一次，使线程池与每个线程的缓冲区就位，只计时第二次
+		networkSourceSummaries(handle, summaries, threads);
+		t0 = nowNs();
+		bool ok = networkSourceSummaries(handle, summaries, threads);
+		elapsed = nowNs() - t0;
+		if (threads == 1)
+			oneThread = elapsed;
+
+		char name[64];
+		snprintf(name, sizeof(name), "sweep, %d thread%s", threads, threads > 1 ? "s" : "");
+		printf("%-28s %12.3f %14.0f %9.2fx\n", name, elapsed / 1e6, numComputers / (elapsed / 1e9),
+			   (double)oneThread / elapsed);
+		if (!ok || !sameSummaries(expected, summaries, numComputers))
+		{
+			fprintf(stderr, "benchSourceSummaries: sweep differs with %d threads\n", threads);
+			failures++;
+		}
+	}
+
+	free(expected);
+	free(summaries);
+	closeNetwork(handle);
+	freeNetwork(&net);
+
+	if (failures > 0)
+		return EXIT_FAILURE;
+	printf("all results match\n");
+	return 0;
+}
@@ -0,0 +1,261 @@
+// 验证与基准测试：查询统计(setQueryStats)
+//
+// 用法: ./benchStats [numComputers] [numQueries]   (默认 2·10^5 台计算机、10次查询)
+//
+// 1. 在随机小网络上，开启统计的句柄与关闭统计的句柄对每一种引擎、每一个查询入口的结果必须相同；
+//    计数必须自洽：确定的计算机数等于步骤数，检查过的边加上被权限挡住的边等于这些计算机的度数之和，
+//    完整的Dijkstra中每台计算机恰好入队、出队各一次，advancedPoodle的出队次数不少于
+//    第一次入侵与按更高等级再次展开的次数之和，各阶段耗时之和不超过总耗时；
+//    formatQueryStatsJson的输出与返回的长度一致，缓冲区不足时截断并以'\0'结尾；
+// 2. 在大网络上比较关闭与开启统计时poodle / advancedPoodle的平均耗时，并打印一次查询的JSON。
+
+#include <limits.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../Network.h"
+#include "../QueryStats.h"
+#include "benchUtil.h"
+#include "netgen.h"
+
+static bool sameResult(struct poodleResult a, struct poodleResult b)
+{
+	if (a.numSteps != b.numSteps)
+		return false;
+	for (int i = 0; i < a.numSteps; i++)
+	{
+		if (a.steps[i].computer != b.steps[i].computer || a.steps[i].time != b.steps[i].time)
+			return false;
+		struct computerList *x = a.steps[i].recipients;
+		struct computerList *y = b.steps[i].recipients;
+		for (; x && y; x = x->next, y = y->next)
+		{
+			if (x->computer != y->computer)
+				return false;
+		}
+		if (x || y)
+			return false;
+	}
+	return true;
+}
+
+// 所有查询共同的检查：名称、阶段耗时
+static int checkCommon(const QueryStats *stats, const char *query)
+{
+	long long phases = 0;
+	for (int p = 0; p < NUM_PHASES; p++)
+	{
+		if (stats->phaseNs[p] < 0)
+			return 1;
+		phases += stats->phaseNs[p];
+	}
+	return strcmp(stats->query, query) != 0 || phases > stats->totalNs;
+}
+
+// 正向搜索的检查：settled台计算机就是结果中的计算机，边的计数与它们的度数之和一致
+static int checkForward(const QueryStats *stats, struct poodleResult res, const int degree[], bool heap)
+{
+	long long degrees = 0;
+	for (int i = 0; i < res.numSteps; i++)
+		degrees += degree[res.steps[i].computer];
+
+	int failures = stats->settled != res.numSteps || stats->edgesScanned + stats->permissionRejections != degrees ||
+				   stats->levelUpgrades != 0 || !stats->engine;
+	// 使用优先队列的完整搜索中，每台能入侵的计算机入队、出队各一次
+	if (heap)
+		failures += stats->pushes != res.numSteps || stats->pops != res.numSteps ||
+					stats->decreaseKeys > stats->edgesScanned;
+	return failures;
+}
+
+static int checkJson(const QueryStats *stats)
+{
+	char buffer[1024];
+	int length = formatQueryStatsJson(stats, NULL, 0);
+	int written = formatQueryStatsJson(stats, buffer, sizeof(buffer));
+	char small[16];
+	formatQueryStatsJson(stats, small, sizeof(small));
+	return length != written || (int)strlen(buffer) != length || buffer[0] != '{' || buffer[length - 1] != '}' ||
+		   strncmp(small, buffer, sizeof(small) - 1) != 0 || small[sizeof(small) - 1] != '\0';
+}
+
+static int checkRandom(int seed)
+{
+	uint64_t state = seed;
+	int n = randRange(&state, 1, 200);
+	struct network net = randomNetwork(n, randRange(&state, 0, n < 40 ? n : 40), seed);
+	int maxTime = randRange(&state, 1, 4) == 1 ? 1000 : randRange(&state, 1, 4);
+	for (int v = 0; v < n; v++)
+	{
+		net.computers[v].poodleTime = randRange(&state, 1, maxTime);
+		net.computers[v].securityLevel = randRange(&state, 1, 10);
+	}
+	int *degree = calloc(n, sizeof(int));
+	for (int i = 0; i < net.numConnections; i++)
+	{
+		net.connections[i].transmissionTime = randRange(&state, 1, maxTime);
+		degree[net.connections[i].computerA]++;
+		degree[net.connections[i].computerB]++;
+	}
+
+	Network *plain = openNetwork(net.computers, n, net.connections, net.numConnections);
+	Network *counted = openNetworkOrdered(net.computers, n, net.connections, net.numConnections,
+										  seed % 2 ? ORDER_NONE : ORDER_BFS);
+	QueryStats stats;
+	setQueryStats(counted, &stats);
+	int failures = 0;
+
+	PoodleEngine engines[] = {ENGINE_BINARY_HEAP, ENGINE_QUAD_HEAP, ENGINE_RADIX_HEAP, ENGINE_BUCKET, ENGINE_DENSE,
+							  ENGINE_AUTO};
+	for (int query = 0; query < 3; query++)
+	{
+		int start = randRange(&state, 0, n - 1);
+		int target = randRange(&state, 0, n - 1);
+		struct poodleResult expected = networkPoodle(plain, start);
+
+		for (int k = 0; k < 6; k++)
+		{
+			setPoodleEngine(counted, engines[k]);
+			struct poodleResult res = networkPoodle(counted, start);
+			failures += !sameResult(expected, res) || checkCommon(&stats, "poodle") ||
+						checkForward(&stats, res, degree, engines[k] <= ENGINE_RADIX_HEAP) ||
+						stats.allocatedBytes <= 0 || checkJson(&stats);
+			freePoodleResult(res);
+		}
+		setPoodleEngine(counted, ENGINE_AUTO);
+
+		int deadline = randRange(&state, 0, expected.steps[expected.numSteps - 1].time);
+		int maxSteps = randRange(&state, 0, n);
+		struct poodleResult bounded = networkPoodleBounded(plain, start, deadline, maxSteps);
+		struct poodleResult res = networkPoodleBounded(counted, start, deadline, maxSteps);
+		failures += !sameResult(bounded, res) || checkCommon(&stats, "poodleBounded") ||
+					checkForward(&stats, res, degree, false) || stats.pops < stats.settled;
+		freePoodleResult(bounded);
+		freePoodleResult(res);
+
+		// advancedPoodle：全部入队的状态都会出队
+		struct poodleResult advanced = networkAdvancedPoodle(plain, start);
+		res = networkAdvancedPoodle(counted, start);
+		failures += !sameResult(advanced, res) || checkCommon(&stats, "advancedPoodle") ||
+					stats.settled != res.numSteps || stats.pushes != stats.pops ||
+					stats.pops < stats.settled + stats.levelUpgrades || stats.edgesScanned < stats.settled - 1 ||
+					checkJson(&stats);
+		freePoodleResult(advanced);
+		freePoodleResult(res);
+
+		InfectionPath path = networkInfectionPath(plain, start, target);
+		InfectionPath countedPath = networkInfectionPath(counted, start, target);
+		failures += path.time != countedPath.time || path.length != countedPath.length ||
+					checkCommon(&stats, "infectionPath") || stats.pops > stats.pushes ||
+					(path.length > 0 && stats.allocatedBytes != path.length * (long long)sizeof(int));
+		freeInfectionPath(path);
+		freeInfectionPath(countedPath);
+
+		int *time = malloc(n * sizeof(int));
+		failures += networkInfectionTimes(counted, start, time) != expected.numSteps ||
+					checkCommon(&stats, "infectionTimes") || stats.settled != expected.numSteps;
+		free(time);
+		freePoodleResult(expected);
+	}
+
+	struct chooseSourceResult best = networkChooseSource(plain);
+	struct chooseSourceResult countedBest = networkChooseSource(counted);
+	failures += best.sourceComputer != countedBest.sourceComputer || best.numComputers != countedBest.numComputers ||
+				checkCommon(&stats, "chooseSource");
+	free(best.computers);
+	free(countedBest.computers);
+
+	int path[2] = {0, n - 1};
+	struct probePathResult probe = networkProbePath(plain, path, 2);
+	struct probePathResult countedProbe = networkProbePath(counted, path, 2);
+	failures += probe.status != countedProbe.status || probe.elapsedTime != countedProbe.elapsedTime ||
+				checkCommon(&stats, "probePath");
+
+	// 关闭之后不再写入
+	setQueryStats(counted, NULL);
+	stats.settled = -1;
+	freePoodleResult(networkPoodle(counted, 0));
+	failures += stats.settled != -1;
+
+	if (failures > 0)
+		fprintf(stderr, "benchStats: seed %d has %d mismatches\n", seed, failures);
+	free(degree);
+	closeNetwork(plain);
+	closeNetwork(counted);
+	freeNetwork(&net);
+	return failures;
+}
+
+// numQueries次查询的平均耗时(毫秒)，stats为NULL时关闭统计；先跑一次使缓冲区与攻击图就位
+static double timeQueries(Network *handle, QueryStats *stats, bool advanced, const int sources[], int numQueries)
+{
+	setQueryStats(handle, stats);
+	freePoodleResult(advanced ? networkAdvancedPoodle(handle, 0) : networkPoodle(handle, 0));
+	int64_t t0 = nowNs();
+	for (int q = 0; q < numQueries; q++)
+		freePoodleResult(advanced ? networkAdvancedPoodle(handle, sources[q]) : networkPoodle(handle, sources[q]));
+	return (nowNs() - t0) / 1e6 / numQueries;
+}
+
+int main(int argc, char *argv[])
+{
+	int numComputers = argc > 1 ? atoi(argv[1]) : 200000;
+	int numQueries = argc > 2 ? atoi(argv[2]) : 10;
+	int failures = 0;
+
+	for (int seed = 1; seed <= 1000; seed++)
+		failures += checkRandom(seed);
+	printf("random networks checked: 1000\n");
+
+	GenParams params = defaultGenParams(numComputers);
+	params.avgDegree = 8;
+	params.levels = LEVELS_LOW; // 大部分计算机可以互相入侵，仍有一部分边被安全等级挡住
+	struct network net = generateNetwork(&params);
+	uint64_t state = 7;
+	int *sources = malloc(numQueries * sizeof(int));
+	for (int q = 0; q < numQueries; q++)
+		sources[q] = randRange(&state, 0, numComputers - 1);
+	printf("computers=%d connections=%d queries=%d, ms per query\n", numComputers, net.numConnections, numQueries);
+
+	QueryStats stats;
+	Network *handle = openNetwork(net.computers, numComputers, net.connections, net.numConnections);
+	setPoodleEngine(handle, ENGINE_RADIX_HEAP);
+	printf("  %-16s %10s %10s %9s\n", "query", "off", "on", "overhead");
+	for (int advanced = 0; advanced <= 1; advanced++)
+	{
+		// 交替测两轮，取较快的一轮
+		double off = 1e30, on = 1e30;
+		for (int round = 0; round < 2; round++)
+		{
+			double ms = timeQueries(handle, NULL, advanced, sources, numQueries);
+			off = ms < off ? ms : off;
+			ms = timeQueries(handle, &stats, advanced, sources, numQueries);
+			on = ms < on ? ms : on;
+		}
+		printf("  %-16s %10.3f %10.3f %8.1f%%\n", advanced ? "advancedPoodle" : "poodle", off, on,
+			   (on / off - 1) * 100);
+	}
+	closeNetwork(handle);
+
+	// 新句柄上的第一次查询包含攻击图的构建
+	char json[1024];
+	handle = openNetwork(net.computers, numComputers, net.connections, net.numConnections);
+	setQueryStats(handle, &stats);
+	freePoodleResult(networkPoodle(handle, sources[0]));
+	formatQueryStatsJson(&stats, json, sizeof(json));
+	printf("%s\n", json);
+	freePoodleResult(networkAdvancedPoodle(handle, sources[0]));
+	formatQueryStatsJson(&stats, json, sizeof(json));
+	printf("%s\n", json);
+	closeNetwork(handle);
+
+	free(sources);
+	freeNetwork(&net);
+
+	if (failures > 0)
+		return EXIT_FAILURE;
+	printf("all results match\n");
+	return 0;
+}
@@ -0,0 +1,252 @@
+// 扩展性基准测试套件：在不同拓扑与规模的合成网络上运行四个任务，输出CSV
+//
+// 用法: ./benchSuite [选项] > results.csv
+//   --min N          最小规模(默认 1000)，规模从N开始每次乘以10
+//   --max N          最大规模(默认 1000000；10^7需要数GB内存)
+//   --topologies L   逗号分隔的拓扑列表(默认 er,powerlaw,grid,chain)
+//   --tasks L        逗号分隔的任务列表(默认 probe,choose,poodle,advanced)
+//   --queries Q      probe的路径数量(默认 100000)
+//
+// 每个(任务, 拓扑, 规模)在单独的子进程中运行，所以peak_rss_mb是该组合自己的内存峰值
+// (包括生成网络所用的内存)。建图时间(openNetwork)单独列出，不计入wall_ms。
+// 列：task,topology,computers,connections,queries,build_ms,wall_ms,throughput,unit,peak_rss_mb
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "../Network.h"
+#include "netgen.h"
+
+#define PROBE_PATH_LENGTH 16
+#define POODLE_SOURCES 3
+
+typedef enum Task
+{
+	TASK_PROBE,
+	TASK_CHOOSE,
+	TASK_POODLE,
+	TASK_ADVANCED,
+	NUM_TASKS,
+} Task;
+
+static const char *taskNames[NUM_TASKS] = {"probe", "choose", "poodle", "advanced"};
+
+static double peakRssMb(void)
+{
+	struct rusage usage;
+	getrusage(RUSAGE_SELF, &usage);
+	return usage.ru_maxrss / 1024.0;
+}
+
+// 在子进程中运行一个组合并输出一行CSV
+static void runCase(Task task, Topology topology, int numComputers, int numQueries)
+{
+	GenParams params = defaultGenParams(numComputers);
+	params.topology = topology;
+	// 链上使用递减的安全等级，使凝聚图为一条很深的路径
+	if (topology == TOPO_CHAIN)
+		params.levels = LEVELS_GRADIENT;
+
+	struct network net = generateNetwork(&params);
+	if (net.numComputers == 0)
+		exit(EXIT_FAILURE);
+
+	int64_t t0 = nowNs();
+	Network *handle = openNetwork(net.computers, net.numComputers, net.connections, net.numConnections);
+	int64_t buildNs = nowNs() - t0;
+	if (!handle)
+		exit(EXIT_FAILURE);
+
+	uint64_t state = 42;
+	int queries = 1;
+	double work = 0; // 吞吐量的分子
+	const char *unit = "";
+	int64_t wallNs = 0;
+
+	switch (task)
+	{
+	case TASK_PROBE:
+	{
+		// 预先生成随机游走路径，孤立的计算机原地停留(自环代价为0)
+		int *paths = malloc((int64_t)numQueries * PROBE_PATH_LENGTH * sizeof(int));
+		int *degreeStart = calloc(net.numComputers + 1, sizeof(int));
+		int *neighbours = malloc((2 * (int64_t)net.numConnections + 1) * sizeof(int));
+		for (int i = 0; i < net.numConnections; i++)
+		{
+			degreeStart[net.connections[i].computerA + 1]++;
+			degreeStart[net.connections[i].computerB + 1]++;
+		}
+		for (int v = 0; v < net.numComputers; v++)
+			degreeStart[v + 1] += degreeStart[v];
+		int *fill = malloc((net.numComputers + 1) * sizeof(int));
+		memcpy(fill, degreeStart, (net.numComputers + 1) * sizeof(int));
+		for (int i = 0; i < net.numConnections; i++)
+		{
+			neighbours[fill[net.connections[i].computerA]++] = net.connections[i].computerB;
+			neighbours[fill[net.connections[i].computerB]++] = net.connections[i].computerA;
+		}
+		free(fill);
+
+		for (int q = 0; q < numQueries; q++)
+		{
+			int *path = &paths[(int64_t)q * PROBE_PATH_LENGTH];
+			path[0] = randRange(&state, 0, net.numComputers - 1);
+			for (int i = 1; i < PROBE_PATH_LENGTH; i++)
+			{
+				int u = path[i - 1];
+				int d = degreeStart[u + 1] - degreeStart[u];
+				path[i] = d == 0 ? u : neighbours[degreeStart[u] + randRange(&state, 0, d - 1)];
+			}
+		}
+		free(degreeStart);
+		free(neighbours);
+
+		t0 = nowNs();
+		for (int q = 0; q < numQueries; q++)
+			networkProbePath(handle, &paths[(int64_t)q * PROBE_PATH_LENGTH], PROBE_PATH_LENGTH);
+		wallNs = nowNs() - t0;
+		free(paths);
+
+		queries = numQueries;
+		work = numQueries;
+		unit = "paths/s";
+		break;
+	}
+
+	case TASK_CHOOSE:
+	{
+		t0 = nowNs();
+		struct chooseSourceResult res = networkChooseSource(handle);
+		wallNs = nowNs() - t0;
+		free(res.computers);
+		work = net.numComputers;
+		unit = "computers/s";
+		break;
+	}
+
+	case TASK_POODLE:
+	case TASK_ADVANCED:
+	{
+		queries = task == TASK_POODLE ? POODLE_SOURCES : 1;
+		t0 = nowNs();
+		for (int q = 0; q < queries; q++)
+		{
+			int start = randRange(&state, 0, net.numComputers - 1);
+			struct poodleResult res = task == TASK_POODLE ? networkPoodle(handle, start)
+														  : networkAdvancedPoodle(handle, start);
+			work += res.numSteps;
+			freePoodleResult(res);
+		}
+		wallNs = nowNs() - t0;
+		unit = "infected/s";
+		break;
+	}
+
+	default:
+		break;
+	}
+
+	printf("%s,%s,%d,%d,%d,%.3f,%.3f,%.0f,%s,%.1f\n", taskNames[task], topologyName(topology),
+		   net.numComputers, net.numConnections, queries, buildNs / 1e6, wallNs / 1e6,
+		   wallNs > 0 ? work / (wallNs / 1e9) : 0.0, unit, peakRssMb());
+	fflush(stdout);
+
+	closeNetwork(handle);
+	freeNetwork(&net);
+	exit(EXIT_SUCCESS);
+}
+
+// 解析逗号分隔的名称列表，enabled[i]表示第i个名称被选中
+static bool parseList(char *list, const char *names[], int count, bool enabled[])
+{
+	for (int i = 0; i < count; i++)
+		enabled[i] = false;
+	for (char *token = strtok(list, ","); token; token = strtok(NULL, ","))
+	{
+		int i = 0;
+		while (i < count && strcmp(names[i], token) != 0)
+			i++;
+		if (i == count)
+			return false;
+		enabled[i] = true;
+	}
+	return true;
+}
+
+int main(int argc, char *argv[])
+{
+	int minSize = 1000;
+	int maxSize = 1000000;
+	int numQueries = 100000;
+	const char *topologyList[] = {"er", "powerlaw", "grid", "chain"};
+	bool topologies[4] = {true, true, true, true};
+	bool tasks[NUM_TASKS] = {true, true, true, true};
+
+	for (int i = 1; i < argc; i++)
+	{
+		bool hasValue = i + 1 < argc;
+		if (strcmp(argv[i], "--min") == 0 && hasValue)
+			minSize = atoi(argv[++i]);
+		else if (strcmp(argv[i], "--max") == 0 && hasValue)
+			maxSize = atoi(argv[++i]);
+		else if (strcmp(argv[i], "--queries") == 0 && hasValue)
+			numQueries = atoi(argv[++i]);
+		else if (strcmp(argv[i], "--topologies") == 0 && hasValue &&
+				 parseList(argv[i + 1], topologyList, 4, topologies))
+			i++;
+		else if (strcmp(argv[i], "--tasks") == 0 && hasValue &&
+				 parseList(argv[i + 1], taskNames, NUM_TASKS, tasks))
+			i++;
+		else
+		{
+			fprintf(stderr, "usage: %s [--min N] [--max N] [--queries Q] "
+							"[--topologies er,powerlaw,grid,chain] [--tasks probe,choose,poodle,advanced]\n",
+					argv[0]);
+			return EXIT_FAILURE;
+		}
+	}
+	if (minSize < 1 || maxSize < minSize || numQueries < 1)
+	{
+		fprintf(stderr, "benchSuite: invalid sizes or query count\n");
+		return EXIT_FAILURE;
+	}
+
+	printf("task,topology,computers,connections,queries,build_ms,wall_ms,throughput,unit,peak_rss_mb\n");
+	fflush(stdout);
+
+	int failures = 0;
+	for (int64_t size = minSize; size <= maxSize; size *= 10)
+	{
+		for (int t = 0; t < 4; t++)
+		{
+			Topology topology;
+			if (!topologies[t] || !parseTopology(topologyList[t], &topology))
+				continue;
+			for (int k = 0; k < NUM_TASKS; k++)
+			{
+				if (!tasks[k])
+					continue;
+
+				pid_t pid = fork();
+				if (pid == 0)
+					runCase((Task)k, topology, (int)size, numQueries);
+
+				int status = 0;
+				if (pid < 0 || waitpid(pid, &status, 0) < 0 || !WIFEXITED(status) ||
+					WEXITSTATUS(status) != 0)
+				{
+					// 子进程失败(例如内存不足被杀死)，记一行空结果
+					printf("%s,%s,%lld,,,,,,failed,\n", taskNames[k], topologyList[t], (long long)size);
+					fflush(stdout);
+					failures++;
+				}
+			}
+		}
+	}
+
+	return failures > 0 ? EXIT_FAILURE : 0;
+}
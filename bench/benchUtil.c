@@ -0,0 +1,120 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "benchUtil.h"
+
+int64_t nowNs(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (int64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+uint64_t randNext(uint64_t *state)
+{
+	uint64_t x = *state;
+	x ^= x >> 12;
+	x ^= x << 25;
+	x ^= x >> 27;
+	*state = x;
+	return x * 0x2545F4914F6CDD1DULL;
+}
+
+int randRange(uint64_t *state, int lo, int hi)
+{
+	return lo + (int)(randNext(state) % (uint64_t)(hi - lo + 1));
+}
+
+struct network randomNetwork(int numComputers, int avgDegree, uint64_t seed)
+{
+	struct network net = {0};
+	uint64_t state = seed * 0x9E3779B97F4A7C15ULL + 1;
+
+	int extra = (int)((int64_t)numComputers * avgDegree / 2) - (numComputers - 1);
+	if (extra < 0 || numComputers < 2)
+		extra = 0;
+
+	net.numComputers = numComputers;
+	net.numConnections = numComputers - 1 + extra;
+	net.computers = malloc(numComputers * sizeof(struct computer));
+	net.connections = malloc((net.numConnections + 1) * sizeof(struct connection));
+	if (!net.computers || !net.connections)
+	{
+		fprintf(stderr, "randomNetwork: out of memory\n");
+		exit(EXIT_FAILURE);
+	}
+
+	for (int i = 0; i < numComputers; i++)
+	{
+		net.computers[i].securityLevel = randRange(&state, 1, MAX_SECURITY_LEVEL);
+		net.computers[i].poodleTime = randRange(&state, 1, 100);
+	}
+
+	// 随机生成树：节点i连向[0, i)中的一个随机节点
+	int k = 0;
+	for (int i = 1; i < numComputers; i++)
+	{
+		net.connections[k++] = (struct connection){
+			randRange(&state, 0, i - 1), i, randRange(&state, 1, 100)};
+	}
+
+	// 补充随机边(不含自环)
+	while (k < net.numConnections)
+	{
+		int a = randRange(&state, 0, numComputers - 1);
+		int b = randRange(&state, 0, numComputers - 1);
+		if (a == b)
+			continue;
+		net.connections[k++] = (struct connection){a, b, randRange(&state, 1, 100)};
+	}
+
+	return net;
+}
+
+void freeNetwork(struct network *net)
+{
+	free(net->computers);
+	free(net->connections);
+	net->computers = NULL;
+	net->connections = NULL;
+}
+
+struct network readNetwork(const char *filename)
+{
+	struct network net = {0};
+	FILE *fp = fopen(filename, "r");
+	if (!fp)
+		return net;
+
+	int n, m;
+	if (fscanf(fp, "%d %d", &n, &m) != 2 || n <= 0 || m < 0)
+	{
+		fclose(fp);
+		return net;
+	}
+
+	net.computers = malloc(n * sizeof(struct computer));
+	net.connections = malloc((m + 1) * sizeof(struct connection));
+	for (int i = 0; i < n; i++)
+	{
+		if (fscanf(fp, "%d %d", &net.computers[i].securityLevel, &net.computers[i].poodleTime) != 2)
+			goto fail;
+	}
+	for (int i = 0; i < m; i++)
+	{
+		struct connection *c = &net.connections[i];
+		if (fscanf(fp, "%d %d %d", &c->computerA, &c->computerB, &c->transmissionTime) != 3)
+			goto fail;
+	}
+
+	fclose(fp);
+	net.numComputers = n;
+	net.numConnections = m;
+	return net;
+
+fail:
+	fclose(fp);
+	freeNetwork(&net);
+	return net;
+}
@@ -0,0 +1,33 @@
+// 基准测试程序共用的辅助函数
+
+#ifndef BENCH_UTIL_H
+#define BENCH_UTIL_H
+
+#include <stdint.h>
+
+#include "../poodle.h"
+
+// 随机生成的网络
+struct network {
+	int numComputers;
+	struct computer *computers;
+	int numConnections;
+	struct connection *connections;
+};
+
+// 单调时钟，单位为纳秒
+int64_t nowNs(void);
+
+// xorshift64* 伪随机数
+uint64_t randNext(uint64_t *state);
+int randRange(uint64_t *state, int lo, int hi); // [lo, hi]
+
+// 生成一个随机稀疏网络：先用一条随机生成树保证连通，
+// 再补充随机边，使平均度数约为avgDegree
+struct network randomNetwork(int numComputers, int avgDegree, uint64_t seed);
+void freeNetwork(struct network *net);
+
+// 读取data/目录下格式的网络文件，失败时返回numComputers为0的网络
+struct network readNetwork(const char *filename);
+
+#endif
@@ -0,0 +1,55 @@
+// 把文本格式的网络文件转换成二进制快照(见Loader.h)
+//
+// 用法: ./convertNetwork <网络文件> <快照文件>
+// 转换后重新映射一次快照并做完整校验。
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../Graph.h"
+#include "../Loader.h"
+
+int main(int argc, char *argv[])
+{
+	if (argc != 3)
+	{
+		fprintf(stderr, "usage: %s <network file> <snapshot file>\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	NetworkData data;
+	LoadStatus status = loadNetworkText(argv[1], &data);
+	if (status != LOAD_OK)
+	{
+		fprintf(stderr, "convertNetwork: %s: %s\n", argv[1], loadStatusMessage(status));
+		return EXIT_FAILURE;
+	}
+
+	Graph *graph = buildGraph(data.computers, data.numComputers, data.connections, data.numConnections);
+	if (!graph)
+	{
+		fprintf(stderr, "convertNetwork: out of memory\n");
+		freeNetworkData(&data);
+		return EXIT_FAILURE;
+	}
+	status = writeSnapshot(argv[2], graph);
+	freeGraph(graph);
+	freeNetworkData(&data);
+	if (status != LOAD_OK)
+	{
+		fprintf(stderr, "convertNetwork: %s: %s\n", argv[2], loadStatusMessage(status));
+		return EXIT_FAILURE;
+	}
+
+	Snapshot *snapshot;
+	status = mapSnapshot(argv[2], true, &snapshot);
+	if (status != LOAD_OK)
+	{
+		fprintf(stderr, "convertNetwork: %s: %s\n", argv[2], loadStatusMessage(status));
+		return EXIT_FAILURE;
+	}
+	printf("%s: %d computers, %d edges\n", argv[2], snapshotGraph(snapshot)->numComputers,
+		   snapshotGraph(snapshot)->numEdges);
+	unmapSnapshot(snapshot);
+	return 0;
+}
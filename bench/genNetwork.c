@@ -0,0 +1,101 @@
+// 生成大规模合成网络，以data/目录下的文本格式输出
+//
+// 用法: ./genNetwork [选项] <输出文件>
+//   --computers N        计算机数量(默认 1000)
+//   --topology T         er | powerlaw | grid | chain (默认 er)
+//   --degree D           平均度数，对grid与chain无效(默认 4)
+//   --levels L           uniform | low | gradient | constant (默认 uniform)
+//   --poodle DIST A B    poodleTime的分布与范围，DIST为 uniform | exp | constant (默认 uniform 1 100)
+//   --transmit DIST A B  transmissionTime的分布与范围(默认 uniform 1 100)
+//   --seed S             随机种子(默认 2521)
+//
+// 例: ./genNetwork --computers 1000000 --topology powerlaw --levels low ../data/network-big.txt
+// (testPoodle在data/目录下查找网络文件，所以写到data/后可以直接在测试输入中引用)
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "netgen.h"
+
+static void usage(const char *prog)
+{
+	fprintf(stderr,
+			"usage: %s [--computers N] [--topology er|powerlaw|grid|chain] [--degree D]\n"
+			"          [--levels uniform|low|gradient|constant]\n"
+			"          [--poodle uniform|exp|constant MIN MAX] [--transmit uniform|exp|constant MIN MAX]\n"
+			"          [--seed S] <output file>\n",
+			prog);
+	exit(EXIT_FAILURE);
+}
+
+int main(int argc, char *argv[])
+{
+	GenParams params = defaultGenParams(1000);
+	const char *output = NULL;
+
+	for (int i = 1; i < argc; i++)
+	{
+		const char *arg = argv[i];
+		bool hasValue = i + 1 < argc;
+		if (strcmp(arg, "--computers") == 0 && hasValue)
+			params.numComputers = atoi(argv[++i]);
+		else if (strcmp(arg, "--topology") == 0 && hasValue)
+		{
+			if (!parseTopology(argv[++i], &params.topology))
+				usage(argv[0]);
+		}
+		else if (strcmp(arg, "--degree") == 0 && hasValue)
+			params.avgDegree = atoi(argv[++i]);
+		else if (strcmp(arg, "--levels") == 0 && hasValue)
+		{
+			if (!parseLevelDistribution(argv[++i], &params.levels))
+				usage(argv[0]);
+		}
+		else if ((strcmp(arg, "--poodle") == 0 || strcmp(arg, "--transmit") == 0) && i + 3 < argc)
+		{
+			bool poodle = strcmp(arg, "--poodle") == 0;
+			TimeDistribution *dist = poodle ? &params.poodleTimes : &params.transmissionTimes;
+			if (!parseTimeDistribution(argv[++i], dist))
+				usage(argv[0]);
+			int lo = atoi(argv[++i]);
+			int hi = atoi(argv[++i]);
+			if (poodle)
+			{
+				params.minPoodleTime = lo;
+				params.maxPoodleTime = hi;
+			}
+			else
+			{
+				params.minTransmissionTime = lo;
+				params.maxTransmissionTime = hi;
+			}
+		}
+		else if (strcmp(arg, "--seed") == 0 && hasValue)
+			params.seed = strtoull(argv[++i], NULL, 10);
+		else if (arg[0] != '-' && !output)
+			output = arg;
+		else
+			usage(argv[0]);
+	}
+	if (!output)
+		usage(argv[0]);
+
+	struct network net = generateNetwork(&params);
+	if (net.numComputers == 0)
+	{
+		fprintf(stderr, "genNetwork: invalid parameters or out of memory\n");
+		return EXIT_FAILURE;
+	}
+	if (!writeNetwork(output, &net))
+	{
+		fprintf(stderr, "genNetwork: cannot write %s\n", output);
+		freeNetwork(&net);
+		return EXIT_FAILURE;
+	}
+
+	printf("%s: %d computers, %d connections (%s)\n", output, net.numComputers,
+		   net.numConnections, topologyName(params.topology));
+	freeNetwork(&net);
+	return 0;
+}
@@ -0,0 +1,276 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "netgen.h"
+
+GenParams defaultGenParams(int numComputers)
+{
+	GenParams params = {
+		.topology = TOPO_ERDOS_RENYI,
+		.numComputers = numComputers,
+		.avgDegree = 4,
+		.levels = LEVELS_UNIFORM,
+		.poodleTimes = TIMES_UNIFORM,
+		.minPoodleTime = 1,
+		.maxPoodleTime = 100,
+		.transmissionTimes = TIMES_UNIFORM,
+		.minTransmissionTime = 1,
+		.maxTransmissionTime = 100,
+		.seed = 2521,
+	};
+	return params;
+}
+
+static int sampleTime(uint64_t *state, TimeDistribution dist, int lo, int hi)
+{
+	switch (dist)
+	{
+	case TIMES_CONSTANT:
+		return lo;
+	case TIMES_EXPONENTIAL:
+	{
+		// 几何分布：每次以7/8的概率继续，步长为区间的1/64
+		int step = (hi - lo) / 64 > 0 ? (hi - lo) / 64 : 1;
+		int t = lo;
+		while (t < hi && randNext(state) % 8 != 0)
+			t += step;
+		return t < hi ? t : hi;
+	}
+	case TIMES_UNIFORM:
+	default:
+		return randRange(state, lo, hi);
+	}
+}
+
+static int sampleLevel(uint64_t *state, LevelDistribution dist, int index, int numComputers)
+{
+	switch (dist)
+	{
+	case LEVELS_CONSTANT:
+		return 1;
+	case LEVELS_LOW:
+	{
+		int level = 1;
+		while (level < MAX_SECURITY_LEVEL && randNext(state) % 2 == 0)
+			level++;
+		return level;
+	}
+	case LEVELS_GRADIENT:
+		return MAX_SECURITY_LEVEL - (int)((int64_t)index * MAX_SECURITY_LEVEL / numComputers);
+	case LEVELS_UNIFORM:
+	default:
+		return randRange(state, 1, MAX_SECURITY_LEVEL);
+	}
+}
+
+// 连接数量，超出int范围时返回-1
+static int64_t countConnections(const GenParams *params, int *rows, int *cols)
+{
+	int64_t n = params->numComputers;
+	switch (params->topology)
+	{
+	case TOPO_GRID:
+	{
+		int c = 1;
+		while ((int64_t)c * c < n)
+			c++;
+		*cols = c;
+		*rows = (int)((n + c - 1) / c);
+		// 最后一行可能不满：横向边为每行的节点数减一，纵向边为有下方邻居的节点数
+		int64_t count = 0;
+		for (int r = 0; r < *rows; r++)
+		{
+			int64_t inRow = r < *rows - 1 ? c : n - (int64_t)r * c;
+			count += inRow - 1;
+		}
+		count += n - c > 0 ? n - c : 0;
+		return count;
+	}
+	case TOPO_CHAIN:
+		return n - 1;
+	case TOPO_POWER_LAW:
+	{
+		int k = params->avgDegree / 2 > 0 ? params->avgDegree / 2 : 1;
+		// 前k + 1个节点构成一个团，之后每个节点连k条边
+		int64_t seed = n < k + 1 ? n : k + 1;
+		return seed * (seed - 1) / 2 + (n - seed) * k;
+	}
+	case TOPO_ERDOS_RENYI:
+	default:
+		return n < 2 ? 0 : n * params->avgDegree / 2;
+	}
+}
+
+struct network generateNetwork(const GenParams *params)
+{
+	struct network net = {0};
+	int n = params->numComputers;
+	if (n <= 0 || params->avgDegree < 0 || params->minPoodleTime < 1 ||
+		params->maxPoodleTime < params->minPoodleTime || params->minTransmissionTime < 1 ||
+		params->maxTransmissionTime < params->minTransmissionTime)
+		return net;
+
+	int rows = 0, cols = 0;
+	int64_t m = countConnections(params, &rows, &cols);
+	if (m < 0 || m > 0x7fffffff - 1)
+		return net;
+
+	uint64_t state = params->seed * 0x9E3779B97F4A7C15ULL + 1;
+	net.computers = malloc(n * sizeof(struct computer));
+	net.connections = malloc((m + 1) * sizeof(struct connection));
+	if (!net.computers || !net.connections)
+	{
+		freeNetwork(&net);
+		return net;
+	}
+
+	for (int i = 0; i < n; i++)
+	{
+		net.computers[i].securityLevel = sampleLevel(&state, params->levels, i, n);
+		net.computers[i].poodleTime = sampleTime(&state, params->poodleTimes,
+												 params->minPoodleTime, params->maxPoodleTime);
+	}
+
+	int64_t k = 0;
+	switch (params->topology)
+	{
+	case TOPO_GRID:
+		for (int i = 0; i < n; i++)
+		{
+			if ((i + 1) % cols != 0 && i + 1 < n)
+				net.connections[k++] = (struct connection){i, i + 1, 0};
+			if (i + cols < n)
+				net.connections[k++] = (struct connection){i, i + cols, 0};
+		}
+		break;
+
+	case TOPO_CHAIN:
+		for (int i = 1; i < n; i++)
+			net.connections[k++] = (struct connection){i - 1, i, 0};
+		break;
+
+	case TOPO_POWER_LAW:
+	{
+		int perNode = params->avgDegree / 2 > 0 ? params->avgDegree / 2 : 1;
+		int cliqueSize = n < perNode + 1 ? n : perNode + 1;
+		// endpoints[]记录所有连接的端点，从中均匀抽样即按度数成比例地选择目标
+		int *endpoints = malloc((2 * m + 1) * sizeof(int));
+		if (!endpoints)
+		{
+			freeNetwork(&net);
+			return net;
+		}
+		int64_t numEndpoints = 0;
+		for (int a = 0; a < cliqueSize; a++)
+		{
+			for (int b = a + 1; b < cliqueSize; b++)
+			{
+				net.connections[k++] = (struct connection){a, b, 0};
+				endpoints[numEndpoints++] = a;
+				endpoints[numEndpoints++] = b;
+			}
+		}
+		for (int v = cliqueSize; v < n; v++)
+		{
+			int64_t available = numEndpoints; // 只从之前的节点中选择，避免自环
+			for (int j = 0; j < perNode; j++)
+			{
+				int target = available > 0 ? endpoints[randNext(&state) % (uint64_t)available]
+										   : randRange(&state, 0, v - 1);
+				net.connections[k++] = (struct connection){v, target, 0};
+				endpoints[numEndpoints++] = v;
+				endpoints[numEndpoints++] = target;
+			}
+		}
+		free(endpoints);
+		break;
+	}
+
+	case TOPO_ERDOS_RENYI:
+	default:
+		while (k < m)
+		{
+			int a = randRange(&state, 0, n - 1);
+			int b = randRange(&state, 0, n - 1);
+			if (a != b)
+				net.connections[k++] = (struct connection){a, b, 0};
+		}
+		break;
+	}
+
+	for (int64_t i = 0; i < k; i++)
+	{
+		net.connections[i].transmissionTime = sampleTime(&state, params->transmissionTimes,
+														 params->minTransmissionTime,
+														 params->maxTransmissionTime);
+	}
+
+	net.numComputers = n;
+	net.numConnections = (int)k;
+	return net;
+}
+
+static const char *topologyNames[] = {"er", "powerlaw", "grid", "chain"};
+static const char *levelNames[] = {"uniform", "low", "gradient", "constant"};
+static const char *timeNames[] = {"uniform", "exp", "constant"};
+
+static int lookup(const char *names[], int count, const char *name)
+{
+	for (int i = 0; i < count; i++)
+	{
+		if (strcmp(names[i], name) == 0)
+			return i;
+	}
+	return -1;
+}
+
+bool parseTopology(const char *name, Topology *out)
+{
+	int i = lookup(topologyNames, 4, name);
+	if (i < 0)
+		return false;
+	*out = (Topology)i;
+	return true;
+}
+
+bool parseLevelDistribution(const char *name, LevelDistribution *out)
+{
+	int i = lookup(levelNames, 4, name);
+	if (i < 0)
+		return false;
+	*out = (LevelDistribution)i;
+	return true;
+}
+
+bool parseTimeDistribution(const char *name, TimeDistribution *out)
+{
+	int i = lookup(timeNames, 3, name);
+	if (i < 0)
+		return false;
+	*out = (TimeDistribution)i;
+	return true;
+}
+
+const char *topologyName(Topology topology)
+{
+	return topologyNames[topology];
+}
+
+bool writeNetwork(const char *filename, const struct network *net)
+{
+	FILE *fp = fopen(filename, "w");
+	if (!fp)
+		return false;
+
+	fprintf(fp, "%d %d\n", net->numComputers, net->numConnections);
+	for (int i = 0; i < net->numComputers; i++)
+		fprintf(fp, "%d %d\n", net->computers[i].securityLevel, net->computers[i].poodleTime);
+	for (int i = 0; i < net->numConnections; i++)
+	{
+		struct connection *c = &net->connections[i];
+		fprintf(fp, "%d %d %d\n", c->computerA, c->computerB, c->transmissionTime);
+	}
+
+	return fclose(fp) == 0;
+}
@@ -0,0 +1,71 @@
+// 大规模合成网络生成器，供genNetwork与benchSuite使用
+
+#ifndef NETGEN_H
+#define NETGEN_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "benchUtil.h"
+
+// 拓扑
+typedef enum Topology
+{
+	TOPO_ERDOS_RENYI, // G(n, m)：m = n·avgDegree/2 条均匀随机的连接，可能不连通
+	TOPO_POWER_LAW,   // Barabási–Albert优先连接：每个新节点连avgDegree/2条边，度数服从幂律
+	TOPO_GRID,        // 近似正方形的二维网格，每个节点连接上下左右
+	TOPO_CHAIN,       // 一条长链 0 - 1 - ... - (n-1)
+} Topology;
+
+// 安全等级分布
+typedef enum LevelDistribution
+{
+	LEVELS_UNIFORM,  // 1..MAX_SECURITY_LEVEL均匀分布
+	LEVELS_LOW,      // 偏向低等级：每升一级概率减半，大部分计算机可以互相入侵
+	LEVELS_GRADIENT, // 随编号从MAX_SECURITY_LEVEL递减到1，只能从小编号往大编号入侵，形成很深的凝聚图
+	LEVELS_CONSTANT, // 全部为1
+} LevelDistribution;
+
+// poodleTime与transmissionTime的分布
+typedef enum TimeDistribution
+{
+	TIMES_UNIFORM,     // [minTime, maxTime]均匀分布
+	TIMES_EXPONENTIAL, // 近似指数分布(均值约为区间的1/8)，截断到[minTime, maxTime]
+	TIMES_CONSTANT,    // 全部为minTime
+} TimeDistribution;
+
+typedef struct GenParams
+{
+	Topology topology;
+	int numComputers;
+	int avgDegree; // 对网格与链无效
+
+	LevelDistribution levels;
+
+	TimeDistribution poodleTimes;
+	int minPoodleTime;
+	int maxPoodleTime;
+
+	TimeDistribution transmissionTimes;
+	int minTransmissionTime;
+	int maxTransmissionTime;
+
+	uint64_t seed;
+} GenParams;
+
+// 默认参数：numComputers台计算机的ER网络，平均度数4，等级与时间均匀分布
+GenParams defaultGenParams(int numComputers);
+
+// 按参数生成网络；参数非法或内存不足时返回numComputers为0的网络
+struct network generateNetwork(const GenParams *params);
+
+// 名称与枚举之间的转换，未知名称返回false
+bool parseTopology(const char *name, Topology *out);
+bool parseLevelDistribution(const char *name, LevelDistribution *out);
+bool parseTimeDistribution(const char *name, TimeDistribution *out);
+const char *topologyName(Topology topology);
+
+// 以data/目录下的文本格式写出网络，成功返回true
+bool writeNetwork(const char *filename, const struct network *net);
+
+#endif
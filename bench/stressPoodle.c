@@ -0,0 +1,126 @@
+// 压力测试：在大规模网络上调用poodle.h的全部接口，检查结果的基本性质
+//
+// 用法: ./stressPoodle [numComputers]   (默认 10^6)
+// 建议用 make asan 构建后运行，确认所有缓冲区都按网络的实际规模分配、没有越界或泄漏。
+
+#include <limits.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/resource.h>
+
+#include "../poodle.h"
+#include "benchUtil.h"
+
+static long peakRssKb(void)
+{
+	struct rusage usage;
+	getrusage(RUSAGE_SELF, &usage);
+	return usage.ru_maxrss;
+}
+
+static void freeResult(struct poodleResult res)
+{
+	for (int i = 0; i < res.numSteps; i++)
+	{
+		struct computerList *curr = res.steps[i].recipients;
+		while (curr != NULL)
+		{
+			struct computerList *temp = curr;
+			curr = curr->next;
+			free(temp);
+		}
+	}
+	free(res.steps);
+}
+
+// 检查一次poodle的结果：步骤按时间不减，每台计算机恰好出现一次，
+// 除起点外每台计算机恰好是一个前面步骤的接收者，接收者列表升序
+static bool checkPoodle(struct poodleResult res, int numComputers, int start)
+{
+	bool ok = res.numSteps > 0 && res.steps[0].computer == start;
+	int *step = malloc(numComputers * sizeof(int));
+	int *received = calloc(numComputers, sizeof(int));
+	for (int i = 0; i < numComputers; i++)
+		step[i] = -1;
+
+	for (int i = 0; ok && i < res.numSteps; i++)
+	{
+		int c = res.steps[i].computer;
+		if (step[c] != -1 || (i > 0 && res.steps[i - 1].time > res.steps[i].time))
+			ok = false;
+		step[c] = i;
+	}
+
+	for (int i = 0; ok && i < res.numSteps; i++)
+	{
+		int prev = -1;
+		for (struct computerList *curr = res.steps[i].recipients; curr; curr = curr->next)
+		{
+			int c = curr->computer;
+			if (c <= prev || step[c] <= i)
+				ok = false;
+			received[c]++;
+			prev = c;
+		}
+	}
+
+	for (int i = 0; ok && i < res.numSteps; i++)
+	{
+		int c = res.steps[i].computer;
+		if (received[c] != (c == start ? 0 : 1))
+			ok = false;
+	}
+
+	free(step);
+	free(received);
+	return ok;
+}
+
+int main(int argc, char *argv[])
+{
+	int numComputers = argc > 1 ? atoi(argv[1]) : 1000000;
+	struct network net = randomNetwork(numComputers, 4, 2521);
+	int start = numComputers / 2;
+	int failures = 0;
+
+	printf("computers=%d connections=%d\n", numComputers, net.numConnections);
+
+	int64_t t0 = nowNs();
+	struct poodleResult res = poodle(net.computers, numComputers, net.connections, net.numConnections, start);
+	printf("poodle          : %10.3f ms, %d steps\n", (nowNs() - t0) / 1e6, res.numSteps);
+	if (!checkPoodle(res, numComputers, start))
+	{
+		fprintf(stderr, "stressPoodle: poodle result is inconsistent\n");
+		failures++;
+	}
+	freeResult(res);
+
+	t0 = nowNs();
+	res = advancedPoodle(net.computers, numComputers, net.connections, net.numConnections, start);
+	printf("advancedPoodle  : %10.3f ms, %d steps\n", (nowNs() - t0) / 1e6, res.numSteps);
+	for (int i = 1; i < res.numSteps; i++)
+	{
+		if (res.steps[i - 1].time > res.steps[i].time)
+		{
+			fprintf(stderr, "stressPoodle: advancedPoodle steps out of order\n");
+			failures++;
+			break;
+		}
+	}
+	freeResult(res);
+
+	t0 = nowNs();
+	struct chooseSourceResult src = chooseSource(net.computers, numComputers, net.connections, net.numConnections);
+	printf("chooseSource    : %10.3f ms, source=%d reach=%d\n", (nowNs() - t0) / 1e6,
+		   src.sourceComputer, src.numComputers);
+	free(src.computers);
+
+	printf("peak RSS        : %10.1f MB\n", peakRssKb() / 1024.0);
+
+	freeNetwork(&net);
+	if (failures > 0)
+		return EXIT_FAILURE;
+	printf("all checks passed\n");
+	return 0;
+}